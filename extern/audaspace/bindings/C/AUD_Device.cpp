@@ -248,6 +248,23 @@ AUD_API void AUD_Device_setVolume(AUD_Device* device, float value)
 	dev->setVolume(value);
 }
 
+AUD_API int AUD_Device_getVoiceLimit(AUD_Device* device)
+{
+	auto dev = std::dynamic_pointer_cast<SoftwareDevice>(device ? *device : DeviceManager::getDevice());
+	if(dev)
+		return dev->getVoiceLimit();
+	return 0;
+}
+
+AUD_API int AUD_Device_setVoiceLimit(AUD_Device* device, int voices, float volume)
+{
+	auto dev = std::dynamic_pointer_cast<SoftwareDevice>(device ? *device : DeviceManager::getDevice());
+	if(!dev)
+		return false;
+	dev->setVoiceLimit(voices, volume);
+	return true;
+}
+
 AUD_API int AUD_Device_read(AUD_Device* device, unsigned char* buffer, int length)
 {
 	assert(device);
@@ -192,6 +192,24 @@ extern AUD_API float AUD_Device_getVolume(AUD_Device* device);
  */
 extern AUD_API void AUD_Device_setVolume(AUD_Device* device, float value);
 
+/**
+ * Retrieves the maximum number of audible handles of a software mixing device.
+ * param device The device to get the voice limit from.
+ * return The maximum number of audible handles, 0 for no limit.
+ */
+extern AUD_API int AUD_Device_getVoiceLimit(AUD_Device* device);
+
+/**
+ * Sets the voice virtualization parameters of a software mixing device.
+ * Handles over the voice limit or quieter than the virtual volume are not
+ * read nor mixed, but their position keeps advancing.
+ * param device The device to set the voice limit from.
+ * param voices The maximum number of audible handles, 0 for no limit.
+ * param volume The volume under which handles are virtual.
+ * return Whether the device supports voice virtualization.
+ */
+extern AUD_API int AUD_Device_setVoiceLimit(AUD_Device* device, int voices, float volume);
+
 /**
  * Reads the next samples into the supplied buffer.
  * \param device The readable device.
@@ -15,6 +15,7 @@
  ******************************************************************************/
 
 #include "devices/I3DHandle.h"
+#include "devices/SoftwareDevice.h"
 #include "Exception.h"
 
 #include <cassert>
@@ -291,6 +292,18 @@ AUD_API int AUD_Handle_setRelative(AUD_Handle* handle, int value)
 	return false;
 }
 
+AUD_API int AUD_Handle_setPriority(AUD_Handle* handle, int value)
+{
+	assert(handle);
+	return SoftwareDevice::setPriority(handle->get(), value);
+}
+
+AUD_API int AUD_Handle_isVirtual(AUD_Handle* handle)
+{
+	assert(handle);
+	return SoftwareDevice::isVirtual(handle->get());
+}
+
 AUD_API AUD_Status AUD_Handle_getStatus(AUD_Handle* handle)
 {
 	assert(handle);
@@ -234,6 +234,21 @@ extern AUD_API int AUD_Handle_isRelative(AUD_Handle* handle);
  */
 extern AUD_API int AUD_Handle_setRelative(AUD_Handle* handle, int value);
 
+/**
+ * Sets the virtualization priority of a handle played on a software mixing device.
+ * Handles with a higher priority stay audible first when the device reaches its voice limit.
+ * param handle The handle to set the priority from.
+ * param value The new priority to set.
+ */
+extern AUD_API int AUD_Handle_setPriority(AUD_Handle* handle, int value);
+
+/**
+ * Retrieves whether a handle is virtual, virtual handles are not mixed.
+ * param handle The handle to check.
+ * return Whether the handle is virtual.
+ */
+extern AUD_API int AUD_Handle_isVirtual(AUD_Handle* handle);
+
 /**
  * Retrieves the status of a handle.
  * param handle The handle to get the status from.
@@ -29,8 +29,11 @@
 #include "devices/DefaultSynchronizer.h"
 #include "util/Buffer.h"
 
+#include <atomic>
 #include <list>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 AUD_NAMESPACE_BEGIN
 
@@ -52,7 +55,7 @@ class AUD_API SoftwareDevice : public IDevice, public I3DDevice
 {
 protected:
 	/// Saves the data for playback.
-	class AUD_API SoftwareHandle : public IHandle, public I3DHandle
+	class AUD_API SoftwareHandle : public IHandle, public I3DHandle, public std::enable_shared_from_this<SoftwareHandle>
 	{
 	private:
 		// delete copy constructor and operator=
@@ -144,6 +147,24 @@ protected:
 		/// Own device.
 		SoftwareDevice* m_device;
 
+		/// Location set by the user, applied to m_location by the mixing thread.
+		Vector3 m_user_location;
+
+		/// Velocity set by the user, applied to m_velocity by the mixing thread.
+		Vector3 m_user_velocity;
+
+		/// Orientation set by the user, applied to m_orientation by the mixing thread.
+		Quaternion m_user_orientation;
+
+		/// Priority for voice virtualization, handles with a higher priority are mixed first.
+		int m_priority;
+
+		/// Whether the handle is inaudible and neither read nor mixed.
+		bool m_virtual;
+
+		/// Position of the pitched source in its own samples while the handle is virtual.
+		double m_virtual_position;
+
 		/**
 		 * This method is for internal use only.
 		 * @param keep Whether the sound should be marked stopped or paused.
@@ -174,6 +195,19 @@ protected:
 		 */
 		void setSpecs(Specs specs);
 
+		/**
+		 * Makes the handle virtual or audible again.
+		 * \param is_virtual Whether the handle is virtual.
+		 */
+		void setVirtual(bool is_virtual);
+
+		/**
+		 * Advances the position of a virtual handle.
+		 * \param length The number of samples of the device to advance.
+		 * \return Whether the end of the sound is reached.
+		 */
+		bool advanceVirtual(int length);
+
 		virtual ~SoftwareHandle() {}
 		virtual bool pause();
 		virtual bool resume();
@@ -268,6 +302,90 @@ protected:
 	SoftwareDevice();
 
 private:
+	/// Parameter of a handle updated through the command queue.
+	enum HandleCommandType
+	{
+		HANDLE_COMMAND_LOCATION,
+		HANDLE_COMMAND_VELOCITY,
+		HANDLE_COMMAND_ORIENTATION
+	};
+
+	/// A handle parameter update pushed by any thread and applied by the mixing thread.
+	struct HandleCommand
+	{
+		/// Sequence number of the slot in the queue.
+		std::atomic<size_t> sequence;
+
+		/// The updated handle, kept alive until the command is applied.
+		std::shared_ptr<SoftwareHandle> handle;
+
+		/// The updated parameter.
+		HandleCommandType type;
+
+		/// The new value of the parameter.
+		float value[4];
+	};
+
+	/// Number of commands in the queue, must be a power of two.
+	static const size_t HANDLE_COMMAND_QUEUE_SIZE = 4096;
+
+	/**
+	 * The lock-free queue of handle parameter updates, the threads setting
+	 * parameters don't wait for the mixing thread which drains the queue
+	 * at the start of each buffer.
+	 */
+	std::unique_ptr<HandleCommand[]> m_commands;
+
+	/// The next position to write a command.
+	std::atomic<size_t> m_command_write;
+
+	/// The next position to read a command, only used with the device locked.
+	size_t m_command_read;
+
+	/**
+	 * Pushes a handle parameter update to the command queue.
+	 * If the queue is full it is drained in order with the device locked and the push retried.
+	 * \param handle The handle to update.
+	 * \param type The updated parameter.
+	 * \param value The new value.
+	 * \param count The number of floats of the value.
+	 */
+	void pushCommand(SoftwareHandle* handle, HandleCommandType type, const float* value, int count);
+
+	/**
+	 * Applies a handle parameter update.
+	 * \param handle The handle to update.
+	 * \param type The updated parameter.
+	 * \param value The new value.
+	 */
+	static void applyCommand(SoftwareHandle* handle, HandleCommandType type, const float* value);
+
+	/**
+	 * Applies all the queued handle parameter updates, the device must be locked.
+	 */
+	void applyCommands();
+
+	/**
+	 * Maximum number of handles read and mixed, the others are virtual. 0 for no limit.
+	 */
+	int m_voice_limit;
+
+	/**
+	 * Volume under which a handle is virtual.
+	 */
+	float m_virtual_volume;
+
+	/**
+	 * Audible handles sorted by priority, reused for each buffer.
+	 */
+	std::vector<SoftwareHandle*> m_voices;
+
+	/**
+	 * Flags the handles which are virtual for the next buffer.
+	 * The handles must be updated.
+	 */
+	void virtualizeVoices();
+
 	/**
 	 * The reading buffer.
 	 */
@@ -341,6 +459,42 @@ public:
 	 */
 	void setQuality(bool quality);
 
+	/**
+	 * Sets the priority of a specific handle for voice virtualization.
+	 * \param handle The handle to set the priority from.
+	 * \param priority The new priority, handles with higher priorities stay audible first.
+	 * \return Whether the handle is a handle of a software device.
+	 */
+	static bool setPriority(IHandle* handle, int priority);
+
+	/**
+	 * Returns whether a specific handle is virtual.
+	 * Virtual handles are inaudible: they are not read, resampled or mixed, but their
+	 * position keeps advancing.
+	 * \param handle The handle to check.
+	 * \return Whether the handle is virtual.
+	 */
+	static bool isVirtual(IHandle* handle);
+
+	/**
+	 * Sets the voice virtualization parameters.
+	 * \param voices The maximum number of audible handles, 0 for no limit.
+	 * \param volume The volume under which handles are virtual.
+	 */
+	void setVoiceLimit(int voices, float volume);
+
+	/**
+	 * Retrieves the maximum number of audible handles.
+	 * \return The maximum number of audible handles, 0 for no limit.
+	 */
+	int getVoiceLimit() const;
+
+	/**
+	 * Retrieves the volume under which handles are virtual.
+	 * \return The virtual volume threshold.
+	 */
+	float getVirtualVolume() const;
+
 	virtual DeviceSpecs getSpecs() const;
 	virtual std::shared_ptr<IHandle> play(std::shared_ptr<IReader> reader, bool keep = false);
 	virtual std::shared_ptr<IHandle> play(std::shared_ptr<ISound> sound, bool keep = false);
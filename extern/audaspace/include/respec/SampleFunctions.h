@@ -0,0 +1,121 @@
+/*******************************************************************************
+ * Copyright 2009-2016 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+/**
+ * @file SampleFunctions.h
+ * @ingroup respec
+ * Defines the sample processing kernels of the software mixing path, which
+ * are vectorized for the instruction sets supported by the CPU.
+ */
+
+#include "respec/ConverterFunctions.h"
+
+AUD_NAMESPACE_BEGIN
+
+/**
+ * The instruction sets the sample functions are implemented with.
+ */
+enum SampleFunctionsISA
+{
+	SAMPLE_FUNCTIONS_SCALAR = 0,	/// Portable scalar code.
+	SAMPLE_FUNCTIONS_SSE2,			/// x86 SSE2.
+	SAMPLE_FUNCTIONS_AVX,			/// x86 AVX, conversions use SSE2.
+	SAMPLE_FUNCTIONS_NEON			/// ARM 64 bit NEON.
+};
+
+/**
+ * The function template for mixing a buffer into another one.
+ * The volume ramps linearly from volume_from at the first sample to
+ * volume_to at the end of the buffer.
+ * @param target The target buffer to add the samples to.
+ * @param source The source buffer.
+ * @param length The amount of samples per channel.
+ * @param channels The channel count of both buffers.
+ * @param volume_to The volume at the end of the buffer.
+ * @param volume_from The volume at the start of the buffer.
+ */
+typedef void (*mix_f)(sample_t* target, const sample_t* source, int length, int channels, float volume_to, float volume_from);
+
+/**
+ * The function template for linear resampling.
+ * The sample i of the target is interpolated at the source position
+ * (i + 1) / factor + position.
+ * @param target The target buffer.
+ * @param source The source buffer, which has to contain all the samples
+ *        up to the last interpolated position.
+ * @param length The amount of samples per channel to write.
+ * @param channels The channel count of both buffers.
+ * @param position The source position before the first target sample.
+ * @param factor The resampling factor, target rate / source rate.
+ */
+typedef void (*resample_linear_f)(sample_t* target, const sample_t* source, int length, int channels, float position, float factor);
+
+/**
+ * The function template for mapping the channels of a buffer.
+ * @param target The target buffer.
+ * @param source The source buffer.
+ * @param length The amount of samples per channel.
+ * @param source_channels The channel count of the source.
+ * @param target_channels The channel count of the target.
+ * @param mapping The mapping matrix, target_channels rows of source_channels factors.
+ */
+typedef void (*map_channels_f)(sample_t* target, const sample_t* source, int length, int source_channels, int target_channels, const float* mapping);
+
+/**
+ * A set of sample processing kernels for an instruction set.
+ */
+struct SampleFunctions
+{
+	/// The instruction set of the kernels.
+	SampleFunctionsISA isa;
+
+	/// The name of the instruction set.
+	const char* name;
+
+	/// Mixes a buffer with a volume ramp.
+	mix_f mix;
+
+	/// Linearly resamples a buffer.
+	resample_linear_f resample_linear;
+
+	/// Maps the channels of a buffer.
+	map_channels_f map_channels;
+
+	/// Converts from FORMAT_FLOAT32 to FORMAT_S16.
+	convert_f convert_float_s16;
+
+	/// Converts from FORMAT_S16 to FORMAT_FLOAT32, the conversion can be done in place.
+	convert_f convert_s16_float;
+};
+
+/**
+ * Returns the fastest sample functions supported by the CPU.
+ * The instruction set is detected at the first call.
+ * @return The sample functions.
+ */
+AUD_API const SampleFunctions& get_sample_functions();
+
+/**
+ * Returns the sample functions of a specific instruction set.
+ * @param isa The instruction set.
+ * @return The sample functions or nullptr if the instruction set is not
+ *         compiled in or not supported by the CPU.
+ */
+AUD_API const SampleFunctions* get_sample_functions(SampleFunctionsISA isa);
+
+AUD_NAMESPACE_END
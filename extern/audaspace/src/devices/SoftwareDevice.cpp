@@ -29,6 +29,7 @@
 #include <iostream>
 #include <limits>
 #include <mutex>
+#include <thread>
 
 AUD_NAMESPACE_BEGIN
 
@@ -42,6 +43,8 @@ enum RenderFlags
 
 #define PITCH_MAX 10
 
+#define VIRTUAL_VOLUME 0.0001f
+
 /******************************************************************************/
 /********************** SoftwareHandle Handle Code ************************/
 /******************************************************************************/
@@ -81,7 +84,8 @@ SoftwareDevice::SoftwareHandle::SoftwareHandle(SoftwareDevice* device, std::shar
 	m_reader(reader), m_pitch(pitch), m_resampler(resampler), m_mapper(mapper), m_keep(keep), m_user_pitch(1.0f), m_user_volume(1.0f), m_user_pan(0.0f), m_volume(0.0f), m_old_volume(0.0f), m_loopcount(0),
 	m_relative(true), m_volume_max(1.0f), m_volume_min(0), m_distance_max(std::numeric_limits<float>::max()),
 	m_distance_reference(1.0f), m_attenuation(1.0f), m_cone_angle_outer(M_PI), m_cone_angle_inner(M_PI), m_cone_volume_outer(0),
-	m_flags(RENDER_CONE), m_stop(nullptr), m_stop_data(nullptr), m_status(STATUS_PLAYING), m_device(device)
+	m_flags(RENDER_CONE), m_stop(nullptr), m_stop_data(nullptr), m_status(STATUS_PLAYING), m_device(device),
+	m_priority(0), m_virtual(false), m_virtual_position(0)
 {
 }
 
@@ -245,6 +249,44 @@ void SoftwareDevice::SoftwareHandle::setSpecs(Specs specs)
 	m_resampler->setRate(specs.rate);
 }
 
+void SoftwareDevice::SoftwareHandle::setVirtual(bool is_virtual)
+{
+	if(m_virtual == is_virtual)
+		return;
+
+	if(is_virtual)
+		m_virtual_position = m_pitch->getPosition();
+	else
+		m_reader->seek((int)(m_virtual_position * m_device->m_specs.rate / m_pitch->getSpecs().rate));
+
+	m_virtual = is_virtual;
+}
+
+bool SoftwareDevice::SoftwareHandle::advanceVirtual(int length)
+{
+	int sound_length = m_pitch->getLength();
+
+	// the source advances faster or slower than the device with the pitch and doppler effect
+	m_virtual_position += length * m_pitch->getSpecs().rate / m_device->m_specs.rate;
+
+	// in case of looping
+	while(m_virtual_position >= sound_length && m_loopcount && sound_length > 0)
+	{
+		m_virtual_position -= sound_length;
+
+		if(m_loopcount > 0)
+			m_loopcount--;
+	}
+
+	if(m_virtual_position >= sound_length)
+	{
+		m_virtual_position = sound_length;
+		return true;
+	}
+
+	return false;
+}
+
 bool SoftwareDevice::SoftwareHandle::pause()
 {
 	return pause(false);
@@ -358,7 +400,11 @@ bool SoftwareDevice::SoftwareHandle::seek(float position)
 		return false;
 
 	m_pitch->setPitch(m_user_pitch);
-	m_reader->seek((int)(position * m_reader->getSpecs().rate));
+
+	if(m_virtual)
+		m_virtual_position = position * m_pitch->getSpecs().rate;
+	else
+		m_reader->seek((int)(position * m_reader->getSpecs().rate));
 
 	if(m_status == STATUS_STOPPED)
 		m_status = STATUS_PAUSED;
@@ -376,7 +422,7 @@ float SoftwareDevice::SoftwareHandle::getPosition()
 	if(!m_status)
 		return 0.0f;
 
-	float position = m_reader->getPosition() / (float)m_device->m_specs.rate;
+	float position = m_virtual ? m_virtual_position / m_pitch->getSpecs().rate : m_reader->getPosition() / (float)m_device->m_specs.rate;
 
 	return position;
 }
@@ -469,7 +515,7 @@ Vector3 SoftwareDevice::SoftwareHandle::getLocation()
 	if(!m_status)
 		return Vector3();
 
-	return m_location;
+	return m_user_location;
 }
 
 bool SoftwareDevice::SoftwareHandle::setLocation(const Vector3& location)
@@ -477,7 +523,8 @@ bool SoftwareDevice::SoftwareHandle::setLocation(const Vector3& location)
 	if(!m_status)
 		return false;
 
-	m_location = location;
+	m_user_location = location;
+	m_device->pushCommand(this, HANDLE_COMMAND_LOCATION, location.get(), 3);
 
 	return true;
 }
@@ -487,7 +534,7 @@ Vector3 SoftwareDevice::SoftwareHandle::getVelocity()
 	if(!m_status)
 		return Vector3();
 
-	return m_velocity;
+	return m_user_velocity;
 }
 
 bool SoftwareDevice::SoftwareHandle::setVelocity(const Vector3& velocity)
@@ -495,7 +542,8 @@ bool SoftwareDevice::SoftwareHandle::setVelocity(const Vector3& velocity)
 	if(!m_status)
 		return false;
 
-	m_velocity = velocity;
+	m_user_velocity = velocity;
+	m_device->pushCommand(this, HANDLE_COMMAND_VELOCITY, velocity.get(), 3);
 
 	return true;
 }
@@ -505,7 +553,7 @@ Quaternion SoftwareDevice::SoftwareHandle::getOrientation()
 	if(!m_status)
 		return Quaternion();
 
-	return m_orientation;
+	return m_user_orientation;
 }
 
 bool SoftwareDevice::SoftwareHandle::setOrientation(const Quaternion& orientation)
@@ -513,7 +561,8 @@ bool SoftwareDevice::SoftwareHandle::setOrientation(const Quaternion& orientatio
 	if(!m_status)
 		return false;
 
-	m_orientation = orientation;
+	m_user_orientation = orientation;
+	m_device->pushCommand(this, HANDLE_COMMAND_ORIENTATION, orientation.get(), 4);
 
 	return true;
 }
@@ -704,6 +753,14 @@ void SoftwareDevice::create()
 	m_distance_model = DISTANCE_MODEL_INVERSE_CLAMPED;
 	m_flags = 0;
 	m_quality = false;
+	m_voice_limit = 0;
+	m_virtual_volume = VIRTUAL_VOLUME;
+
+	m_commands = std::unique_ptr<HandleCommand[]>(new HandleCommand[HANDLE_COMMAND_QUEUE_SIZE]);
+	for(size_t i = 0; i < HANDLE_COMMAND_QUEUE_SIZE; i++)
+		m_commands[i].sequence.store(i, std::memory_order_relaxed);
+	m_command_write.store(0, std::memory_order_relaxed);
+	m_command_read = 0;
 }
 
 void SoftwareDevice::destroy()
@@ -716,6 +773,106 @@ void SoftwareDevice::destroy()
 
 	while(!m_pausedSounds.empty())
 		m_pausedSounds.front()->stop();
+
+	// release the handles of pending commands
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+	applyCommands();
+}
+
+void SoftwareDevice::pushCommand(SoftwareHandle* handle, HandleCommandType type, const float* value, int count)
+{
+	size_t position = m_command_write.load(std::memory_order_relaxed);
+	HandleCommand* command;
+
+	for(;;)
+	{
+		command = &m_commands[position & (HANDLE_COMMAND_QUEUE_SIZE - 1)];
+		size_t sequence = command->sequence.load(std::memory_order_acquire);
+		intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+
+		if(difference == 0)
+		{
+			if(m_command_write.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if(difference < 0)
+		{
+			// the queue is full, drain it in order and retry so this command stays behind the older ones
+			{
+				std::lock_guard<std::recursive_mutex> lock(m_mutex);
+				applyCommands();
+			}
+
+			std::this_thread::yield();
+			position = m_command_write.load(std::memory_order_relaxed);
+		}
+		else
+			position = m_command_write.load(std::memory_order_relaxed);
+	}
+
+	command->handle = handle->shared_from_this();
+	command->type = type;
+	std::memcpy(command->value, value, count * sizeof(float));
+	command->sequence.store(position + 1, std::memory_order_release);
+}
+
+void SoftwareDevice::applyCommand(SoftwareHandle* handle, HandleCommandType type, const float* value)
+{
+	switch(type)
+	{
+	case HANDLE_COMMAND_LOCATION:
+		handle->m_location = Vector3(value[0], value[1], value[2]);
+		break;
+	case HANDLE_COMMAND_VELOCITY:
+		handle->m_velocity = Vector3(value[0], value[1], value[2]);
+		break;
+	case HANDLE_COMMAND_ORIENTATION:
+		handle->m_orientation = Quaternion(value[0], value[1], value[2], value[3]);
+		break;
+	}
+}
+
+void SoftwareDevice::applyCommands()
+{
+	for(;;)
+	{
+		HandleCommand& command = m_commands[m_command_read & (HANDLE_COMMAND_QUEUE_SIZE - 1)];
+
+		if(command.sequence.load(std::memory_order_acquire) != m_command_read + 1)
+			break;
+
+		applyCommand(command.handle.get(), command.type, command.value);
+		command.handle.reset();
+		command.sequence.store(m_command_read + HANDLE_COMMAND_QUEUE_SIZE, std::memory_order_release);
+		m_command_read++;
+	}
+}
+
+void SoftwareDevice::virtualizeVoices()
+{
+	if(m_voice_limit <= 0 || m_playingSounds.size() <= (size_t)m_voice_limit)
+		return;
+
+	m_voices.clear();
+	for(auto& sound : m_playingSounds)
+	{
+		if(sound->m_volume > m_virtual_volume)
+			m_voices.push_back(sound.get());
+	}
+
+	if(m_voices.size() <= (size_t)m_voice_limit)
+		return;
+
+	std::partial_sort(m_voices.begin(), m_voices.begin() + m_voice_limit, m_voices.end(), [](SoftwareHandle* a, SoftwareHandle* b)
+	{
+		if(a->m_priority != b->m_priority)
+			return a->m_priority > b->m_priority;
+		return a->m_volume > b->m_volume;
+	});
+
+	// silence the voices over the limit, they fade out and become virtual in the next buffer
+	for(auto it = m_voices.begin() + m_voice_limit; it != m_voices.end(); it++)
+		(*it)->m_volume = 0.0f;
 }
 
 void SoftwareDevice::mix(data_t* buffer, int length)
@@ -735,6 +892,14 @@ void SoftwareDevice::mix(data_t* buffer, int length)
 
 		m_mixer->clear(length);
 
+		applyCommands();
+
+		// update 3D Info
+		for(auto& sound : m_playingSounds)
+			sound->update();
+
+		virtualizeVoices();
+
 		// for all sounds
 		for(auto& sound : m_playingSounds)
 		{
@@ -742,15 +907,21 @@ void SoftwareDevice::mix(data_t* buffer, int length)
 			pos = 0;
 			len = length;
 
-			// update 3D Info
-			sound->update();
-
 			try
 			{
-				sound->m_reader->read(len, eos, buf);
+				// inaudible sounds of known length are not read, only their position advances
+				sound->setVirtual(std::max(sound->m_volume, sound->m_old_volume) <= m_virtual_volume && sound->m_reader->getLength() >= 0);
+
+				if(sound->m_virtual)
+				{
+					len = 0;
+					eos = sound->advanceVirtual(length);
+				}
+				else
+					sound->m_reader->read(len, eos, buf);
 
 				// in case of looping
-				while(pos + len < length && sound->m_loopcount && eos)
+				while(!sound->m_virtual && pos + len < length && sound->m_loopcount && eos)
 				{
 					m_mixer->mix(buf, pos, len, sound->m_volume, sound->m_old_volume);
 
@@ -816,6 +987,39 @@ void SoftwareDevice::setQuality(bool quality)
 	m_quality = quality;
 }
 
+bool SoftwareDevice::setPriority(IHandle* handle, int priority)
+{
+	SoftwareDevice::SoftwareHandle* h = dynamic_cast<SoftwareDevice::SoftwareHandle*>(handle);
+	if(!h)
+		return false;
+	h->m_priority = priority;
+	return true;
+}
+
+bool SoftwareDevice::isVirtual(IHandle* handle)
+{
+	SoftwareDevice::SoftwareHandle* h = dynamic_cast<SoftwareDevice::SoftwareHandle*>(handle);
+	return h && h->m_virtual;
+}
+
+void SoftwareDevice::setVoiceLimit(int voices, float volume)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+	m_voice_limit = std::max(voices, 0);
+	m_virtual_volume = std::max(volume, 0.0f);
+}
+
+int SoftwareDevice::getVoiceLimit() const
+{
+	return m_voice_limit;
+}
+
+float SoftwareDevice::getVirtualVolume() const
+{
+	return m_virtual_volume;
+}
+
 void SoftwareDevice::setSpecs(Specs specs)
 {
 	m_specs.specs = specs;
@@ -15,6 +15,7 @@
  ******************************************************************************/
 
 #include "respec/ChannelMapperReader.h"
+#include "respec/SampleFunctions.h"
 
 #include <cmath>
 #include <limits>
@@ -206,18 +207,7 @@ void ChannelMapperReader::read(int& length, bool& eos, sample_t* buffer)
 
 	m_reader->read(length, eos, in);
 
-	sample_t sum;
-
-	for(int i = 0; i < length; i++)
-	{
-		for(int j = 0; j < m_target_channels; j++)
-		{
-			sum = 0;
-			for(int k = 0; k < m_source_channels; k++)
-				sum += m_mapping[j * m_source_channels + k] * in[i * m_source_channels + k];
-			buffer[i * m_target_channels + j] = sum;
-		}
-	}
+	get_sample_functions().map_channels(buffer, in, length, m_source_channels, m_target_channels, m_mapping);
 }
 
 const Channel ChannelMapperReader::MONO_MAP[] =
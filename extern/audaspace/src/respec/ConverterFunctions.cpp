@@ -15,6 +15,7 @@
  ******************************************************************************/
 
 #include "respec/ConverterFunctions.h"
+#include "respec/SampleFunctions.h"
 
 #include <stdint.h>
 
@@ -121,10 +122,7 @@ void convert_s16_s32(data_t* target, data_t* source, int length)
 
 void convert_s16_float(data_t* target, data_t* source, int length)
 {
-	int16_t* s = (int16_t*) source;
-	float* t = (float*) target;
-	for(int i = length - 1; i >= 0; i--)
-		t[i] = s[i] / S16_FLT;
+	get_sample_functions().convert_s16_float(target, source, length);
 }
 
 void convert_s16_double(data_t* target, data_t* source, int length)
@@ -299,17 +297,7 @@ void convert_float_u8(data_t* target, data_t* source, int length)
 
 void convert_float_s16(data_t* target, data_t* source, int length)
 {
-	int16_t* t = (int16_t*) target;
-	float* s = (float*) source;
-	for(int i = 0; i < length; i++)
-	{
-		if(s[i] <= FLT_MIN)
-			t[i] = S16_MIN;
-		else if(s[i] >= FLT_MAX)
-			t[i] = S16_MAX;
-		else
-			t[i] = (int16_t)(s[i] * S16_MAX);
-	}
+	get_sample_functions().convert_float_s16(target, source, length);
 }
 
 void convert_float_s24_be(data_t* target, data_t* source, int length)
@@ -15,6 +15,7 @@
  ******************************************************************************/
 
 #include "respec/LinearResampleReader.h"
+#include "respec/SampleFunctions.h"
 
 #include <cmath>
 #include <cstring>
@@ -68,7 +69,6 @@ void LinearResampleReader::read(int& length, bool& eos, sample_t* buffer)
 	int size = length;
 	float factor = m_rate / m_reader->getSpecs().rate;
 	float spos = 0.0f;
-	sample_t low, high;
 	eos = false;
 
 	// check for channels changed
@@ -144,18 +144,10 @@ void LinearResampleReader::read(int& length, bool& eos, sample_t* buffer)
 	if(length == 0)
 		return;
 
-	for(int channel = 0; channel < m_channels; channel++)
-	{
-		for(int i = 0; i < length; i++)
-		{
-			spos = (i + 1) / factor + m_cache_pos;
-
-			low = buf[(int)std::floor(spos) * m_channels + channel];
-			high = buf[(int)std::ceil(spos) * m_channels + channel];
+	get_sample_functions().resample_linear(buffer, buf, length, m_channels, m_cache_pos, factor);
 
-			buffer[i * m_channels + channel] = low + (spos - std::floor(spos)) * (high - low);
-		}
-	}
+	// the position of the last resampled sample
+	spos = length / factor + m_cache_pos;
 
 	if(std::floor(spos) == spos)
 	{
@@ -15,6 +15,7 @@
  ******************************************************************************/
 
 #include "respec/Mixer.h"
+#include "respec/SampleFunctions.h"
 
 #include <algorithm>
 #include <cstring>
@@ -77,11 +78,9 @@ void Mixer::mix(sample_t* buffer, int start, int length, float volume)
 {
 	sample_t* out = m_buffer.getBuffer();
 
-	length = (std::min(m_length, length + start) - start) * m_specs.channels;
-	start *= m_specs.channels;
+	length = std::min(m_length, length + start) - start;
 
-	for(int i = 0; i < length; i++)
-		out[i + start] += buffer[i] * volume;
+	get_sample_functions().mix(out + start * m_specs.channels, buffer, length, m_specs.channels, volume, volume);
 }
 
 void Mixer::mix(sample_t* buffer, int start, int length, float volume_to, float volume_from)
@@ -90,13 +89,7 @@ void Mixer::mix(sample_t* buffer, int start, int length, float volume_to, float
 
 	length = (std::min(m_length, length + start) - start);
 
-	for(int i = 0; i < length; i++)
-	{
-		float volume = volume_from * (1.0f - i / float(length)) + volume_to * (i / float(length));
-
-		for(int c = 0; c < m_specs.channels; c++)
-			out[(i + start) * m_specs.channels + c] += buffer[i * m_specs.channels + c] * volume;
-	}
+	get_sample_functions().mix(out + start * m_specs.channels, buffer, length, m_specs.channels, volume_to, volume_from);
 }
 
 void Mixer::read(data_t* buffer, float volume)
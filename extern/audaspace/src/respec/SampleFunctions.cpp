@@ -0,0 +1,417 @@
+/*******************************************************************************
+ * Copyright 2009-2016 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include "respec/SampleFunctions.h"
+#include "SampleFunctionsSIMD.h"
+
+#include <stdint.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WITH_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#define WITH_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(WITH_AVX) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#define S16_MAX		((int16_t)0x7FFF)
+#define S16_MIN		((int16_t)0x8000)
+#define S16_FLT		32767.0f
+#define FLT_MAX		1.0f
+#define FLT_MIN		-1.0f
+
+AUD_NAMESPACE_BEGIN
+
+/******************************************************************************/
+/******************************** Scalar **************************************/
+/******************************************************************************/
+
+static void mix_scalar(sample_t* target, const sample_t* source, int length, int channels, float volume_to, float volume_from)
+{
+	mix_scalar_range(target, source, 0, length, channels, volume_to, volume_from);
+}
+
+static void resample_linear_scalar(sample_t* target, const sample_t* source, int length, int channels, float position, float factor)
+{
+	resample_linear_scalar_range(target, source, 0, length, channels, position, factor);
+}
+
+static void map_channels_scalar(sample_t* target, const sample_t* source, int length, int source_channels, int target_channels, const float* mapping)
+{
+	map_channels_scalar_range(target, source, 0, length, source_channels, target_channels, mapping);
+}
+
+static void convert_float_s16_scalar(data_t* target, data_t* source, int length)
+{
+	int16_t* t = (int16_t*) target;
+	float* s = (float*) source;
+	for(int i = 0; i < length; i++)
+	{
+		if(s[i] <= FLT_MIN)
+			t[i] = S16_MIN;
+		else if(s[i] >= FLT_MAX)
+			t[i] = S16_MAX;
+		else
+			t[i] = (int16_t)(s[i] * S16_MAX);
+	}
+}
+
+static void convert_s16_float_scalar(data_t* target, data_t* source, int length)
+{
+	int16_t* s = (int16_t*) source;
+	float* t = (float*) target;
+	for(int i = length - 1; i >= 0; i--)
+		t[i] = s[i] / S16_FLT;
+}
+
+static const SampleFunctions scalar_functions =
+{
+	SAMPLE_FUNCTIONS_SCALAR,
+	"scalar",
+	mix_scalar,
+	resample_linear_scalar,
+	map_channels_scalar,
+	convert_float_s16_scalar,
+	convert_s16_float_scalar
+};
+
+/******************************************************************************/
+/********************************* SSE2 ***************************************/
+/******************************************************************************/
+
+#ifdef WITH_SSE2
+
+namespace {
+
+struct VectorSSE2
+{
+	typedef __m128 type;
+	static const int size = 4;
+
+	static inline type load(const float* p) { return _mm_loadu_ps(p); }
+	static inline void store(float* p, type a) { _mm_storeu_ps(p, a); }
+	static inline type set1(float a) { return _mm_set1_ps(a); }
+	static inline type indices() { return _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f); }
+	static inline type add(type a, type b) { return _mm_add_ps(a, b); }
+	static inline type sub(type a, type b) { return _mm_sub_ps(a, b); }
+	static inline type mul(type a, type b) { return _mm_mul_ps(a, b); }
+	static inline type div(type a, type b) { return _mm_div_ps(a, b); }
+	static inline type bitwise_and(type a, type b) { return _mm_and_ps(a, b); }
+	static inline type greater(type a, type b) { return _mm_cmpgt_ps(a, b); }
+	static inline type truncate(type a) { return _mm_cvtepi32_ps(_mm_cvttps_epi32(a)); }
+	static inline void store_int(int* p, type a) { _mm_storeu_si128((__m128i*) p, _mm_cvttps_epi32(a)); }
+
+	static inline void store_interleaved(float* p, type a, type b)
+	{
+		_mm_storeu_ps(p, _mm_unpacklo_ps(a, b));
+		_mm_storeu_ps(p + 4, _mm_unpackhi_ps(a, b));
+	}
+};
+
+}
+
+static void mix_sse2(sample_t* target, const sample_t* source, int length, int channels, float volume_to, float volume_from)
+{
+	mix_vector<VectorSSE2>(target, source, length, channels, volume_to, volume_from);
+}
+
+static void resample_linear_sse2(sample_t* target, const sample_t* source, int length, int channels, float position, float factor)
+{
+	resample_linear_vector<VectorSSE2>(target, source, length, channels, position, factor);
+}
+
+static void map_channels_sse2(sample_t* target, const sample_t* source, int length, int source_channels, int target_channels, const float* mapping)
+{
+	map_channels_vector<VectorSSE2>(target, source, length, source_channels, target_channels, mapping);
+}
+
+static void convert_float_s16_sse2(data_t* target, data_t* source, int length)
+{
+	int16_t* t = (int16_t*) target;
+	float* s = (float*) source;
+	__m128 scale = _mm_set1_ps(S16_MAX);
+	__m128 minimum = _mm_set1_ps(FLT_MIN);
+	__m128 s16_min = _mm_set1_ps(S16_MIN);
+	__m128 s16_max = _mm_set1_ps(S16_MAX);
+	int i = 0;
+
+	// the target may be the source, each iteration reads its samples before writing the smaller result
+	for(; i + 8 <= length; i += 8)
+	{
+		__m128 a = _mm_loadu_ps(s + i);
+		__m128 b = _mm_loadu_ps(s + i + 4);
+
+		// like the scalar conversion, -1 and below map to S16_MIN and the product is clamped to S16_MAX
+		__m128 ma = _mm_cmple_ps(a, minimum);
+		__m128 mb = _mm_cmple_ps(b, minimum);
+		a = _mm_min_ps(_mm_mul_ps(a, scale), s16_max);
+		b = _mm_min_ps(_mm_mul_ps(b, scale), s16_max);
+		a = _mm_or_ps(_mm_and_ps(ma, s16_min), _mm_andnot_ps(ma, a));
+		b = _mm_or_ps(_mm_and_ps(mb, s16_min), _mm_andnot_ps(mb, b));
+
+		_mm_storeu_si128((__m128i*)(t + i), _mm_packs_epi32(_mm_cvttps_epi32(a), _mm_cvttps_epi32(b)));
+	}
+
+	convert_float_s16_scalar((data_t*)(t + i), (data_t*)(s + i), length - i);
+}
+
+static void convert_s16_float_sse2(data_t* target, data_t* source, int length)
+{
+	int16_t* s = (int16_t*) source;
+	float* t = (float*) target;
+	__m128 scale = _mm_set1_ps(S16_FLT);
+	int i = length;
+
+	// converting backwards allows converting in place, each iteration reads its samples before writing the larger result
+	for(; i >= 8; i -= 8)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)(s + i - 8));
+		__m128 a = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+		__m128 b = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+
+		_mm_storeu_ps(t + i - 8, _mm_div_ps(a, scale));
+		_mm_storeu_ps(t + i - 4, _mm_div_ps(b, scale));
+	}
+
+	convert_s16_float_scalar(target, source, i);
+}
+
+static const SampleFunctions sse2_functions =
+{
+	SAMPLE_FUNCTIONS_SSE2,
+	"SSE2",
+	mix_sse2,
+	resample_linear_sse2,
+	map_channels_sse2,
+	convert_float_s16_sse2,
+	convert_s16_float_sse2
+};
+
+#endif
+
+/******************************************************************************/
+/********************************** AVX ***************************************/
+/******************************************************************************/
+
+#ifdef WITH_AVX
+
+// AVX lacks 256 bit integer operations, the conversions use SSE2
+static const SampleFunctions avx_functions =
+{
+	SAMPLE_FUNCTIONS_AVX,
+	"AVX",
+	mix_avx,
+	resample_linear_avx,
+	map_channels_avx,
+#ifdef WITH_SSE2
+	convert_float_s16_sse2,
+	convert_s16_float_sse2
+#else
+	convert_float_s16_scalar,
+	convert_s16_float_scalar
+#endif
+};
+
+#endif
+
+/******************************************************************************/
+/********************************* NEON ***************************************/
+/******************************************************************************/
+
+#ifdef WITH_NEON
+
+namespace {
+
+struct VectorNEON
+{
+	typedef float32x4_t type;
+	static const int size = 4;
+
+	static inline type load(const float* p) { return vld1q_f32(p); }
+	static inline void store(float* p, type a) { vst1q_f32(p, a); }
+	static inline type set1(float a) { return vdupq_n_f32(a); }
+	static inline type indices() { static const float lanes[4] = {0.0f, 1.0f, 2.0f, 3.0f}; return vld1q_f32(lanes); }
+	static inline type add(type a, type b) { return vaddq_f32(a, b); }
+	static inline type sub(type a, type b) { return vsubq_f32(a, b); }
+	static inline type mul(type a, type b) { return vmulq_f32(a, b); }
+	static inline type div(type a, type b) { return vdivq_f32(a, b); }
+	static inline type bitwise_and(type a, type b) { return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+	static inline type greater(type a, type b) { return vreinterpretq_f32_u32(vcgtq_f32(a, b)); }
+	static inline type truncate(type a) { return vrndq_f32(a); }
+	static inline void store_int(int* p, type a) { vst1q_s32(p, vcvtq_s32_f32(a)); }
+
+	static inline void store_interleaved(float* p, type a, type b)
+	{
+		float32x4x2_t v = {{a, b}};
+		vst2q_f32(p, v);
+	}
+};
+
+}
+
+static void mix_neon(sample_t* target, const sample_t* source, int length, int channels, float volume_to, float volume_from)
+{
+	mix_vector<VectorNEON>(target, source, length, channels, volume_to, volume_from);
+}
+
+static void resample_linear_neon(sample_t* target, const sample_t* source, int length, int channels, float position, float factor)
+{
+	resample_linear_vector<VectorNEON>(target, source, length, channels, position, factor);
+}
+
+static void map_channels_neon(sample_t* target, const sample_t* source, int length, int source_channels, int target_channels, const float* mapping)
+{
+	map_channels_vector<VectorNEON>(target, source, length, source_channels, target_channels, mapping);
+}
+
+static void convert_float_s16_neon(data_t* target, data_t* source, int length)
+{
+	int16_t* t = (int16_t*) target;
+	float* s = (float*) source;
+	float32x4_t scale = vdupq_n_f32(S16_MAX);
+	float32x4_t minimum = vdupq_n_f32(FLT_MIN);
+	float32x4_t s16_min = vdupq_n_f32(S16_MIN);
+	float32x4_t s16_max = vdupq_n_f32(S16_MAX);
+	int i = 0;
+
+	// the target may be the source, each iteration reads its samples before writing the smaller result
+	for(; i + 8 <= length; i += 8)
+	{
+		float32x4_t a = vld1q_f32(s + i);
+		float32x4_t b = vld1q_f32(s + i + 4);
+
+		// like the scalar conversion, -1 and below map to S16_MIN and the product is clamped to S16_MAX
+		uint32x4_t ma = vcleq_f32(a, minimum);
+		uint32x4_t mb = vcleq_f32(b, minimum);
+		a = vbslq_f32(ma, s16_min, vminq_f32(vmulq_f32(a, scale), s16_max));
+		b = vbslq_f32(mb, s16_min, vminq_f32(vmulq_f32(b, scale), s16_max));
+
+		vst1q_s16(t + i, vcombine_s16(vqmovn_s32(vcvtq_s32_f32(a)), vqmovn_s32(vcvtq_s32_f32(b))));
+	}
+
+	convert_float_s16_scalar((data_t*)(t + i), (data_t*)(s + i), length - i);
+}
+
+static void convert_s16_float_neon(data_t* target, data_t* source, int length)
+{
+	int16_t* s = (int16_t*) source;
+	float* t = (float*) target;
+	float32x4_t scale = vdupq_n_f32(S16_FLT);
+	int i = length;
+
+	// converting backwards allows converting in place, each iteration reads its samples before writing the larger result
+	for(; i >= 8; i -= 8)
+	{
+		int16x8_t v = vld1q_s16(s + i - 8);
+		float32x4_t a = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+		float32x4_t b = vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)));
+
+		vst1q_f32(t + i - 8, vdivq_f32(a, scale));
+		vst1q_f32(t + i - 4, vdivq_f32(b, scale));
+	}
+
+	convert_s16_float_scalar(target, source, i);
+}
+
+static const SampleFunctions neon_functions =
+{
+	SAMPLE_FUNCTIONS_NEON,
+	"NEON",
+	mix_neon,
+	resample_linear_neon,
+	map_channels_neon,
+	convert_float_s16_neon,
+	convert_s16_float_neon
+};
+
+#endif
+
+/******************************************************************************/
+/******************************* Dispatch *************************************/
+/******************************************************************************/
+
+#ifdef WITH_AVX
+static bool cpu_supports_avx()
+{
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 1);
+
+	// the CPU has to support AVX and the OS has to save the AVX registers
+	if(!(info[2] & (1 << 27)) || !(info[2] & (1 << 28)))
+		return false;
+
+	return (_xgetbv(0) & 6) == 6;
+#elif defined(__GNUC__)
+	return __builtin_cpu_supports("avx");
+#else
+	return false;
+#endif
+}
+#endif
+
+const SampleFunctions* get_sample_functions(SampleFunctionsISA isa)
+{
+	switch(isa)
+	{
+	case SAMPLE_FUNCTIONS_SCALAR:
+		return &scalar_functions;
+#ifdef WITH_SSE2
+	case SAMPLE_FUNCTIONS_SSE2:
+		return &sse2_functions;
+#endif
+#ifdef WITH_AVX
+	case SAMPLE_FUNCTIONS_AVX:
+		if(cpu_supports_avx())
+			return &avx_functions;
+		return nullptr;
+#endif
+#ifdef WITH_NEON
+	case SAMPLE_FUNCTIONS_NEON:
+		return &neon_functions;
+#endif
+	default:
+		return nullptr;
+	}
+}
+
+static const SampleFunctions* detect_sample_functions()
+{
+	static const SampleFunctionsISA preferred[] = {SAMPLE_FUNCTIONS_AVX, SAMPLE_FUNCTIONS_SSE2, SAMPLE_FUNCTIONS_NEON};
+
+	for(SampleFunctionsISA isa : preferred)
+	{
+		const SampleFunctions* functions = get_sample_functions(isa);
+		if(functions)
+			return functions;
+	}
+
+	return &scalar_functions;
+}
+
+const SampleFunctions& get_sample_functions()
+{
+	static const SampleFunctions* functions = detect_sample_functions();
+	return *functions;
+}
+
+AUD_NAMESPACE_END
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * Copyright 2009-2016 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+/*
+ * This file is compiled with AVX enabled, its functions may only be called
+ * after checking the CPU support, see get_sample_functions().
+ */
+
+#include "SampleFunctionsSIMD.h"
+
+#include <immintrin.h>
+
+AUD_NAMESPACE_BEGIN
+
+namespace {
+
+struct VectorAVX
+{
+	typedef __m256 type;
+	static const int size = 8;
+
+	static inline type load(const float* p) { return _mm256_loadu_ps(p); }
+	static inline void store(float* p, type a) { _mm256_storeu_ps(p, a); }
+	static inline type set1(float a) { return _mm256_set1_ps(a); }
+	static inline type indices() { return _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f); }
+	static inline type add(type a, type b) { return _mm256_add_ps(a, b); }
+	static inline type sub(type a, type b) { return _mm256_sub_ps(a, b); }
+	static inline type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+	static inline type div(type a, type b) { return _mm256_div_ps(a, b); }
+	static inline type bitwise_and(type a, type b) { return _mm256_and_ps(a, b); }
+	static inline type greater(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+	static inline type truncate(type a) { return _mm256_round_ps(a, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+	static inline void store_int(int* p, type a) { _mm256_storeu_si256((__m256i*) p, _mm256_cvttps_epi32(a)); }
+
+	static inline void store_interleaved(float* p, type a, type b)
+	{
+		// the unpack instructions interleave within the 128 bit lanes
+		type low = _mm256_unpacklo_ps(a, b);
+		type high = _mm256_unpackhi_ps(a, b);
+
+		_mm256_storeu_ps(p, _mm256_permute2f128_ps(low, high, 0x20));
+		_mm256_storeu_ps(p + 8, _mm256_permute2f128_ps(low, high, 0x31));
+	}
+};
+
+}
+
+void mix_avx(sample_t* target, const sample_t* source, int length, int channels, float volume_to, float volume_from)
+{
+	mix_vector<VectorAVX>(target, source, length, channels, volume_to, volume_from);
+}
+
+void resample_linear_avx(sample_t* target, const sample_t* source, int length, int channels, float position, float factor)
+{
+	resample_linear_vector<VectorAVX>(target, source, length, channels, position, factor);
+}
+
+void map_channels_avx(sample_t* target, const sample_t* source, int length, int source_channels, int target_channels, const float* mapping)
+{
+	map_channels_vector<VectorAVX>(target, source, length, source_channels, target_channels, mapping);
+}
+
+AUD_NAMESPACE_END
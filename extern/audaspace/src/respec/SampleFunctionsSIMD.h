@@ -0,0 +1,272 @@
+/*******************************************************************************
+ * Copyright 2009-2016 Jörg Müller
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+/*
+ * Scalar sample kernels and the vector kernels templated on the vector
+ * operations of an instruction set. Every translation unit compiled for an
+ * instruction set instantiates the vector kernels with its own vector type.
+ *
+ * The vector kernels compute the same expressions in the same order as the
+ * scalar kernels, so that the results don't depend on the instruction set.
+ *
+ * All functions here have internal linkage: a copy compiled with AVX enabled
+ * must never be picked by the linker for the other translation units.
+ */
+
+#include "respec/SampleFunctions.h"
+
+AUD_NAMESPACE_BEGIN
+
+/// The maximum channel count the vector kernels support, higher counts use the scalar kernels.
+#define SAMPLE_FUNCTIONS_MAX_CHANNELS 8
+
+/**
+ * Mixes the samples starting at a frame with a volume ramp.
+ */
+static inline void mix_scalar_range(sample_t* target, const sample_t* source, int begin, int length, int channels, float volume_to, float volume_from)
+{
+	for(int i = begin; i < length; i++)
+	{
+		float volume = volume_from * (1.0f - i / float(length)) + volume_to * (i / float(length));
+
+		for(int c = 0; c < channels; c++)
+			target[i * channels + c] += source[i * channels + c] * volume;
+	}
+}
+
+/**
+ * Linearly resamples the samples starting at a frame.
+ */
+static inline void resample_linear_scalar_range(sample_t* target, const sample_t* source, int begin, int length, int channels, float position, float factor)
+{
+	for(int i = begin; i < length; i++)
+	{
+		float spos = (i + 1) / factor + position;
+		int low = int(spos);
+		float fraction = spos - low;
+		int high = fraction > 0 ? low + 1 : low;
+
+		for(int c = 0; c < channels; c++)
+		{
+			sample_t l = source[low * channels + c];
+			target[i * channels + c] = l + fraction * (source[high * channels + c] - l);
+		}
+	}
+}
+
+/**
+ * Maps the channels of the samples starting at a frame.
+ */
+static inline void map_channels_scalar_range(sample_t* target, const sample_t* source, int begin, int length, int source_channels, int target_channels, const float* mapping)
+{
+	sample_t sum;
+
+	for(int i = begin; i < length; i++)
+	{
+		for(int j = 0; j < target_channels; j++)
+		{
+			sum = 0;
+			for(int k = 0; k < source_channels; k++)
+				sum += mapping[j * source_channels + k] * source[i * source_channels + k];
+			target[i * target_channels + j] = sum;
+		}
+	}
+}
+
+/*
+ * The vector operations V has to provide:
+ * - type: the vector type and size: the number of floats in the vector.
+ * - load, store: unaligned memory access.
+ * - set1: broadcasts a float.
+ * - indices: the vector {0, 1, ..., size - 1}.
+ * - add, sub, mul, div, bitwise_and.
+ * - greater: a mask of all bits set where a > b.
+ * - truncate: rounds towards zero.
+ * - store_int: stores the vector truncated to integers.
+ * - store_interleaved: stores a0 b0 a1 b1 ...
+ */
+
+template <class V>
+static void mix_vector(sample_t* target, const sample_t* source, int length, int channels, float volume_to, float volume_from)
+{
+	typedef typename V::type vec;
+
+	if(volume_from == volume_to)
+	{
+		int samples = length * channels;
+		vec volume = V::set1(volume_to);
+		int i = 0;
+
+		for(; i + V::size <= samples; i += V::size)
+			V::store(target + i, V::add(V::load(target + i), V::mul(V::load(source + i), volume)));
+
+		for(; i < samples; i++)
+			target[i] += source[i] * volume_to;
+
+		return;
+	}
+
+	if(channels > SAMPLE_FUNCTIONS_MAX_CHANNELS)
+	{
+		mix_scalar_range(target, source, 0, length, channels, volume_to, volume_from);
+		return;
+	}
+
+	// a block of V::size frames spans channels vectors, the frame of each vector lane is the same in all blocks
+	float frames[SAMPLE_FUNCTIONS_MAX_CHANNELS * V::size];
+	for(int k = 0; k < channels * V::size; k++)
+		frames[k] = float(k / channels);
+
+	vec from = V::set1(volume_from);
+	vec to = V::set1(volume_to);
+	vec one = V::set1(1.0f);
+	vec len = V::set1(float(length));
+	int i = 0;
+
+	for(; i + V::size <= length; i += V::size)
+	{
+		vec frame = V::set1(float(i));
+
+		for(int k = 0; k < channels; k++)
+		{
+			vec t = V::div(V::add(frame, V::load(frames + k * V::size)), len);
+			vec volume = V::add(V::mul(from, V::sub(one, t)), V::mul(to, t));
+			sample_t* out = target + i * channels + k * V::size;
+
+			V::store(out, V::add(V::load(out), V::mul(V::load(source + i * channels + k * V::size), volume)));
+		}
+	}
+
+	mix_scalar_range(target, source, i, length, channels, volume_to, volume_from);
+}
+
+template <class V>
+static void resample_linear_vector(sample_t* target, const sample_t* source, int length, int channels, float position, float factor)
+{
+	typedef typename V::type vec;
+
+	vec pos = V::set1(position);
+	vec fac = V::set1(factor);
+	vec zero = V::set1(0.0f);
+	vec one = V::set1(1.0f);
+	vec lanes = V::indices();
+	int low[V::size];
+	int high[V::size];
+	float values[V::size];
+	float next[V::size];
+	int i = 0;
+
+	for(; i + V::size <= length; i += V::size)
+	{
+		// the positions are never negative, so truncating is flooring
+		vec spos = V::add(V::div(V::add(V::set1(float(i + 1)), lanes), fac), pos);
+		vec floor = V::truncate(spos);
+		vec fraction = V::sub(spos, floor);
+
+		V::store_int(low, floor);
+		V::store_int(high, V::add(floor, V::bitwise_and(V::greater(fraction, zero), one)));
+
+		for(int c = 0; c < channels; c++)
+		{
+			for(int l = 0; l < V::size; l++)
+			{
+				values[l] = source[low[l] * channels + c];
+				next[l] = source[high[l] * channels + c];
+			}
+
+			vec first = V::load(values);
+			vec result = V::add(first, V::mul(fraction, V::sub(V::load(next), first)));
+
+			if(channels == 1)
+				V::store(target + i, result);
+			else
+			{
+				V::store(values, result);
+				for(int l = 0; l < V::size; l++)
+					target[(i + l) * channels + c] = values[l];
+			}
+		}
+	}
+
+	resample_linear_scalar_range(target, source, i, length, channels, position, factor);
+}
+
+template <class V>
+static void map_channels_vector(sample_t* target, const sample_t* source, int length, int source_channels, int target_channels, const float* mapping)
+{
+	typedef typename V::type vec;
+
+	// only mono sources, which 3D sounds are, are vectorized
+	if(source_channels != 1 || target_channels > SAMPLE_FUNCTIONS_MAX_CHANNELS)
+	{
+		map_channels_scalar_range(target, source, 0, length, source_channels, target_channels, mapping);
+		return;
+	}
+
+	int i = 0;
+
+	if(target_channels == 2)
+	{
+		vec left = V::set1(mapping[0]);
+		vec right = V::set1(mapping[1]);
+
+		for(; i + V::size <= length; i += V::size)
+		{
+			vec in = V::load(source + i);
+			V::store_interleaved(target + i * 2, V::mul(in, left), V::mul(in, right));
+		}
+	}
+	else
+	{
+		// a block of V::size frames spans target_channels vectors, the source frame and mapping of each lane is the same in all blocks
+		float factors[SAMPLE_FUNCTIONS_MAX_CHANNELS * V::size];
+		int frames[SAMPLE_FUNCTIONS_MAX_CHANNELS * V::size];
+		float values[V::size];
+
+		for(int k = 0; k < target_channels * V::size; k++)
+		{
+			factors[k] = mapping[k % target_channels];
+			frames[k] = k / target_channels;
+		}
+
+		for(; i + V::size <= length; i += V::size)
+		{
+			for(int k = 0; k < target_channels; k++)
+			{
+				for(int l = 0; l < V::size; l++)
+					values[l] = source[i + frames[k * V::size + l]];
+
+				V::store(target + i * target_channels + k * V::size, V::mul(V::load(values), V::load(factors + k * V::size)));
+			}
+		}
+	}
+
+	map_channels_scalar_range(target, source, i, length, source_channels, target_channels, mapping);
+}
+
+#ifdef WITH_AVX
+/*
+ * The AVX kernels, compiled in a separate translation unit with AVX enabled.
+ * The CPU support has to be checked before calling them.
+ */
+void mix_avx(sample_t* target, const sample_t* source, int length, int channels, float volume_to, float volume_from);
+void resample_linear_avx(sample_t* target, const sample_t* source, int length, int channels, float position, float factor);
+void map_channels_avx(sample_t* target, const sample_t* source, int length, int source_channels, int target_channels, const float* mapping);
+#endif
+
+AUD_NAMESPACE_END
@@ -59,6 +59,15 @@ static btClock gProfileClock;
 
 #define mymin(a,b) (a > b ? a : b)
 
+#include <thread>
+
+/* The profile tree isn't thread safe, only the thread which profiled first is recorded. */
+static bool btIsProfiledThread()
+{
+	static const std::thread::id profiledThread = std::this_thread::get_id();
+	return std::this_thread::get_id() == profiledThread;
+}
+
 struct btClockData
 {
 
@@ -455,6 +464,10 @@ unsigned long int			CProfileManager::ResetTime = 0;
  *=============================================================================================*/
 void	CProfileManager::Start_Profile( const char * name )
 {
+	if (!btIsProfiledThread()) {
+		return;
+	}
+
 	if (name != CurrentNode->Get_Name()) {
 		CurrentNode = CurrentNode->Get_Sub_Node( name );
 	}
@@ -468,6 +481,10 @@ void	CProfileManager::Start_Profile( const char * name )
  *=============================================================================================*/
 void	CProfileManager::Stop_Profile( void )
 {
+	if (!btIsProfiledThread()) {
+		return;
+	}
+
 	// Return will indicate whether we should back up to our parent (we may
 	// be profiling a recursive function)
 	if (CurrentNode->Return()) {
@@ -58,6 +58,13 @@
  */
 #define DELAYED_QUEUE_SIZE 4096
 
+/* Number of tasks which can be queued in the work-stealing deque of a thread,
+ * must be a power of two.
+ *
+ * Tasks which don't fit are pushed to the scheduler's global queue.
+ */
+#define TASK_DEQUE_SIZE 1024
+
 #ifndef NDEBUG
 #  define ASSERT_THREAD_ID(scheduler, thread_id) \
     do { \
@@ -157,12 +164,38 @@ typedef struct TaskThreadLocalStorage {
   Task *delayed_queue[DELAYED_QUEUE_SIZE];
 } TaskThreadLocalStorage;
 
+/* Bounded work-stealing deque (Chase-Lev) of a thread.
+ *
+ * The owner thread pushes and pops tasks at the bottom without any lock, so
+ * the most recently pushed task (which is likely to be hot in cache) runs
+ * first. Other threads steal the oldest tasks from the top, which only costs
+ * a compare-and-swap on top.
+ *
+ * Indices only grow, the task slot is the index modulo TASK_DEQUE_SIZE.
+ * Top and bottom are kept on separate cache lines to avoid false sharing
+ * between the owner and the thieves.
+ */
+typedef struct TaskDeque {
+  int64_t top;
+  char _pad0[64 - sizeof(int64_t)];
+  int64_t bottom;
+  char _pad1[64 - sizeof(int64_t)];
+  Task *tasks[TASK_DEQUE_SIZE];
+} TaskDeque;
+
 struct TaskPool {
   TaskScheduler *scheduler;
 
-  volatile size_t num;
+  /* Number of pushed tasks which are not done yet, accessed atomically. */
+  size_t num;
   ThreadMutex num_mutex;
   ThreadCondition num_cond;
+  /* Incremented every time new tasks of the pool become available in any
+   * queue, used by work_and_wait() to not miss tasks while going to sleep.
+   */
+  size_t num_available;
+  /* Number of threads sleeping in work_and_wait() on num_cond. */
+  size_t num_waiting;
 
   void *userdata;
   ThreadMutex user_mutex;
@@ -207,7 +240,22 @@ struct TaskScheduler {
   int num_threads;
   bool background_thread_only;
 
+  /* Tasks pushed by the main thread and worker threads go to their own
+   * deque, idle threads steal from the deques of other threads. Disabled
+   * in the background thread only case where tasks must be filtered by pool.
+   */
+  bool use_deques;
+  /* Number of tasks in all the deques, accessed atomically. */
+  size_t num_deque_tasks;
+  /* Number of worker threads sleeping on queue_cond, accessed atomically. */
+  size_t num_sleeping_threads;
+
+  /* Global queue for high priority tasks, tasks pushed from threads without
+   * a deque and tasks which don't fit in a deque.
+   */
   ListBase queue;
+  /* Number of tasks in the global queue, modified with queue_mutex locked. */
+  volatile size_t num_queued;
   ThreadMutex queue_mutex;
   ThreadCondition queue_cond;
 
@@ -225,6 +273,7 @@ typedef struct TaskThread {
   TaskScheduler *scheduler;
   int id;
   TaskThreadLocalStorage tls;
+  TaskDeque deque;
 } TaskThread;
 
 /* Helper */
@@ -326,17 +375,112 @@ static void task_free(TaskPool *pool, Task *task, const int thread_id)
   }
 }
 
+/* Task Deque */
+
+BLI_INLINE int64_t task_atomic_load_int64(int64_t *p)
+{
+  return *(volatile int64_t *)p;
+}
+
+BLI_INLINE size_t task_atomic_load_z(size_t *p)
+{
+  /* Full barrier, orders the load with the preceding atomic operations. */
+  return atomic_add_and_fetch_z(p, 0);
+}
+
+static void task_deque_init(TaskDeque *deque)
+{
+  deque->top = 0;
+  deque->bottom = 0;
+}
+
+/* Push a task at the bottom, only called by the owner thread.
+ * Returns false if the deque is full. */
+static bool task_deque_push(TaskDeque *deque, Task *task)
+{
+  const int64_t bottom = deque->bottom;
+  const int64_t top = task_atomic_load_int64(&deque->top);
+
+  if (bottom - top >= TASK_DEQUE_SIZE) {
+    return false;
+  }
+
+  deque->tasks[bottom & (TASK_DEQUE_SIZE - 1)] = task;
+  /* Publish the task to the thieves, the atomic operation is a full barrier. */
+  atomic_add_and_fetch_int64(&deque->bottom, 1);
+
+  return true;
+}
+
+/* Pop the most recently pushed task, only called by the owner thread. */
+static Task *task_deque_pop(TaskDeque *deque)
+{
+  /* Reserve the bottom task before reading top, thieves seeing the new bottom
+   * won't take this task and we see any steal which happened before. */
+  const int64_t bottom = atomic_sub_and_fetch_int64(&deque->bottom, 1);
+  const int64_t top = task_atomic_load_int64(&deque->top);
+
+  if (top > bottom) {
+    /* Empty deque. */
+    atomic_add_and_fetch_int64(&deque->bottom, 1);
+    return NULL;
+  }
+
+  Task *task = deque->tasks[bottom & (TASK_DEQUE_SIZE - 1)];
+
+  if (top == bottom) {
+    /* Last task, a thief might be taking it at the same time. */
+    if (atomic_cas_int64(&deque->top, top, top + 1) != top) {
+      task = NULL;
+    }
+    atomic_add_and_fetch_int64(&deque->bottom, 1);
+  }
+
+  return task;
+}
+
+/* Steal the oldest task, called by any thread but the owner.
+ * Returns NULL if the deque is empty or another thread took the task. */
+static Task *task_deque_steal(TaskDeque *deque)
+{
+  /* Read top before bottom, the atomic operation is a full barrier. */
+  const int64_t top = atomic_add_and_fetch_int64(&deque->top, 0);
+  const int64_t bottom = task_atomic_load_int64(&deque->bottom);
+
+  if (top >= bottom) {
+    return NULL;
+  }
+
+  Task *task = ((Task *volatile *)deque->tasks)[top & (TASK_DEQUE_SIZE - 1)];
+
+  if (atomic_cas_int64(&deque->top, top, top + 1) != top) {
+    return NULL;
+  }
+
+  return task;
+}
+
 /* Task Scheduler */
 
 static void task_pool_num_decrease(TaskPool *pool, size_t done)
 {
+  /* Lock-free decrement while the pool keeps other tasks. */
+  size_t num = task_atomic_load_z(&pool->num);
+  while (num > done) {
+    const size_t prev_num = atomic_cas_z(&pool->num, num, num - done);
+    if (prev_num == num) {
+      return;
+    }
+    num = prev_num;
+  }
+
+  /* The last tasks are done with the mutex locked, so that a thread waiting
+   * for the pool can't free it before we notify. */
   BLI_mutex_lock(&pool->num_mutex);
 
   BLI_assert(pool->num >= done);
 
-  pool->num -= done;
-
-  if (pool->num == 0) {
+  if (atomic_sub_and_fetch_z(&pool->num, done) == 0) {
     BLI_condition_notify_all(&pool->num_cond);
   }
 
@@ -345,63 +489,137 @@ static void task_pool_num_decrease(TaskPool *pool, size_t done)
 
 static void task_pool_num_increase(TaskPool *pool, size_t new)
 {
-  BLI_mutex_lock(&pool->num_mutex);
+  atomic_add_and_fetch_z(&pool->num, new);
+}
 
-  pool->num += new;
-  BLI_condition_notify_all(&pool->num_cond);
+/* Wake up threads waiting in work_and_wait() for new tasks of the pool.
+ *
+ * The pool can be freed as soon as its last task is done, so this is called
+ * while the queue holding the new task is locked or before the task is pushed.
+ */
+static void task_pool_notify_available(TaskPool *pool)
+{
+  atomic_add_and_fetch_z(&pool->num_available, 1);
 
-  BLI_mutex_unlock(&pool->num_mutex);
+  if (task_atomic_load_z(&pool->num_waiting) != 0) {
+    BLI_mutex_lock(&pool->num_mutex);
+    BLI_condition_notify_all(&pool->num_cond);
+    BLI_mutex_unlock(&pool->num_mutex);
+  }
 }
 
-static bool task_scheduler_thread_wait_pop(TaskScheduler *scheduler, Task **task)
+/* Return the scheduler thread of the calling thread, NULL for threads which
+ * are not managed by the scheduler. */
+BLI_INLINE TaskThread *task_scheduler_current_thread(TaskScheduler *scheduler)
 {
-  bool found_task = false;
-  BLI_mutex_lock(&scheduler->queue_mutex);
+  if (BLI_thread_is_main()) {
+    return &scheduler->task_threads[0];
+  }
+  return pthread_getspecific(scheduler->tls_id_key);
+}
+
+/* Pop the first task of the global queue which can be run by a worker thread,
+ * the queue mutex must be locked. */
+static Task *task_scheduler_queue_pop(TaskScheduler *scheduler)
+{
+  for (Task *task = scheduler->queue.first; task != NULL; task = task->next) {
+    if (scheduler->background_thread_only && !task->pool->run_in_background) {
+      continue;
+    }
 
-  while (!scheduler->queue.first && !scheduler->do_exit) {
-    BLI_condition_wait(&scheduler->queue_cond, &scheduler->queue_mutex);
+    BLI_remlink(&scheduler->queue, task);
+    scheduler->num_queued--;
+    return task;
   }
 
-  do {
-    Task *current_task;
+  return NULL;
+}
 
-    /* Assuming we can only have a void queue in 'exit' case here seems logical
-     * (we should only be here after our worker thread has been woken up from a
-     * condition_wait(), which only happens after a new task was added to the queue),
-     * but it is wrong.
-     * Waiting on condition may wake up the thread even if condition is not signaled
-     * (spurious wake-ups), and some race condition may also empty the queue **after**
-     * condition has been signaled, but **before** awoken thread reaches this point...
-     * See http://stackoverflow.com/questions/8594591
-     *
-     * So we only abort here if do_exit is set.
-     */
-    if (scheduler->do_exit) {
-      BLI_mutex_unlock(&scheduler->queue_mutex);
-      return false;
+/* Steal a task from the deque of any thread but the thief. */
+static Task *task_scheduler_steal(TaskScheduler *scheduler, TaskThread *thief)
+{
+  const int num_deques = scheduler->num_threads + 1;
+  const int first_victim = (thief != NULL) ? thief->id + 1 : 0;
+
+  for (int i = 0; i < num_deques; i++) {
+    TaskThread *victim = &scheduler->task_threads[(first_victim + i) % num_deques];
+    if (victim == thief) {
+      continue;
     }
 
-    for (current_task = scheduler->queue.first; current_task != NULL;
-         current_task = current_task->next) {
-      TaskPool *pool = current_task->pool;
+    Task *task = task_deque_steal(&victim->deque);
+    if (task != NULL) {
+      atomic_sub_and_fetch_z(&scheduler->num_deque_tasks, 1);
+      return task;
+    }
+  }
+
+  return NULL;
+}
+
+static bool task_scheduler_thread_wait_pop(TaskScheduler *scheduler,
+                                           TaskThread *thread,
+                                           Task **task)
+{
+  while (!scheduler->do_exit) {
+    /* High priority tasks are only in the global queue, look there first. */
+    if (scheduler->num_queued != 0) {
+      BLI_mutex_lock(&scheduler->queue_mutex);
+      *task = task_scheduler_queue_pop(scheduler);
+      BLI_mutex_unlock(&scheduler->queue_mutex);
 
-      if (scheduler->background_thread_only && !pool->run_in_background) {
-        continue;
+      if (*task != NULL) {
+        return true;
+      }
+    }
+
+    if (scheduler->use_deques) {
+      *task = task_deque_pop(&thread->deque);
+      if (*task != NULL) {
+        atomic_sub_and_fetch_z(&scheduler->num_deque_tasks, 1);
+        return true;
       }
 
-      *task = current_task;
-      found_task = true;
-      BLI_remlink(&scheduler->queue, *task);
-      break;
+      *task = task_scheduler_steal(scheduler, thread);
+      if (*task != NULL) {
+        return true;
+      }
     }
-    if (!found_task) {
+
+    /* Nothing to run, sleep until a task is pushed. */
+    BLI_mutex_lock(&scheduler->queue_mutex);
+
+    /* Waiting on condition may wake up the thread even if condition is not
+     * signaled (spurious wake-ups), and some race condition may also empty the
+     * queue **after** condition has been signaled, but **before** awoken thread
+     * reaches this point...
+     * See http://stackoverflow.com/questions/8594591
+     *
+     * So we check the queues again after every wake up.
+     */
+    while (!scheduler->do_exit) {
+      *task = task_scheduler_queue_pop(scheduler);
+      if (*task != NULL) {
+        BLI_mutex_unlock(&scheduler->queue_mutex);
+        return true;
+      }
+
+      /* Deque pushes are lock-free, they only notify if they see a sleeping
+       * thread. Either the pusher sees us sleeping or we see its task. */
+      atomic_add_and_fetch_z(&scheduler->num_sleeping_threads, 1);
+      if (task_atomic_load_z(&scheduler->num_deque_tasks) != 0) {
+        atomic_sub_and_fetch_z(&scheduler->num_sleeping_threads, 1);
+        break;
+      }
+
       BLI_condition_wait(&scheduler->queue_cond, &scheduler->queue_mutex);
+      atomic_sub_and_fetch_z(&scheduler->num_sleeping_threads, 1);
     }
-  } while (!found_task);
 
-  BLI_mutex_unlock(&scheduler->queue_mutex);
+    BLI_mutex_unlock(&scheduler->queue_mutex);
+  }
 
-  return true;
+  return false;
 }
 
 BLI_INLINE void handle_local_queue(TaskThreadLocalStorage *tls, const int thread_id)
@@ -442,13 +660,16 @@ static void *task_scheduler_thread_run(void *thread_p)
   BLI_mutex_unlock(&scheduler->startup_mutex);
 
   /* keep popping off tasks */
-  while (task_scheduler_thread_wait_pop(scheduler, &task)) {
+  while (task_scheduler_thread_wait_pop(scheduler, thread, &task)) {
     TaskPool *pool = task->pool;
 
-    /* run task */
-    BLI_assert(!tls->do_delayed_push);
-    task->run(pool, task->taskdata, thread_id);
-    BLI_assert(!tls->do_delayed_push);
+    /* Tasks of canceled pools still in a deque are discarded. */
+    if (!pool->do_cancel) {
+      /* run task */
+      BLI_assert(!tls->do_delayed_push);
+      task->run(pool, task->taskdata, thread_id);
+      BLI_assert(!tls->do_delayed_push);
+    }
 
     /* delete task */
     task_free(pool, task, thread_id);
@@ -472,6 +693,7 @@ TaskScheduler *BLI_task_scheduler_create(int num_threads)
   scheduler->do_exit = false;
 
   BLI_listbase_clear(&scheduler->queue);
+  scheduler->num_queued = 0;
   BLI_mutex_init(&scheduler->queue_mutex);
   BLI_condition_init(&scheduler->queue_cond);
 
@@ -493,11 +715,18 @@ TaskScheduler *BLI_task_scheduler_create(int num_threads)
     num_threads = 1;
   }
 
+  scheduler->use_deques = !scheduler->background_thread_only;
+  scheduler->num_deque_tasks = 0;
+  scheduler->num_sleeping_threads = 0;
+
   scheduler->task_threads = MEM_mallocN(sizeof(TaskThread) * (num_threads + 1),
                                         "TaskScheduler task threads");
 
   /* Initialize TLS for main thread. */
+  scheduler->task_threads[0].scheduler = scheduler;
+  scheduler->task_threads[0].id = 0;
   initialize_task_tls(&scheduler->task_threads[0].tls);
+  task_deque_init(&scheduler->task_threads[0].deque);
 
   pthread_key_create(&scheduler->tls_id_key, NULL);
 
@@ -508,12 +737,18 @@ TaskScheduler *BLI_task_scheduler_create(int num_threads)
     scheduler->num_threads = num_threads;
     scheduler->threads = MEM_callocN(sizeof(pthread_t) * num_threads, "TaskScheduler threads");
 
+    /* Threads steal from each other as soon as they are launched, so all the
+     * deques are initialized first. */
     for (i = 0; i < num_threads; i++) {
       TaskThread *thread = &scheduler->task_threads[i + 1];
       thread->scheduler = scheduler;
       thread->id = i + 1;
       initialize_task_tls(&thread->tls);
+      task_deque_init(&thread->deque);
+    }
 
+    for (i = 0; i < num_threads; i++) {
+      TaskThread *thread = &scheduler->task_threads[i + 1];
       if (pthread_create(&scheduler->threads[i], NULL, task_scheduler_thread_run, thread) != 0) {
         fprintf(stderr, "TaskScheduler failed to launch thread %d/%d\n", i, num_threads);
       }
@@ -564,6 +799,14 @@ void BLI_task_scheduler_free(TaskScheduler *scheduler)
     for (int i = 0; i < scheduler->num_threads + 1; i++) {
       TaskThreadLocalStorage *tls = &scheduler->task_threads[i].tls;
       free_task_tls(tls);
+
+      /* delete leftover tasks of the deque */
+      TaskDeque *deque = &scheduler->task_threads[i].deque;
+      for (int64_t j = deque->top; j < deque->bottom; j++) {
+        task = deque->tasks[j & (TASK_DEQUE_SIZE - 1)];
+        task_data_free(task, 0);
+        MEM_freeN(task);
+      }
     }
 
     MEM_freeN(scheduler->task_threads);
@@ -589,11 +832,9 @@ int BLI_task_scheduler_num_threads(TaskScheduler *scheduler)
   return scheduler->num_threads + 1;
 }
 
-static void task_scheduler_push(TaskScheduler *scheduler, Task *task, TaskPriority priority)
+/* Push a task to the global queue, the pool task counter must be incremented already. */
+static void task_scheduler_queue_push(TaskScheduler *scheduler, Task *task, TaskPriority priority)
 {
-  task_pool_num_increase(task->pool, 1);
-
-  /* add task to queue */
   BLI_mutex_lock(&scheduler->queue_mutex);
 
   if (priority == TASK_PRIORITY_HIGH) {
@@ -602,11 +843,49 @@ static void task_scheduler_push(TaskScheduler *scheduler, Task *task, TaskPriori
   else {
     BLI_addtail(&scheduler->queue, task);
   }
+  scheduler->num_queued++;
+
+  task_pool_notify_available(task->pool);
 
   BLI_condition_notify_one(&scheduler->queue_cond);
   BLI_mutex_unlock(&scheduler->queue_mutex);
 }
 
+static void task_scheduler_push(TaskScheduler *scheduler, Task *task, TaskPriority priority)
+{
+  TaskPool *pool = task->pool;
+
+  task_pool_num_increase(pool, 1);
+
+  /* Low priority tasks go to the deque of the pushing thread without any lock,
+   * the global queue keeps the high priority tasks which are looked up first. */
+  if (scheduler->use_deques && priority == TASK_PRIORITY_LOW) {
+    TaskThread *thread = task_scheduler_current_thread(scheduler);
+    if (thread != NULL) {
+      /* Counted before the task is visible, so the counter never underflows
+       * when a thief takes the task right away. In the worst case a thread
+       * waiting for the pool misses the task, but the deque owner or an idle
+       * thread will run it. */
+      atomic_add_and_fetch_z(&scheduler->num_deque_tasks, 1);
+      task_pool_notify_available(pool);
+
+      if (task_deque_push(&thread->deque, task)) {
+        /* Wake up a thread to steal the task, see task_scheduler_thread_wait_pop(). */
+        if (task_atomic_load_z(&scheduler->num_sleeping_threads) != 0) {
+          BLI_mutex_lock(&scheduler->queue_mutex);
+          BLI_condition_notify_one(&scheduler->queue_cond);
+          BLI_mutex_unlock(&scheduler->queue_mutex);
+        }
+        return;
+      }
+
+      atomic_sub_and_fetch_z(&scheduler->num_deque_tasks, 1);
+    }
+  }
+
+  task_scheduler_queue_push(scheduler, task, priority);
+}
+
 static void task_scheduler_push_all(TaskScheduler *scheduler,
                                     TaskPool *pool,
                                     Task **tasks,
@@ -623,6 +902,9 @@ static void task_scheduler_push_all(TaskScheduler *scheduler,
   for (int i = 0; i < num_tasks; i++) {
     BLI_addhead(&scheduler->queue, tasks[i]);
   }
+  scheduler->num_queued += num_tasks;
+
+  task_pool_notify_available(pool);
 
   BLI_condition_notify_all(&scheduler->queue_cond);
   BLI_mutex_unlock(&scheduler->queue_mutex);
@@ -642,6 +924,7 @@ static void task_scheduler_clear(TaskScheduler *scheduler, TaskPool *pool)
     if (task->pool == pool) {
       task_data_free(task, pool->thread_id);
       BLI_freelinkN(&scheduler->queue, task);
+      scheduler->num_queued--;
 
       done++;
     }
@@ -649,6 +932,27 @@ static void task_scheduler_clear(TaskScheduler *scheduler, TaskPool *pool)
 
   BLI_mutex_unlock(&scheduler->queue_mutex);
 
+  /* Free the tasks of this pool at the bottom of our own deque, tasks in the
+   * deques of other threads are discarded by the thread which takes them. */
+  if (scheduler->use_deques) {
+    TaskThread *thread = task_scheduler_current_thread(scheduler);
+    if (thread != NULL) {
+      while ((task = task_deque_pop(&thread->deque)) != NULL) {
+        atomic_sub_and_fetch_z(&scheduler->num_deque_tasks, 1);
+
+        /* Keep scanning, tasks of this pool can be below the tasks of other pools. */
+        if (task->pool != pool) {
+          task_scheduler_queue_push(scheduler, task, TASK_PRIORITY_LOW);
+          continue;
+        }
+
+        task_data_free(task, pool->thread_id);
+        MEM_freeN(task);
+        done++;
+      }
+    }
+  }
+
   /* notify done */
   task_pool_num_decrease(pool, done);
 }
@@ -677,6 +981,8 @@ static TaskPool *task_pool_create_ex(TaskScheduler *scheduler,
 
   pool->scheduler = scheduler;
   pool->num = 0;
+  pool->num_available = 0;
+  pool->num_waiting = 0;
   pool->do_cancel = false;
   pool->do_work = false;
   pool->is_suspended = is_suspended;
@@ -881,6 +1187,77 @@ void BLI_task_pool_push_from_thread(TaskPool *pool,
   task_pool_push(pool, run, taskdata, free_taskdata, NULL, priority, thread_id);
 }
 
+/* Free a task of another pool met while looking for work, if that pool is canceled
+ * the task is dropped instead of being queued again. Return true if the task was freed. */
+static bool task_pool_discard_canceled(Task *task, const int thread_id)
+{
+  TaskPool *pool = task->pool;
+  if (!pool->do_cancel) {
+    return false;
+  }
+
+  task_data_free(task, thread_id);
+  MEM_freeN(task);
+  task_pool_num_decrease(pool, 1);
+  return true;
+}
+
+/* Find a task of the pool for the thread waiting for it.
+ *
+ * The waiting thread must not run tasks of other pools, it could deadlock.
+ * Such tasks met in the thread's own deque or stolen from other threads are
+ * moved to the global queue where the other threads can pick them, or dropped
+ * if their pool is canceled.
+ */
+static Task *task_pool_find_task(TaskPool *pool, TaskThread *thread)
+{
+  TaskScheduler *scheduler = pool->scheduler;
+  Task *task;
+
+  if (thread != NULL) {
+    while ((task = task_deque_pop(&thread->deque)) != NULL) {
+      atomic_sub_and_fetch_z(&scheduler->num_deque_tasks, 1);
+      if (task->pool == pool) {
+        return task;
+      }
+      if (!task_pool_discard_canceled(task, pool->thread_id)) {
+        task_scheduler_queue_push(scheduler, task, TASK_PRIORITY_LOW);
+      }
+    }
+  }
+
+  if (scheduler->num_queued != 0) {
+    BLI_mutex_lock(&scheduler->queue_mutex);
+
+    for (task = scheduler->queue.first; task; task = task->next) {
+      if (task->pool == pool) {
+        BLI_remlink(&scheduler->queue, task);
+        scheduler->num_queued--;
+        break;
+      }
+    }
+
+    BLI_mutex_unlock(&scheduler->queue_mutex);
+
+    if (task != NULL) {
+      return task;
+    }
+  }
+
+  if (scheduler->use_deques) {
+    while ((task = task_scheduler_steal(scheduler, thread)) != NULL) {
+      if (task->pool == pool) {
+        return task;
+      }
+      if (!task_pool_discard_canceled(task, pool->thread_id)) {
+        task_scheduler_queue_push(scheduler, task, TASK_PRIORITY_LOW);
+      }
+    }
+  }
+
+  return NULL;
+}
+
 void BLI_task_pool_work_and_wait(TaskPool *pool)
 {
   TaskThreadLocalStorage *tls = get_task_tls(pool, pool->thread_id);
@@ -892,6 +1269,7 @@ void BLI_task_pool_work_and_wait(TaskPool *pool)
       BLI_mutex_lock(&scheduler->queue_mutex);
 
       BLI_movelisttolist(&scheduler->queue, &pool->suspended_queue);
+      scheduler->num_queued += pool->num_suspended;
 
       BLI_condition_notify_all(&scheduler->queue_cond);
       BLI_mutex_unlock(&scheduler->queue_mutex);
@@ -906,57 +1284,52 @@ void BLI_task_pool_work_and_wait(TaskPool *pool)
 
   handle_local_queue(tls, pool->thread_id);
 
-  BLI_mutex_lock(&pool->num_mutex);
-
-  while (pool->num != 0) {
-    Task *task, *work_task = NULL;
-    bool found_task = false;
+  TaskThread *thread = (scheduler->use_deques && !pool->use_local_tls) ?
+                           task_scheduler_current_thread(scheduler) :
+                           NULL;
 
-    BLI_mutex_unlock(&pool->num_mutex);
-
-    BLI_mutex_lock(&scheduler->queue_mutex);
+  while (task_atomic_load_z(&pool->num) != 0) {
+    /* Read before looking for tasks, so we don't sleep if tasks are pushed meanwhile. */
+    const size_t num_available = task_atomic_load_z(&pool->num_available);
 
     /* find task from this pool. if we get a task from another pool,
      * we can get into deadlock */
-
-    for (task = scheduler->queue.first; task; task = task->next) {
-      if (task->pool == pool) {
-        work_task = task;
-        found_task = true;
-        BLI_remlink(&scheduler->queue, task);
-        break;
-      }
-    }
-
-    BLI_mutex_unlock(&scheduler->queue_mutex);
+    Task *work_task = task_pool_find_task(pool, thread);
 
     /* if found task, do it, otherwise wait until other tasks are done */
-    if (found_task) {
-      /* run task */
-      BLI_assert(!tls->do_delayed_push);
-      work_task->run(pool, work_task->taskdata, pool->thread_id);
-      BLI_assert(!tls->do_delayed_push);
+    if (work_task != NULL) {
+      if (!pool->do_cancel) {
+        /* run task */
+        BLI_assert(!tls->do_delayed_push);
+        work_task->run(pool, work_task->taskdata, pool->thread_id);
+        BLI_assert(!tls->do_delayed_push);
+      }
 
       /* delete task */
-      task_free(pool, task, pool->thread_id);
+      task_free(pool, work_task, pool->thread_id);
 
       /* Handle all tasks from local queue. */
       handle_local_queue(tls, pool->thread_id);
 
       /* notify pool task was done */
       task_pool_num_decrease(pool, 1);
+      continue;
     }
 
     BLI_mutex_lock(&pool->num_mutex);
-    if (pool->num == 0) {
-      break;
-    }
+    atomic_add_and_fetch_z(&pool->num_waiting, 1);
 
-    if (!found_task) {
+    if (task_atomic_load_z(&pool->num) != 0 &&
+        task_atomic_load_z(&pool->num_available) == num_available) {
       BLI_condition_wait(&pool->num_cond, &pool->num_mutex);
     }
+
+    atomic_sub_and_fetch_z(&pool->num_waiting, 1);
+    BLI_mutex_unlock(&pool->num_mutex);
   }
 
+  /* Wait for the thread which did the last task to release the pool. */
+  BLI_mutex_lock(&pool->num_mutex);
   BLI_mutex_unlock(&pool->num_mutex);
 
   BLI_assert(tls->num_local_queue == 0);
@@ -978,7 +1351,7 @@ void BLI_task_pool_cancel(TaskPool *pool)
 
   /* wait until all entries are cleared */
   BLI_mutex_lock(&pool->num_mutex);
-  while (pool->num) {
+  while (task_atomic_load_z(&pool->num) != 0) {
     BLI_condition_wait(&pool->num_cond, &pool->num_mutex);
   }
   BLI_mutex_unlock(&pool->num_mutex);
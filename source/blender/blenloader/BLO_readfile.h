@@ -120,6 +120,7 @@ void BLO_blendhandle_close(BlendHandle *bh);
 #define BLO_EMBEDDED_STARTUP_BLEND "<startup.blend>"
 
 bool BLO_has_bfile_extension(const char *str);
+bool BLO_has_bfile_header(const char *header, int len);
 bool BLO_library_path_explode(const char *path, char *r_dir, char **r_group, char **r_name);
 
 /* Options controlling behavior of append/link code.
@@ -153,7 +154,7 @@ void *BLO_library_read_struct(struct FileData *fd, struct BHead *bh, const char
 
 BlendFileData *blo_read_blendafterruntime(int file,
                                           const char *name,
-                                          int actualsize,
+                                          size_t actualsize,
                                           struct ReportList *reports);
 
 /* internal function but we need to expose it */
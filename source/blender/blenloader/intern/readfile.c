@@ -33,13 +33,22 @@
 
 #include "BLI_utildefines.h"
 #ifndef WIN32
-#  include <unistd.h>  // for read close
+#  include <unistd.h>    // for read close
+#  include <sys/mman.h>  // for mmap
 #else
 #  include <io.h>  // for open close read
 #  include "winsock2.h"
 #  include "BLI_winstuff.h"
 #endif
 
+#ifdef WITH_LZO
+#  ifdef WITH_SYSTEM_LZO
+#    include <lzo/lzo1x.h>
+#  else
+#    include "minilzo.h"
+#  endif
+#endif
+
 /* allow readfile to use deprecated functionality */
 #define DNA_DEPRECATED_ALLOW
 
@@ -105,6 +114,7 @@
 #include "BLI_math.h"
 #include "BLI_threads.h"
 #include "BLI_mempool.h"
+#include "BLI_task.h"
 #include "BLI_ghash.h"
 
 #include "BLT_translation.h"
@@ -253,6 +263,7 @@
 /* local prototypes */
 static void read_libraries(FileData *basefd, ListBase *mainlist);
 static void *read_struct(FileData *fd, BHead *bh, const char *blockname);
+static void read_data_prepared_free(FileData *fd);
 static void direct_link_modifiers(FileData *fd, ListBase *lb, Object *ob);
 static BHead *find_bhead_from_code_name(FileData *fd, const short idcode, const char *name);
 static BHead *find_bhead_from_idname(FileData *fd, const char *idname);
@@ -977,6 +988,10 @@ static bool blo_bhead_read_data(FileData *fd, BHead *thisblock, void *buf)
   bool success = true;
   BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
   BLI_assert(new_bhead->has_data == false && new_bhead->file_offset != 0);
+  if (fd->mmap_buffer) {
+    memcpy(buf, fd->mmap_buffer + new_bhead->file_offset, new_bhead->bhead.len);
+    return true;
+  }
   off64_t offset_backup = fd->file_offset;
   if (UNLIKELY(fd->seek(fd, new_bhead->file_offset, SEEK_SET) == -1)) {
     success = false;
@@ -1005,6 +1020,24 @@ static BHead *blo_bhead_read_full(FileData *fd, BHead *thisblock)
   }
   return &new_bhead_data->bhead;
 }
+
+/**
+ * Data of a block which wasn't read, referenced in the mapped file.
+ * \return NULL when the file isn't mapped or the data isn't aligned enough to be used in place.
+ */
+static const void *blo_bhead_data_mapped(const FileData *fd, const BHead *thisblock)
+{
+  const BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
+  BLI_assert(new_bhead->has_data == false);
+  if (fd->mmap_buffer == NULL) {
+    return NULL;
+  }
+  const char *data = fd->mmap_buffer + new_bhead->file_offset;
+  if (((uintptr_t)data & (sizeof(void *) - 1)) != 0) {
+    return NULL;
+  }
+  return data;
+}
 #endif /* USE_BHEAD_READ_ON_DEMAND */
 
 /* Warning! Caller's responsibility to ensure given bhead **is** and ID one! */
@@ -1200,6 +1233,275 @@ static int fd_read_from_memory(FileData *filedata, void *buffer, uint size)
   return (readsize);
 }
 
+/* Memory mapped file reading. */
+
+static int fd_read_from_mmap(FileData *filedata, void *buffer, uint size)
+{
+  /* don't read more bytes then there are available in the mapping */
+  int readsize = (int)MIN2((size_t)size, filedata->mmap_size - (size_t)filedata->file_offset);
+
+  memcpy(buffer, filedata->mmap_buffer + filedata->file_offset, readsize);
+  filedata->file_offset += readsize;
+
+  return (readsize);
+}
+
+static off64_t fd_seek_from_mmap(FileData *filedata, off64_t offset, int whence)
+{
+  off64_t new_pos;
+  if (whence == SEEK_CUR) {
+    new_pos = filedata->file_offset + offset;
+  }
+  else if (whence == SEEK_SET) {
+    new_pos = offset;
+  }
+  else if (whence == SEEK_END) {
+    new_pos = (off64_t)filedata->mmap_size + offset;
+  }
+  else {
+    return -1;
+  }
+
+  if (new_pos < 0 || new_pos > (off64_t)filedata->mmap_size) {
+    return -1;
+  }
+  filedata->file_offset = new_pos;
+  return new_pos;
+}
+
+/**
+ * Map \a size bytes of \a file from \a offset, the blocks are then read from the mapping and
+ * the data read on demand is decoded in place, without reading it in an intermediate buffer.
+ *
+ * \return False when the file can't be mapped, it must be read regularly then.
+ */
+static bool fd_mmap_file(FileData *filedata, int file, off64_t offset, size_t size)
+{
+#ifdef WIN32
+  UNUSED_VARS(filedata, file, offset, size);
+  return false;
+#else
+  if (size == 0 || size == (size_t)-1) {
+    return false;
+  }
+
+  /* The offset of a mapping must be a multiple of the page size. */
+  const off64_t page_size = (off64_t)sysconf(_SC_PAGESIZE);
+  const off64_t map_offset = offset - (offset % page_size);
+  const size_t map_size = size + (size_t)(offset - map_offset);
+
+  /* Private mapping so the file is never modified, the data is only read anyway. */
+  void *map = mmap(NULL, map_size, PROT_READ, MAP_PRIVATE, file, map_offset);
+  if (map == MAP_FAILED) {
+    return false;
+  }
+
+  filedata->mmap_map = map;
+  filedata->mmap_map_size = map_size;
+  filedata->mmap_buffer = (const char *)map + (offset - map_offset);
+  filedata->mmap_size = size;
+  filedata->file_offset = 0;
+
+  filedata->read = fd_read_from_mmap;
+  filedata->seek = fd_seek_from_mmap;
+
+  return true;
+#endif
+}
+
+static void fd_munmap_file(FileData *filedata)
+{
+#ifndef WIN32
+  if (filedata->mmap_map) {
+    munmap(filedata->mmap_map, filedata->mmap_map_size);
+  }
+#endif
+  filedata->mmap_map = NULL;
+  filedata->mmap_buffer = NULL;
+  filedata->mmap_size = 0;
+}
+
+/* Chunked compressed file reading, see #BlendChunksHeader. */
+
+typedef struct ReadChunksData {
+  const BlendChunksHeader *header;
+  const BlendChunk *chunks;
+  const char *file_data;
+  char *buffer;
+  /** Decompressed size of each chunk, zero on error. */
+  size_t *chunk_sizes;
+} ReadChunksData;
+
+static void read_chunk_cb(void *__restrict userdata,
+                          const int index,
+                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ReadChunksData *data = userdata;
+  const BlendChunk *chunk = &data->chunks[index];
+  const uint64_t offset = (uint64_t)index * data->header->chunk_size;
+  const size_t size = (size_t)MIN2((uint64_t)data->header->chunk_size,
+                                   data->header->size - offset);
+  const char *src = data->file_data + chunk->offset;
+  char *dst = data->buffer + offset;
+
+  data->chunk_sizes[index] = 0;
+
+  if (chunk->size == size) {
+    memcpy(dst, src, size);
+    data->chunk_sizes[index] = size;
+  }
+#ifdef WITH_LZO
+  else {
+    lzo_uint dst_len = size;
+    if (lzo1x_decompress_safe(
+            (const uchar *)src, (lzo_uint)chunk->size, (uchar *)dst, &dst_len, NULL) ==
+        LZO_E_OK) {
+      data->chunk_sizes[index] = dst_len;
+    }
+  }
+#endif
+}
+
+static bool read_chunks_header(const char *file_data,
+                               size_t file_size,
+                               BlendChunksHeader *r_header,
+                               BlendChunk **r_chunks)
+{
+  if (file_size < sizeof(*r_header)) {
+    return false;
+  }
+
+  BlendChunksHeader header;
+  memcpy(&header, file_data, sizeof(header));
+  if (ENDIAN_ORDER == B_ENDIAN) {
+    BLI_endian_switch_uint32(&header.chunk_size);
+    BLI_endian_switch_uint32(&header.chunk_count);
+    BLI_endian_switch_uint64(&header.size);
+    BLI_endian_switch_uint64(&header.index_offset);
+  }
+
+  if (memcmp(header.magic, BLEND_CHUNKS_MAGIC, sizeof(BLEND_CHUNKS_MAGIC) - 1) != 0 ||
+      header.magic[7] != BLEND_CHUNKS_VERSION || header.chunk_size == 0 || header.size == 0 ||
+      (uint64_t)(size_t)header.size != header.size ||
+      header.chunk_count != (header.size + header.chunk_size - 1) / header.chunk_size ||
+      header.index_offset > file_size ||
+      header.chunk_count > (file_size - header.index_offset) / sizeof(BlendChunk)) {
+    return false;
+  }
+
+  /* The index isn't aligned in the file. */
+  BlendChunk *chunks = MEM_malloc_arrayN(header.chunk_count, sizeof(*chunks), __func__);
+  memcpy(chunks, file_data + header.index_offset, header.chunk_count * sizeof(*chunks));
+
+  for (uint i = 0; i < header.chunk_count; i++) {
+    if (ENDIAN_ORDER == B_ENDIAN) {
+      BLI_endian_switch_uint64(&chunks[i].offset);
+      BLI_endian_switch_uint32(&chunks[i].size);
+    }
+    if (chunks[i].offset > file_size || chunks[i].size > file_size - chunks[i].offset) {
+      MEM_freeN(chunks);
+      return false;
+    }
+  }
+
+  *r_header = header;
+  *r_chunks = chunks;
+  return true;
+}
+
+/**
+ * Decompress the chunked file of \a size bytes from \a offset of \a file, the chunks are
+ * decompressed in parallel. The blend-file is then read from memory like a mapped file.
+ */
+static bool fd_read_chunks(FileData *filedata, int file, off64_t offset, size_t size)
+{
+  if (size == 0 || size == (size_t)-1) {
+    return false;
+  }
+
+  const char *file_data;
+  char *file_buffer = NULL;
+  if (fd_mmap_file(filedata, file, offset, size)) {
+    file_data = filedata->mmap_buffer;
+  }
+  else {
+    file_buffer = MEM_mallocN(size, __func__);
+    size_t read_len = 0;
+    if (lseek(file, offset, SEEK_SET) != -1) {
+      while (read_len < size) {
+        const int len = read(file, file_buffer + read_len, (uint)MIN2(size - read_len, INT_MAX));
+        if (len <= 0) {
+          break;
+        }
+        read_len += (size_t)len;
+      }
+    }
+    if (read_len != size) {
+      MEM_freeN(file_buffer);
+      return false;
+    }
+    file_data = file_buffer;
+  }
+
+  BlendChunksHeader header;
+  BlendChunk *chunks;
+  char *buffer = NULL;
+  bool success = read_chunks_header(file_data, size, &header, &chunks);
+
+  if (success) {
+    buffer = MEM_mallocN((size_t)header.size, "blend chunks");
+    size_t *chunk_sizes = MEM_malloc_arrayN(header.chunk_count, sizeof(size_t), __func__);
+
+    ReadChunksData data = {
+        .header = &header,
+        .chunks = chunks,
+        .file_data = file_data,
+        .buffer = buffer,
+        .chunk_sizes = chunk_sizes,
+    };
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.scheduling_mode = TASK_SCHEDULING_DYNAMIC;
+    BLI_task_parallel_range(0, (int)header.chunk_count, &data, read_chunk_cb, &settings);
+
+    for (uint i = 0; i < header.chunk_count; i++) {
+      const uint64_t chunk_offset = (uint64_t)i * header.chunk_size;
+      if (chunk_sizes[i] != MIN2((uint64_t)header.chunk_size, header.size - chunk_offset)) {
+        success = false;
+        break;
+      }
+    }
+
+    MEM_freeN(chunk_sizes);
+    MEM_freeN(chunks);
+  }
+
+  /* The compressed data isn't needed anymore. */
+  fd_munmap_file(filedata);
+  if (file_buffer) {
+    MEM_freeN(file_buffer);
+  }
+
+  if (!success) {
+    if (buffer) {
+      MEM_freeN(buffer);
+    }
+    return false;
+  }
+
+  /* Owned by the file data. */
+  filedata->buffer = buffer;
+  filedata->mmap_buffer = buffer;
+  filedata->mmap_size = (size_t)header.size;
+  filedata->file_offset = 0;
+
+  filedata->read = fd_read_from_mmap;
+  filedata->seek = fd_seek_from_mmap;
+
+  return true;
+}
+
 /* MemFile reading. */
 
 static int fd_read_from_memfile(FileData *filedata, void *buffer, uint size)
@@ -1341,6 +1643,14 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
       seek_fn = fd_seek_data_from_file;
     }
 
+    /* Chunked compressed file, decompressed once the file data is created. */
+    const bool is_chunks = (read_fn == NULL) &&
+                           (memcmp(header, BLEND_CHUNKS_MAGIC, sizeof(header)) == 0);
+    if (is_chunks) {
+      read_fn = fd_read_from_mmap;
+      seek_fn = fd_seek_from_mmap;
+    }
+
     /* Gzip file. */
     errno = 0;
     if ((read_fn == NULL) &&
@@ -1376,6 +1686,24 @@ static FileData *blo_filedata_from_file_descriptor(const char *filepath,
     fd->read = read_fn;
     fd->seek = seek_fn;
 
+    if (is_chunks) {
+      if (!fd_read_chunks(fd, file, 0, BLI_file_descriptor_size(file))) {
+        BKE_reportf(reports,
+                    RPT_WARNING,
+                    "Unable to read '%s': %s",
+                    filepath,
+                    TIP_("corrupted or unsupported compressed chunks"));
+        /* Caller must close. */
+        fd->filedes = -1;
+        blo_filedata_free(fd);
+        return NULL;
+      }
+    }
+    /* Uncompressed files are mapped when possible, see #fd_mmap_file. */
+    else if (read_fn == fd_read_data_from_file) {
+      fd_mmap_file(fd, file, 0, BLI_file_descriptor_size(file));
+    }
+
     return fd;
 #ifdef WITH_GAMEENGINE_BPPLAYER
   }
@@ -1553,6 +1881,8 @@ void blo_filedata_free(FileData *fd)
       fd->buffer = NULL;
     }
 
+    fd_munmap_file(fd);
+
     /* Free all BHeadN data blocks */
 #ifndef NDEBUG
     BLI_freelistN(&fd->bhead_list);
@@ -1573,6 +1903,7 @@ void blo_filedata_free(FileData *fd)
       MEM_freeN((void *)fd->compflags);
     }
 
+    read_data_prepared_free(fd);
     if (fd->datamap) {
       oldnewmap_free(fd->datamap);
     }
@@ -1630,6 +1961,23 @@ bool BLO_has_bfile_extension(const char *str)
   return BLI_path_extension_check_array(str, ext_test);
 }
 
+/**
+ * Check whether the first bytes of a file are those of a blend-file, either uncompressed or in the
+ * chunked container (gzip files must be read through gzip).
+ *
+ * \param header: The first bytes of the file.
+ * \param len: The number of bytes of \a header.
+ * \return true if the file can be read as a blend-file.
+ */
+bool BLO_has_bfile_header(const char *header, int len)
+{
+  if (len < 7) {
+    return false;
+  }
+  return STREQLEN(header, "BLENDER", 7) ||
+         (memcmp(header, BLEND_CHUNKS_MAGIC, sizeof(BLEND_CHUNKS_MAGIC) - 1) == 0);
+}
+
 /**
  * Try to explode given path into its 'library components'
  * (i.e. a .blend file, id type/group, and data-block itself).
@@ -2263,17 +2611,23 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
 
     if (fd->compflags[bh->SDNAnr] != SDNA_CMP_REMOVED) {
       if (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
+        const void *data = (bh + 1);
 #ifdef USE_BHEAD_READ_ON_DEMAND
         if (BHEADN_FROM_BHEAD(bh)->has_data == false) {
-          bh = blo_bhead_read_full(fd, bh);
-          if (UNLIKELY(bh == NULL)) {
-            fd->flags &= ~FD_FLAGS_FILE_OK;
-            return NULL;
+          /* Reconstruct from the mapped file when possible, it's only read. */
+          data = blo_bhead_data_mapped(fd, bh);
+          if (data == NULL) {
+            bh = blo_bhead_read_full(fd, bh);
+            if (UNLIKELY(bh == NULL)) {
+              fd->flags &= ~FD_FLAGS_FILE_OK;
+              return NULL;
+            }
+            data = (bh + 1);
           }
         }
 #endif
         temp = DNA_struct_reconstruct(
-            fd->memsdna, fd->filesdna, fd->compflags, bh->SDNAnr, bh->nr, (bh + 1));
+            fd->memsdna, fd->filesdna, fd->compflags, bh->SDNAnr, bh->nr, data);
       }
       else {
         /* SDNA_CMP_EQUAL */
@@ -9197,10 +9551,166 @@ static const char *dataname(short id_code)
   return "Data from Lib Block";
 }
 
+/* Reconstruct the data blocks of the IDs with multiple threads from this total size. */
+#define READ_DATA_THREADED_MIN_SIZE (1 << 20)
+
+typedef struct ReadDataPrepared {
+  BHead *bhead_id;
+  /** The DATA blocks following the ID, in file order. */
+  BHead **bheads;
+  int tot_data;
+  /** Filled by a single thread, merged into #FileData.datamap when the ID is read. */
+  OldNewMap *datamap;
+} ReadDataPrepared;
+
+typedef struct ReadDataThreadedData {
+  FileData *fd;
+  ReadDataPrepared *prepared;
+} ReadDataThreadedData;
+
+/* Blocks read with #read_libblock and followed by their data, see #blo_read_file_internal. */
+static bool read_data_bhead_is_id(const BHead *bhead)
+{
+  return !ELEM(bhead->code, DATA, DNA1, TEST, REND, GLOB, USER, ENDB, ID_LINK_PLACEHOLDER);
+}
+
+static void read_data_threaded_cb(void *__restrict userdata,
+                                  const int index,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ReadDataThreadedData *data = userdata;
+  ReadDataPrepared *prepared = &data->prepared[index];
+  const short idcode = (prepared->bhead_id->code == ID_SCRN) ? ID_SCR :
+                                                                 prepared->bhead_id->code;
+  const char *allocname = dataname(idcode);
+
+  prepared->datamap = oldnewmap_new();
+  for (int i = 0; i < prepared->tot_data; i++) {
+    BHead *bhead = prepared->bheads[i];
+    void *newp = read_struct(data->fd, bhead, allocname);
+    if (newp) {
+      oldnewmap_insert(prepared->datamap, bhead->old, newp, 0);
+    }
+  }
+}
+
+/**
+ * Read the data of all the IDs of the file ahead of #read_libblock, in three passes:
+ * - A serial pass indexes the data blocks of every ID.
+ * - The IDs are read in parallel, each one into its own #OldNewMap.
+ * - #read_data_into_oldnewmap merges the map of each ID into #FileData.datamap when the ID is
+ *   read, serially and in file order, so pointer remapping doesn't depend on threads.
+ */
+static void read_data_prepare_threaded(FileData *fd)
+{
+  /* Reading the blocks on demand seeks in the file, unless it's mapped. */
+  if (fd->seek != NULL && fd->mmap_buffer == NULL) {
+    return;
+  }
+
+  int tot_ids = 0;
+  int tot_data = 0;
+  size_t tot_size = 0;
+  for (BHead *bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
+    if (bhead->code == ENDB) {
+      break;
+    }
+    if (bhead->code == DATA) {
+      tot_data++;
+      tot_size += (size_t)bhead->len;
+    }
+    else if (read_data_bhead_is_id(bhead)) {
+      tot_ids++;
+    }
+  }
+
+  if (tot_ids < 2 || tot_size < READ_DATA_THREADED_MIN_SIZE) {
+    return;
+  }
+
+  ReadDataPrepared *prepared = MEM_calloc_arrayN(tot_ids, sizeof(*prepared), __func__);
+  BHead **bheads = MEM_malloc_arrayN(tot_data, sizeof(*bheads), __func__);
+  int tot_prepared = 0;
+  int data_index = 0;
+
+  /* Only the data following an ID is read with it, the other blocks own theirs. */
+  ReadDataPrepared *current = NULL;
+  for (BHead *bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
+    if (bhead->code == ENDB) {
+      break;
+    }
+    if (bhead->code == DATA) {
+      if (current) {
+        bheads[data_index++] = bhead;
+        current->tot_data++;
+      }
+    }
+    else if (read_data_bhead_is_id(bhead)) {
+      current = &prepared[tot_prepared++];
+      current->bhead_id = bhead;
+      current->bheads = &bheads[data_index];
+    }
+    else {
+      current = NULL;
+    }
+  }
+
+  ReadDataThreadedData userdata = {
+      .fd = fd,
+      .prepared = prepared,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.scheduling_mode = TASK_SCHEDULING_DYNAMIC;
+  BLI_task_parallel_range(0, tot_prepared, &userdata, read_data_threaded_cb, &settings);
+
+  fd->datamap_prepared = BLI_ghash_ptr_new_ex(__func__, (uint)tot_prepared);
+  for (int i = 0; i < tot_prepared; i++) {
+    BLI_ghash_insert(fd->datamap_prepared, prepared[i].bhead_id, prepared[i].datamap);
+  }
+
+  MEM_freeN(prepared);
+  MEM_freeN(bheads);
+}
+
+/* Free the data of the IDs read ahead but never merged, e.g. of unknown types. */
+static void read_data_prepared_free(FileData *fd)
+{
+  if (fd->datamap_prepared == NULL) {
+    return;
+  }
+
+  GHashIterator gh_iter;
+  GHASH_ITER (gh_iter, fd->datamap_prepared) {
+    OldNewMap *onm = BLI_ghashIterator_getValue(&gh_iter);
+    oldnewmap_free_unused(onm);
+    oldnewmap_free(onm);
+  }
+  BLI_ghash_free(fd->datamap_prepared, NULL, NULL);
+  fd->datamap_prepared = NULL;
+}
+
 static BHead *read_data_into_oldnewmap(FileData *fd, BHead *bhead, const char *allocname)
 {
+  /* The data was read ahead, see #read_data_prepare_threaded. */
+  OldNewMap *onm = fd->datamap_prepared ? BLI_ghash_popkey(fd->datamap_prepared, bhead, NULL) :
+                                          NULL;
+
   bhead = blo_bhead_next(fd, bhead);
 
+  if (onm) {
+    for (int i = 0; i < onm->nentries; i++) {
+      oldnewmap_insert(fd->datamap, onm->entries[i].oldp, onm->entries[i].newp, 0);
+    }
+    oldnewmap_free(onm);
+
+    while (bhead && bhead->code == DATA) {
+      bhead = blo_bhead_next(fd, bhead);
+    }
+    return bhead;
+  }
+
   while (bhead && bhead->code == DATA) {
     void *data;
 #if 0
@@ -9983,6 +10493,11 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     }
   }
 
+  /* Undo keeps some IDs of the previous state, their data must not be read. */
+  if ((fd->skip_flags & BLO_READ_SKIP_DATA) == 0 && fd->memfile == NULL) {
+    read_data_prepare_threaded(fd);
+  }
+
   while (bhead) {
     switch (bhead->code) {
       case DATA:
@@ -10034,6 +10549,8 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     }
   }
 
+  read_data_prepared_free(fd);
+
   /* do before read_libraries, but skip undo case */
   if (fd->memfile == NULL) {
     if ((fd->skip_flags & BLO_READ_SKIP_DATA) == 0) {
@@ -11757,6 +12274,10 @@ static Main *library_link_begin(Main *mainvar, FileData **fd, const char *filepa
 
   (*fd)->mainlist = MEM_callocN(sizeof(ListBase), "FileData.mainlist");
 
+  /* The same handle can be linked from several times, the IDs linked the previous times belong
+   * to other mains and must not be found by this link. */
+  oldnewmap_clear((*fd)->libmap);
+
   /* clear for objects and collections instantiating tag */
   BKE_main_id_tag_listbase(&(mainvar->objects), LIB_TAG_DOIT, false);
   BKE_main_id_tag_listbase(&(mainvar->collections), LIB_TAG_DOIT, false);
@@ -11771,7 +12292,9 @@ static Main *library_link_begin(Main *mainvar, FileData **fd, const char *filepa
   mainl->versionfile = (*fd)->fileversion;
   read_file_version(*fd, mainl);
 #ifdef USE_GHASH_BHEAD
-  read_file_bhead_idname_map_create(*fd);
+  if ((*fd)->bhead_idname_hash == NULL) {
+    read_file_bhead_idname_map_create(*fd);
+  }
 #endif
 
   return mainl;
@@ -11924,6 +12447,7 @@ static void library_link_end(Main *mainl,
  * Finalize linking from a given .blend file (library).
  * Optionally instance the indirect object/collection in the scene when the flags are set.
  * \note Do not use \a bh after calling this function, it may frees it.
+ * When it isn't freed, \a bh is kept and can be linked from again with #BLO_library_link_begin.
  *
  * \param mainl: The main database to link from (not the active one).
  * \param bh: The blender file handle (WARNING! may be freed by this function!).
@@ -12280,15 +12804,34 @@ static int fd_read_from_file(FileData *filedata, void *buffer, unsigned int size
 
 BlendFileData *blo_read_blendafterruntime(int file,
                                           const char *name,
-                                          int actualsize,
+                                          size_t actualsize,
                                           ReportList *reports)
 {
   BlendFileData *bfd = NULL;
   FileData *fd = filedata_new();
   fd->filedes = file;
-  fd->buffersize = actualsize;
   fd->read = fd_read_from_file;
 
+  /* The blend data starts at the current position, after the executable. */
+  const off64_t offset = lseek(file, 0, SEEK_CUR);
+  char header[7];
+  if (read(file, header, sizeof(header)) == sizeof(header) &&
+      memcmp(header, BLEND_CHUNKS_MAGIC, sizeof(header)) == 0) {
+    if (!fd_read_chunks(fd, file, offset, actualsize)) {
+      BKE_reportf(reports,
+                  RPT_ERROR,
+                  "Unable to read '%s': %s",
+                  name,
+                  TIP_("corrupted or unsupported compressed chunks"));
+      blo_filedata_free(fd);
+      return NULL;
+    }
+  }
+  else {
+    lseek(file, offset, SEEK_SET);
+    fd_mmap_file(fd, file, offset, actualsize);
+  }
+
   /* needed for library_append and read_libraries */
   BLI_strncpy(fd->relabase, name, sizeof(fd->relabase));
 
@@ -77,6 +77,14 @@ typedef struct FileData {
   /** Variables needed for reading from memfile (undo). */
   struct MemFile *memfile;
 
+  /** Variables needed for reading from a memory mapped file,
+   * or from the decompressed #buffer of a chunked file. */
+  const char *mmap_buffer;
+  size_t mmap_size;
+  /** The mapping itself, starting at a page boundary before #mmap_buffer. */
+  void *mmap_map;
+  size_t mmap_map_size;
+
   /** Variables needed for reading from file. */
   gzFile gzfiledes;
   /** Gzip stream for memory decompression. */
@@ -101,6 +109,8 @@ typedef struct FileData {
   eBLOReadSkip skip_flags;
 
   struct OldNewMap *datamap;
+  /** Data maps of the IDs read ahead in parallel, by ID #BHead, merged into #datamap. */
+  struct GHash *datamap_prepared;
   struct OldNewMap *globmap;
   struct OldNewMap *libmap;
   struct OldNewMap *imamap;
@@ -124,6 +134,36 @@ typedef struct FileData {
 
 #define SIZEOFBLENDERHEADER 12
 
+/**
+ * Chunked compressed container of a blend-file, written with #G_FILE_COMPRESS_CHUNKED.
+ *
+ * The blend-file is split into chunks of #BlendChunksHeader.chunk_size bytes compressed
+ * independently with LZO, so they can be decompressed in parallel and the blend-file be read
+ * with seeking. A chunk which isn't smaller once compressed is stored as is.
+ * The layout is the header, the chunks and then the index of the chunks, all little endian.
+ */
+#define BLEND_CHUNKS_MAGIC "BLENDLZ"
+#define BLEND_CHUNKS_VERSION 1
+#define BLEND_CHUNKS_SIZE (1 << 20)
+
+typedef struct BlendChunksHeader {
+  /** #BLEND_CHUNKS_MAGIC followed by #BLEND_CHUNKS_VERSION. */
+  char magic[8];
+  uint32_t chunk_size;
+  uint32_t chunk_count;
+  /** Size of the uncompressed blend-file. */
+  uint64_t size;
+  /** Offset of the array of #BlendChunk. */
+  uint64_t index_offset;
+} BlendChunksHeader;
+
+typedef struct BlendChunk {
+  uint64_t offset;
+  /** Size in the file, the chunk isn't compressed when equal to its uncompressed size. */
+  uint32_t size;
+  uint32_t _pad;
+} BlendChunk;
+
 /***/
 struct Main;
 void blo_join_main(ListBase *mainlist);
@@ -90,6 +90,14 @@
 
 #include "BLI_utildefines.h"
 
+#ifdef WITH_LZO
+#  ifdef WITH_SYSTEM_LZO
+#    include <lzo/lzo1x.h>
+#  else
+#    include "minilzo.h"
+#  endif
+#endif
+
 /* allow writefile to use deprecated functionality (for forward compatibility code) */
 #define DNA_DEPRECATED_ALLOW
 
@@ -149,6 +157,7 @@
 #include "MEM_guardedalloc.h"  // MEM_freeN
 #include "BLI_bitmap.h"
 #include "BLI_blenlib.h"
+#include "BLI_endian_switch.h"
 #include "BLI_mempool.h"
 
 #include "BKE_action.h"
@@ -205,6 +214,7 @@
 typedef enum {
   WW_WRAP_NONE = 1,
   WW_WRAP_ZLIB,
+  WW_WRAP_CHUNKS,
 } eWriteWrapType;
 
 typedef struct WriteWrap WriteWrap;
@@ -221,6 +231,7 @@ struct WriteWrap {
   union {
     int file_handle;
     gzFile gz_handle;
+    struct WriteWrapChunks *chunks_handle;
   } _user_data;
 };
 
@@ -278,6 +289,163 @@ static size_t ww_write_zlib(WriteWrap *ww, const char *buf, size_t buf_len)
 }
 #undef FILE_HANDLE
 
+/* chunks, see #BlendChunksHeader */
+#ifdef WITH_LZO
+#  define FILE_HANDLE(ww) (ww)->_user_data.chunks_handle
+
+#  define LZO_OUT_LEN(size) ((size) + (size) / 16 + 64 + 3)
+
+typedef struct WriteWrapChunks {
+  int file_handle;
+  uint64_t file_offset;
+  bool error;
+
+  /** The chunk being filled. */
+  char *buf;
+  uint buf_used_len;
+  /** Compressed chunk and LZO working memory. */
+  char *buf_compress;
+  void *work_mem;
+
+  BlendChunk *chunks;
+  uint chunks_len;
+  uint chunks_alloc;
+  /** Size of the uncompressed blend-file. */
+  uint64_t size;
+} WriteWrapChunks;
+
+static void ww_chunks_write_raw(WriteWrapChunks *wc, const char *buf, size_t buf_len)
+{
+  size_t written = 0;
+  while (!wc->error && written < buf_len) {
+    const int len = write(wc->file_handle, buf + written, (uint)MIN2(buf_len - written, INT_MAX));
+    if (len <= 0) {
+      wc->error = true;
+      break;
+    }
+    written += (size_t)len;
+  }
+  wc->file_offset += written;
+}
+
+static void ww_chunks_flush(WriteWrapChunks *wc)
+{
+  if (wc->buf_used_len == 0) {
+    return;
+  }
+
+  lzo_uint out_len = LZO_OUT_LEN(BLEND_CHUNKS_SIZE);
+  const int r = lzo1x_1_compress((const uchar *)wc->buf,
+                                 (lzo_uint)wc->buf_used_len,
+                                 (uchar *)wc->buf_compress,
+                                 &out_len,
+                                 wc->work_mem);
+
+  /* Store the chunk as is when compressing doesn't help. */
+  const bool use_compress = (r == LZO_E_OK) && (out_len < wc->buf_used_len);
+  const char *data = use_compress ? wc->buf_compress : wc->buf;
+  const uint data_len = use_compress ? (uint)out_len : wc->buf_used_len;
+
+  if (wc->chunks_len == wc->chunks_alloc) {
+    wc->chunks_alloc = MAX2(wc->chunks_alloc * 2, 64);
+    wc->chunks = MEM_reallocN(wc->chunks, sizeof(*wc->chunks) * wc->chunks_alloc);
+  }
+  BlendChunk *chunk = &wc->chunks[wc->chunks_len++];
+  chunk->offset = wc->file_offset;
+  chunk->size = data_len;
+  chunk->_pad = 0;
+
+  ww_chunks_write_raw(wc, data, data_len);
+  wc->size += wc->buf_used_len;
+  wc->buf_used_len = 0;
+}
+
+static bool ww_open_chunks(WriteWrap *ww, const char *filepath)
+{
+  if (lzo_init() != LZO_E_OK) {
+    return false;
+  }
+
+  const int file = BLI_open(filepath, O_BINARY + O_WRONLY + O_CREAT + O_TRUNC, 0666);
+  if (file == -1) {
+    return false;
+  }
+
+  WriteWrapChunks *wc = MEM_callocN(sizeof(*wc), __func__);
+  wc->file_handle = file;
+  wc->buf = MEM_mallocN(BLEND_CHUNKS_SIZE, __func__);
+  wc->buf_compress = MEM_mallocN(LZO_OUT_LEN(BLEND_CHUNKS_SIZE), __func__);
+  wc->work_mem = MEM_mallocN(LZO1X_1_MEM_COMPRESS, __func__);
+
+  /* Written again once the index is known. */
+  const BlendChunksHeader header = {{0}};
+  ww_chunks_write_raw(wc, (const char *)&header, sizeof(header));
+
+  FILE_HANDLE(ww) = wc;
+  return true;
+}
+static bool ww_close_chunks(WriteWrap *ww)
+{
+  WriteWrapChunks *wc = FILE_HANDLE(ww);
+
+  ww_chunks_flush(wc);
+
+  BlendChunksHeader header;
+  memcpy(header.magic, BLEND_CHUNKS_MAGIC, sizeof(header.magic) - 1);
+  header.magic[7] = BLEND_CHUNKS_VERSION;
+  header.chunk_size = BLEND_CHUNKS_SIZE;
+  header.chunk_count = wc->chunks_len;
+  header.size = wc->size;
+  header.index_offset = wc->file_offset;
+
+  if (ENDIAN_ORDER == B_ENDIAN) {
+    BLI_endian_switch_uint32(&header.chunk_size);
+    BLI_endian_switch_uint32(&header.chunk_count);
+    BLI_endian_switch_uint64(&header.size);
+    BLI_endian_switch_uint64(&header.index_offset);
+    for (uint i = 0; i < wc->chunks_len; i++) {
+      BLI_endian_switch_uint64(&wc->chunks[i].offset);
+      BLI_endian_switch_uint32(&wc->chunks[i].size);
+    }
+  }
+
+  ww_chunks_write_raw(wc, (const char *)wc->chunks, sizeof(*wc->chunks) * wc->chunks_len);
+  if (lseek(wc->file_handle, 0, SEEK_SET) == -1) {
+    wc->error = true;
+  }
+  ww_chunks_write_raw(wc, (const char *)&header, sizeof(header));
+
+  const bool success = (close(wc->file_handle) != -1) && !wc->error;
+
+  MEM_SAFE_FREE(wc->chunks);
+  MEM_freeN(wc->buf);
+  MEM_freeN(wc->buf_compress);
+  MEM_freeN(wc->work_mem);
+  MEM_freeN(wc);
+
+  return success;
+}
+static size_t ww_write_chunks(WriteWrap *ww, const char *buf, size_t buf_len)
+{
+  WriteWrapChunks *wc = FILE_HANDLE(ww);
+
+  size_t used_len = 0;
+  while (used_len < buf_len) {
+    const uint len = (uint)MIN2(buf_len - used_len, BLEND_CHUNKS_SIZE - wc->buf_used_len);
+    memcpy(wc->buf + wc->buf_used_len, buf + used_len, len);
+    wc->buf_used_len += len;
+    used_len += len;
+
+    if (wc->buf_used_len == BLEND_CHUNKS_SIZE) {
+      ww_chunks_flush(wc);
+    }
+  }
+
+  return wc->error ? 0 : buf_len;
+}
+#  undef FILE_HANDLE
+#endif /* WITH_LZO */
+
 /* --- end compression types --- */
 
 static void ww_handle_init(eWriteWrapType ww_type, WriteWrap *r_ww)
@@ -285,6 +453,15 @@ static void ww_handle_init(eWriteWrapType ww_type, WriteWrap *r_ww)
   memset(r_ww, 0, sizeof(*r_ww));
 
   switch (ww_type) {
+#ifdef WITH_LZO
+    case WW_WRAP_CHUNKS: {
+      r_ww->open = ww_open_chunks;
+      r_ww->close = ww_close_chunks;
+      r_ww->write = ww_write_chunks;
+      r_ww->use_buf = false;
+      break;
+    }
+#endif
     case WW_WRAP_ZLIB: {
       r_ww->open = ww_open_zlib;
       r_ww->close = ww_close_zlib;
@@ -4360,7 +4537,15 @@ bool BLO_write_file(Main *mainvar,
   /* open temporary file, so we preserve the original in case we crash */
   BLI_snprintf(tempname, sizeof(tempname), "%s@", filepath);
 
-  if (write_flags & G_FILE_COMPRESS) {
+  if (write_flags & G_FILE_COMPRESS_CHUNKED) {
+#ifdef WITH_LZO
+    ww_type = WW_WRAP_CHUNKS;
+#else
+    /* Still write compressed, in the format which doesn't need LZO. */
+    ww_type = WW_WRAP_ZLIB;
+#endif
+  }
+  else if (write_flags & G_FILE_COMPRESS) {
     ww_type = WW_WRAP_ZLIB;
   }
   else {
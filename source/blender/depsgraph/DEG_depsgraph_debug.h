@@ -53,6 +53,28 @@ void DEG_stats_simple(const struct Depsgraph *graph,
                       size_t *r_operations,
                       size_t *r_relations);
 
+/* ------------------------------------------------ */
+/* Evaluation Statistics */
+
+typedef void (*DEG_EvalStatsFn)(void *user_data, const char *name, double time);
+
+/* Gather the timing of every evaluation, like G_DEBUG_DEPSGRAPH_TIME without the prints. */
+void DEG_debug_eval_stats_enable(struct Depsgraph *depsgraph, bool enable);
+bool DEG_debug_eval_stats_is_enabled(const struct Depsgraph *depsgraph);
+
+/* Statistics of the last update, false when nothing was evaluated or gathered. */
+bool DEG_debug_eval_stats_get(const struct Depsgraph *depsgraph,
+                              int *r_num_tagged_ids,
+                              int *r_num_copy_on_write);
+/* Time spent in each evaluated ID, named with its ID code prefix. */
+void DEG_debug_eval_stats_foreach_id(const struct Depsgraph *depsgraph,
+                                     DEG_EvalStatsFn fn,
+                                     void *user_data);
+/* Time spent in each type of evaluated operation. */
+void DEG_debug_eval_stats_foreach_operation(const struct Depsgraph *depsgraph,
+                                            DEG_EvalStatsFn fn,
+                                            void *user_data);
+
 /* ************************************************ */
 /* Diagram-Based Graph Debugging */
 
@@ -125,6 +125,10 @@ bool DEG_is_evaluated_object(struct Object *object);
  * - Nothing is tagged for update. */
 bool DEG_is_fully_evaluated(const struct Depsgraph *depsgraph);
 
+/* Number of times the relations were built. Evaluated datablocks can be freed by a rebuild, so
+ * pointers to them are only valid as long as this doesn't change. */
+int DEG_get_build_count(const struct Depsgraph *depsgraph);
+
 /* ************************ DEG object iterators ********************* */
 
 enum {
@@ -35,7 +35,13 @@
 namespace DEG {
 
 DepsgraphDebug::DepsgraphDebug()
-    : flags(G.debug), is_ever_evaluated(false), graph_evaluation_start_time_(0)
+    : flags(G.debug),
+      is_ever_evaluated(false),
+      eval_stats_enabled(false),
+      has_eval_stats(false),
+      eval_stats_num_tagged_ids(0),
+      eval_stats_num_copy_on_write(0),
+      graph_evaluation_start_time_(0)
 {
 }
 
@@ -44,6 +50,11 @@ bool DepsgraphDebug::do_time_debug() const
   return ((G.debug & G_DEBUG_DEPSGRAPH_TIME) != 0);
 }
 
+bool DepsgraphDebug::do_eval_stats() const
+{
+  return eval_stats_enabled || do_time_debug();
+}
+
 void DepsgraphDebug::begin_graph_evaluation()
 {
   if (!do_time_debug()) {
@@ -37,6 +37,8 @@ class DepsgraphDebug {
   DepsgraphDebug();
 
   bool do_time_debug() const;
+  /* Gather the evaluation statistics, for the time debug or for the API users. */
+  bool do_eval_stats() const;
 
   void begin_graph_evaluation();
   void end_graph_evaluation();
@@ -52,6 +54,14 @@ class DepsgraphDebug {
    * This is NOT an indication that depsgraph is at its evaluated state. */
   bool is_ever_evaluated;
 
+  /* Gather the evaluation statistics without any print, see DEG_debug_eval_stats_enable(). */
+  bool eval_stats_enabled;
+  /* Is true when the statistics were gathered during the last update, which evaluated
+   * eval_stats_num_tagged_ids IDs and eval_stats_num_copy_on_write copy-on-write operations. */
+  bool has_eval_stats;
+  int eval_stats_num_tagged_ids;
+  int eval_stats_num_copy_on_write;
+
  protected:
   /* Maximum number of counters used to calculate frame rate of depsgraph update. */
   static const constexpr int MAX_FPS_COUNTERS = 64;
@@ -110,6 +110,10 @@ struct Depsgraph {
   /* Indicates whether relations needs to be updated. */
   bool need_update;
 
+  /* Number of times the relations were built. Evaluated datablocks of IDs which are not in the
+   * graph anymore are freed on a rebuild, so users keeping them between updates compare it. */
+  int build_count;
+
   /* Indicates which ID types were updated. */
   char id_type_updated[MAX_LIBARRAY];
 
@@ -43,6 +43,7 @@ extern "C" {
 #include "intern/debug/deg_debug.h"
 #include "intern/node/deg_node_component.h"
 #include "intern/node/deg_node_id.h"
+#include "intern/node/deg_node_operation.h"
 #include "intern/node/deg_node_time.h"
 
 void DEG_debug_flags_set(Depsgraph *depsgraph, int flags)
@@ -247,6 +248,68 @@ void DEG_stats_simple(const Depsgraph *graph,
   }
 }
 
+void DEG_debug_eval_stats_enable(Depsgraph *depsgraph, bool enable)
+{
+  DEG::Depsgraph *deg_graph = reinterpret_cast<DEG::Depsgraph *>(depsgraph);
+  deg_graph->debug.eval_stats_enabled = enable;
+}
+
+bool DEG_debug_eval_stats_is_enabled(const Depsgraph *depsgraph)
+{
+  const DEG::Depsgraph *deg_graph = reinterpret_cast<const DEG::Depsgraph *>(depsgraph);
+  return deg_graph->debug.eval_stats_enabled;
+}
+
+bool DEG_debug_eval_stats_get(const Depsgraph *depsgraph,
+                              int *r_num_tagged_ids,
+                              int *r_num_copy_on_write)
+{
+  const DEG::Depsgraph *deg_graph = reinterpret_cast<const DEG::Depsgraph *>(depsgraph);
+  if (!deg_graph->debug.has_eval_stats) {
+    *r_num_tagged_ids = 0;
+    *r_num_copy_on_write = 0;
+    return false;
+  }
+  *r_num_tagged_ids = deg_graph->debug.eval_stats_num_tagged_ids;
+  *r_num_copy_on_write = deg_graph->debug.eval_stats_num_copy_on_write;
+  return true;
+}
+
+void DEG_debug_eval_stats_foreach_id(const Depsgraph *depsgraph,
+                                     DEG_EvalStatsFn fn,
+                                     void *user_data)
+{
+  const DEG::Depsgraph *deg_graph = reinterpret_cast<const DEG::Depsgraph *>(depsgraph);
+  if (!deg_graph->debug.has_eval_stats) {
+    return;
+  }
+  for (DEG::IDNode *id_node : deg_graph->id_nodes) {
+    if (id_node->stats.current_time > 0.0) {
+      fn(user_data, id_node->id_orig->name, id_node->stats.current_time);
+    }
+  }
+}
+
+void DEG_debug_eval_stats_foreach_operation(const Depsgraph *depsgraph,
+                                            DEG_EvalStatsFn fn,
+                                            void *user_data)
+{
+  const DEG::Depsgraph *deg_graph = reinterpret_cast<const DEG::Depsgraph *>(depsgraph);
+  if (!deg_graph->debug.has_eval_stats) {
+    return;
+  }
+  /* Operations are only timed individually, sum them per operation code. */
+  DEG::map<DEG::OperationCode, double> opcode_times;
+  for (DEG::OperationNode *op_node : deg_graph->operations) {
+    if (op_node->stats.current_time > 0.0) {
+      opcode_times[op_node->opcode] += op_node->stats.current_time;
+    }
+  }
+  for (const auto &it : opcode_times) {
+    fn(user_data, DEG::operationCodeAsString(it.first), it.second);
+  }
+}
+
 static DEG::string depsgraph_name_for_logging(struct Depsgraph *depsgraph)
 {
   const char *name = DEG_debug_name_get(depsgraph);
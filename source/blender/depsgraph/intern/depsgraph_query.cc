@@ -324,3 +324,9 @@ bool DEG_is_fully_evaluated(const struct Depsgraph *depsgraph)
   }
   return true;
 }
+
+int DEG_get_build_count(const struct Depsgraph *depsgraph)
+{
+  const DEG::Depsgraph *deg_graph = (const DEG::Depsgraph *)depsgraph;
+  return deg_graph->build_count;
+}
@@ -366,6 +366,7 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
 {
   /* Nothing to update, early out. */
   if (BLI_gset_len(graph->entry_tags) == 0) {
+    graph->debug.has_eval_stats = false;
     return;
   }
 
@@ -376,7 +377,7 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   /* Set up evaluation state. */
   DepsgraphEvalState state;
   state.graph = graph;
-  state.do_stats = graph->debug.do_time_debug();
+  state.do_stats = graph->debug.do_eval_stats();
   state.need_single_thread_pass = false;
   /* Set up task scheduler and pull for threaded evaluation. */
   TaskScheduler *task_scheduler;
@@ -392,6 +393,9 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   TaskPool *task_pool = BLI_task_pool_create_suspended(task_scheduler, &state);
   /* Prepare all nodes for evaluation. */
   initialize_execution(&state, graph);
+  if (state.do_stats) {
+    deg_eval_stats_count_tagged(graph);
+  }
 
   /* Do actual evaluation now. */
 
@@ -417,6 +421,7 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   if (state.do_stats) {
     deg_eval_stats_aggregate(graph);
   }
+  graph->debug.has_eval_stats = state.do_stats;
   /* Clear any uncleared tags - just in case. */
   deg_graph_clear_tags(graph);
   if (need_free_scheduler) {
@@ -35,6 +35,37 @@
 
 namespace DEG {
 
+void deg_eval_stats_count_tagged(Depsgraph *graph)
+{
+  int num_tagged_ids = 0;
+  int num_copy_on_write = 0;
+  for (IDNode *id_node : graph->id_nodes) {
+    bool tagged = false;
+    GHASH_FOREACH_BEGIN (ComponentNode *, comp_node, id_node->components) {
+      const bool is_copy_on_write = (comp_node->type == NodeType::COPY_ON_WRITE);
+      /* Same visibility check as the evaluation, copy-on-write is always evaluated. */
+      if (!is_copy_on_write && !comp_node->affects_directly_visible) {
+        continue;
+      }
+      for (OperationNode *op_node : comp_node->operations) {
+        if ((op_node->flag & DEPSOP_FLAG_NEEDS_UPDATE) == 0) {
+          continue;
+        }
+        tagged = true;
+        if (is_copy_on_write) {
+          ++num_copy_on_write;
+        }
+      }
+    }
+    GHASH_FOREACH_END();
+    if (tagged) {
+      ++num_tagged_ids;
+    }
+  }
+  graph->debug.eval_stats_num_tagged_ids = num_tagged_ids;
+  graph->debug.eval_stats_num_copy_on_write = num_copy_on_write;
+}
+
 void deg_eval_stats_aggregate(Depsgraph *graph)
 {
   /* Reset current evaluation stats for ID and component nodes.
@@ -27,6 +27,9 @@ namespace DEG {
 
 struct Depsgraph;
 
+/* Count the IDs and copy-on-write operations which are going to be evaluated. */
+void deg_eval_stats_count_tagged(Depsgraph *graph);
+
 /* Aggregate operation timings to overall component and ID nodes timing. */
 void deg_eval_stats_aggregate(Depsgraph *graph);
 
@@ -716,6 +716,14 @@ typedef struct DRWContextState {
 const DRWContextState *DRW_context_state_get(void);
 
 /*****************************GAME ENGINE***********************************/
+typedef struct DRWGameObjectList DRWGameObjectList;
+
+DRWGameObjectList *DRW_game_object_list_create(void);
+void DRW_game_object_list_free(DRWGameObjectList *list);
+/* The objects to draw changed, they are gathered again at the next render. */
+void DRW_game_object_list_tag_dirty(DRWGameObjectList *list);
+
+/* object_list can be NULL to always iterate the depsgraph. */
 void DRW_game_render_loop(struct bContext *C,
                           GPUViewport *viewport,
                           struct Main *bmain,
@@ -723,7 +731,8 @@ void DRW_game_render_loop(struct bContext *C,
                           const struct rcti *window,
                           bool called_from_constructor,
                           bool reset_taa_samples,
-                          bool is_overlay_pass);
+                          bool is_overlay_pass,
+                          DRWGameObjectList *object_list);
 
 void DRW_game_render_loop_end(void);
 void DRW_transform_to_display(struct GPUTexture *tex, struct View3D *v3d, bool do_dithering);
@@ -2848,6 +2848,128 @@ EEVEE_Data *EEVEE_engine_data_get(void)
   return data;
 }
 
+/* List of the objects populated by the game passes, kept between the frames to skip the
+ * depsgraph iteration. Only the list is kept: every object is still populated at each pass and
+ * the engines rebuild their passes and shading groups from scratch. The game engine tags the list
+ * dirty when objects are added, removed or hidden and the list tags itself dirty when the
+ * depsgraph relations are rebuilt, as the rebuild can free the evaluated objects. */
+struct DRWGameObjectList {
+  /* All the objects to populate, in the depsgraph iterator order. */
+  Object **objects;
+  int objects_len;
+  int objects_alloc;
+  /* Subset of the objects drawn by the overlay pass. */
+  Object **overlay_objects;
+  int overlay_objects_len;
+  int overlay_objects_alloc;
+  /* Depsgraph the objects were evaluated by and its build count at the time. */
+  Depsgraph *depsgraph;
+  int depsgraph_build_count;
+  /* The objects don't match the depsgraph anymore. */
+  bool dirty;
+  /* Dupli objects are temporary copies made by the iterator, the depsgraph is iterated at each
+   * populate until the next rebuild. */
+  bool has_dupli;
+};
+
+DRWGameObjectList *DRW_game_object_list_create(void)
+{
+  DRWGameObjectList *list = MEM_callocN(sizeof(DRWGameObjectList), __func__);
+  list->dirty = true;
+  return list;
+}
+
+static void drw_game_object_list_clear(DRWGameObjectList *list)
+{
+  MEM_SAFE_FREE(list->objects);
+  MEM_SAFE_FREE(list->overlay_objects);
+  list->objects_len = list->objects_alloc = 0;
+  list->overlay_objects_len = list->overlay_objects_alloc = 0;
+  list->has_dupli = false;
+}
+
+void DRW_game_object_list_free(DRWGameObjectList *list)
+{
+  drw_game_object_list_clear(list);
+  MEM_freeN(list);
+}
+
+void DRW_game_object_list_tag_dirty(DRWGameObjectList *list)
+{
+  list->dirty = true;
+}
+
+static void drw_game_object_array_append(Object ***array, int *len, int *alloc, Object *ob)
+{
+  if (*len == *alloc) {
+    *alloc = max_ii(64, *alloc * 2);
+    *array = MEM_reallocN_id(*array, sizeof(Object *) * *alloc, __func__);
+  }
+  (*array)[(*len)++] = ob;
+}
+
+static void drw_game_objects_populate(DRWGameObjectList *list,
+                                      Depsgraph *depsgraph,
+                                      bool is_overlay_pass)
+{
+  if (list && (list->depsgraph != depsgraph ||
+                list->depsgraph_build_count != DEG_get_build_count(depsgraph))) {
+    list->dirty = true;
+  }
+
+  if (list && !list->dirty && !list->has_dupli) {
+    Object **objects = is_overlay_pass ? list->overlay_objects : list->objects;
+    const int objects_len = is_overlay_pass ? list->overlay_objects_len : list->objects_len;
+    for (int i = 0; i < objects_len; i++) {
+      drw_engines_cache_populate(objects[i]);
+    }
+    return;
+  }
+
+  /* Rebuild the list while populating. */
+  const bool build = (list && list->dirty);
+  if (build) {
+    drw_game_object_list_clear(list);
+    list->depsgraph = depsgraph;
+    list->depsgraph_build_count = DEG_get_build_count(depsgraph);
+    list->dirty = false;
+  }
+
+  DEG_OBJECT_ITER_FOR_RENDER_ENGINE_BEGIN (depsgraph, ob) {
+    Object *orig_ob = DEG_get_original_object(ob);
+    const bool is_overlay = (orig_ob->gameflag & OB_OVERLAY_COLLECTION) != 0;
+
+    if (build && !list->has_dupli) {
+      if (data_.dupli_object_current) {
+        list->has_dupli = true;
+      }
+      else {
+        drw_game_object_array_append(
+            &list->objects, &list->objects_len, &list->objects_alloc, ob);
+        if (is_overlay) {
+          drw_game_object_array_append(&list->overlay_objects,
+                                       &list->overlay_objects_len,
+                                       &list->overlay_objects_alloc,
+                                       ob);
+        }
+      }
+    }
+
+    if (!is_overlay_pass || is_overlay) {
+      drw_engines_cache_populate(ob);
+    }
+  }
+  DEG_OBJECT_ITER_FOR_RENDER_ENGINE_END;
+
+  if (build && list->has_dupli) {
+    /* Keep the flag, only free the partial arrays. */
+    MEM_SAFE_FREE(list->objects);
+    MEM_SAFE_FREE(list->overlay_objects);
+    list->objects_len = list->objects_alloc = 0;
+    list->overlay_objects_len = list->overlay_objects_alloc = 0;
+  }
+}
+
 void DRW_game_render_loop(bContext *C,
                           GPUViewport *viewport,
                           Main *bmain,
@@ -2855,7 +2977,8 @@ void DRW_game_render_loop(bContext *C,
                           const rcti *window,
                           bool called_from_constructor,
                           bool reset_taa_samples,
-                          bool is_overlay_pass)
+                          bool is_overlay_pass,
+                          DRWGameObjectList *object_list)
 {
   /* Reset before using it. */
   drw_state_prepare_clean_for_draw(&DST);
@@ -2914,22 +3037,9 @@ void DRW_game_render_loop(bContext *C,
   drw_engines_cache_init();
   drw_engines_world_update(DST.draw_ctx.scene);
 
-  if (is_overlay_pass) {
-    DEG_OBJECT_ITER_FOR_RENDER_ENGINE_BEGIN (depsgraph, ob) {
-      Object *orig_ob = DEG_get_original_object(ob);
-
-      if (orig_ob->gameflag & OB_OVERLAY_COLLECTION) {
-        drw_engines_cache_populate(ob);
-      }
-    }
-    DEG_OBJECT_ITER_FOR_RENDER_ENGINE_END;
-  }
-  else {
-    DEG_OBJECT_ITER_FOR_RENDER_ENGINE_BEGIN (depsgraph, ob) {
-      drw_engines_cache_populate(ob);
-    }
-    DEG_OBJECT_ITER_FOR_RENDER_ENGINE_END;
-  }
+  drw_resource_deferred_begin();
+  drw_game_objects_populate(object_list, depsgraph, is_overlay_pass);
+  drw_resource_deferred_finish();
 
   drw_engines_cache_finish();
   DRW_render_instance_buffer_finish();
@@ -176,6 +176,17 @@ typedef struct DRWObjectInfos {
 BLI_STATIC_ASSERT_ALIGN(DRWObjectMatrix, 16)
 BLI_STATIC_ASSERT_ALIGN(DRWObjectInfos, 16)
 
+/* Object resource allocated during the populate, its data is computed afterward on all threads.
+ * Only used by the game engine populate, see drw_resource_deferred_begin. */
+typedef struct DRWDeferredResource {
+  Object *ob;
+  DRWResourceHandle handle;
+  DRWObjectMatrix *ob_mats;
+  DRWCullingState *culling;
+  /* NULL if no shading group of the object uses the object infos. */
+  DRWObjectInfos *ob_infos;
+} DRWDeferredResource;
+
 typedef enum {
   /* Draw Commands */
   DRW_CMD_DRAW = 0, /* Only sortable type. Must be 0. */
@@ -459,6 +470,11 @@ typedef struct DRWManager {
   DRWResourceHandle ob_handle;
   /** True if current DST.ob_state has its matching DRWObjectInfos init. */
   bool ob_state_obinfo_init;
+  /** Object resources whose data is computed at the end of the populate, NULL if disabled. */
+  DRWDeferredResource *deferred_resources;
+  int deferred_resources_len;
+  int deferred_resources_alloc;
+  bool defer_resources;
   /** Handle of current object resource in object resource arrays (DRWObjectMatrices/Infos). */
   DRWResourceHandle resource_handle;
   /** Handle of next DRWPass to be allocated. */
@@ -584,6 +600,9 @@ void drw_batch_cache_generate_requested(struct Object *ob);
 
 void drw_resource_buffer_finish(ViewportMemoryPool *vmempool);
 
+void drw_resource_deferred_begin(void);
+void drw_resource_deferred_finish(void);
+
 /* Procedural Drawing */
 GPUBatch *drw_cache_procedural_points_get(void);
 GPUBatch *drw_cache_procedural_lines_get(void);
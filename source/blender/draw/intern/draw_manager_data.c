@@ -40,6 +40,7 @@
 #include "BLI_link_utils.h"
 #include "BLI_mempool.h"
 #include "BLI_memblock.h"
+#include "BLI_task.h"
 
 #ifdef DRW_DEBUG_CULLING
 #  include "BLI_math_bits.h"
@@ -539,6 +540,48 @@ static void drw_call_culling_init(DRWCullingState *cull, Object *ob)
   cull->user_data = NULL;
 }
 
+/* The object data used by the resources is evaluated lazily, do it before using it from all
+ * threads. Only the bounding box is per object, the texture space is shared. */
+static void drw_call_texspace_ensure(Object *ob)
+{
+  ID *ob_data = ob->data;
+  if (ob_data == NULL) {
+    return;
+  }
+  switch (GS(ob_data->name)) {
+    case ID_ME:
+      BKE_mesh_texspace_ensure((Mesh *)ob_data);
+      break;
+    case ID_CU:
+      BKE_curve_texspace_ensure((Curve *)ob_data);
+      break;
+    default:
+      break;
+  }
+}
+
+static DRWDeferredResource *drw_resource_deferred_add(void)
+{
+  if (DST.deferred_resources_len == DST.deferred_resources_alloc) {
+    DST.deferred_resources_alloc = max_ii(256, DST.deferred_resources_alloc * 2);
+    DST.deferred_resources = MEM_reallocN_id(DST.deferred_resources,
+                                             sizeof(DRWDeferredResource) *
+                                                 DST.deferred_resources_alloc,
+                                             __func__);
+  }
+  return &DST.deferred_resources[DST.deferred_resources_len++];
+}
+
+/* Return the deferred resource of the current object, NULL if its data was initialized. */
+static DRWDeferredResource *drw_resource_deferred_get(DRWResourceHandle handle)
+{
+  if (DST.deferred_resources_len == 0) {
+    return NULL;
+  }
+  DRWDeferredResource *resource = &DST.deferred_resources[DST.deferred_resources_len - 1];
+  return (resource->handle == handle) ? resource : NULL;
+}
+
 static DRWResourceHandle drw_resource_handle_new(float (*obmat)[4], Object *ob)
 {
   DRWCullingState *culling = BLI_memblock_alloc(DST.vmempool->cullstates);
@@ -555,6 +598,20 @@ static DRWResourceHandle drw_resource_handle_new(float (*obmat)[4], Object *ob)
     DRW_handle_negative_scale_enable(&handle);
   }
 
+  /* Duplis are temporary, their data is computed immediately. */
+  if (ob && DST.defer_resources && DST.dupli_source == NULL) {
+    DRWDeferredResource *resource = drw_resource_deferred_add();
+    resource->ob = ob;
+    resource->handle = handle;
+    resource->ob_mats = ob_mats;
+    resource->culling = culling;
+    resource->ob_infos = NULL;
+    /* The calls can disable the culling and set the user data before the data is computed. */
+    culling->bsphere.radius = 0.0f;
+    culling->user_data = NULL;
+    return handle;
+  }
+
   drw_call_matrix_init(ob_mats, ob, obmat);
   drw_call_culling_init(culling, ob);
   /* ob_infos is init only if needed. */
@@ -562,6 +619,60 @@ static DRWResourceHandle drw_resource_handle_new(float (*obmat)[4], Object *ob)
   return handle;
 }
 
+static void drw_resource_deferred_init_cb(void *__restrict userdata,
+                                          const int iter,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DRWDeferredResource *resource = &((DRWDeferredResource *)userdata)[iter];
+  Object *ob = resource->ob;
+  DRWCullingState *culling = resource->culling;
+
+  drw_call_matrix_init(resource->ob_mats, ob, ob->obmat);
+
+  const bool bypass_culling = (culling->bsphere.radius == -1.0f);
+  void *user_data = culling->user_data;
+  drw_call_culling_init(culling, ob);
+  culling->user_data = user_data;
+  if (bypass_culling) {
+    culling->bsphere.radius = -1.0f;
+  }
+
+  if (resource->ob_infos) {
+    drw_call_obinfos_init(resource->ob_infos, ob);
+  }
+}
+
+/* Start recording the object resources instead of computing their data, the game engine
+ * populates many objects and the matrices, bounds and infos are independent per object. */
+void drw_resource_deferred_begin(void)
+{
+  DST.defer_resources = true;
+}
+
+/* Compute the data of the recorded object resources on all threads, must be called before the
+ * engines cache finish. */
+void drw_resource_deferred_finish(void)
+{
+  /* The recorded objects are not duplis, the random value of the infos ignores the state left
+   * by the last populated object. */
+  DST.dupli_source = NULL;
+
+  if (DST.deferred_resources_len > 0) {
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 64;
+    BLI_task_parallel_range(0,
+                            DST.deferred_resources_len,
+                            DST.deferred_resources,
+                            drw_resource_deferred_init_cb,
+                            &settings);
+  }
+
+  MEM_SAFE_FREE(DST.deferred_resources);
+  DST.deferred_resources_len = DST.deferred_resources_alloc = 0;
+  DST.defer_resources = false;
+}
+
 uint32_t DRW_object_resource_id_get(Object *UNUSED(ob))
 {
   DRWResourceHandle handle = DST.ob_handle;
@@ -597,7 +708,14 @@ static DRWResourceHandle drw_resource_handle(DRWShadingGroup *shgroup,
         DRWObjectInfos *ob_infos = DRW_memblock_elem_from_handle(DST.vmempool->obinfos,
                                                                  &DST.ob_handle);
 
-        drw_call_obinfos_init(ob_infos, ob);
+        DRWDeferredResource *resource = drw_resource_deferred_get(DST.ob_handle);
+        if (resource) {
+          drw_call_texspace_ensure(ob);
+          resource->ob_infos = ob_infos;
+        }
+        else {
+          drw_call_obinfos_init(ob_infos, ob);
+        }
       }
     }
 
@@ -150,6 +150,7 @@ typedef enum eGPUDataFormat {
 } eGPUDataFormat;
 
 unsigned int GPU_texture_memory_usage_get(void);
+unsigned int GPU_texture_memory_usage(const GPUTexture *tex);
 
 /* TODO make it static function again. (create function with eGPUDataFormat exposed) */
 GPUTexture *GPU_texture_create_nD(int w,
@@ -95,7 +95,7 @@ struct GPUTexture {
  * to estimate the Texture Pool Memory consumption */
 static uint memory_usage;
 
-static uint gpu_texture_memory_footprint_compute(GPUTexture *tex)
+static uint gpu_texture_memory_footprint_compute(const GPUTexture *tex)
 {
   int samp = max_ii(tex->samples, 1);
   switch (tex->target_base) {
@@ -131,6 +131,12 @@ uint GPU_texture_memory_usage_get(void)
   return memory_usage;
 }
 
+/* Memory footprint of a single texture. */
+uint GPU_texture_memory_usage(const GPUTexture *tex)
+{
+  return gpu_texture_memory_footprint_compute(tex);
+}
+
 /* -------------------------------- */
 
 static const char *gl_enum_to_str(GLenum e)
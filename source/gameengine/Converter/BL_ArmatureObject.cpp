@@ -38,7 +38,9 @@
 #include "BKE_object.h"
 #include "BKE_global.h"
 #include "BKE_constraint.h"
+#include "BKE_modifier.h"
 #include "DNA_armature_types.h"
+#include "DNA_modifier_types.h"
 #include "RNA_access.h"
 
 extern "C" {
@@ -48,16 +50,19 @@ extern "C" {
 #include "BKE_lib_id.h"
 #include "BKE_scene.h"
 
+#include "DEG_depsgraph.h"
 #include "DEG_depsgraph_query.h"
 }
 
 #include "BL_ArmatureObject.h"
 #include "BL_ActionActuator.h"
 #include "BL_Action.h"
+#include "BL_ActionPoseCache.h"
 #include "KX_BlenderSceneConverter.h"
 #include "KX_BlenderConverter.h"
 #include "KX_Globals.h"
 #include "KX_KetsjiEngine.h"
+#include "KX_Scene.h"
 
 #include "RAS_DebugDraw.h"
 
@@ -221,7 +226,8 @@ BL_ArmatureObject::BL_ArmatureObject(void *sgReplicationInfo,
       m_timestep(0.040),
       m_vert_deform_type(vert_deform_type),
       m_drawDebug(false),
-      m_lastapplyframe(0.0)
+      m_lastapplyframe(0.0),
+      m_deformedObjectsBuildCount(-1)
 {
   m_controlledConstraints = new CListValue<BL_ArmatureConstraint>();
   m_poseChannels = new CListValue<BL_ArmatureChannel>();
@@ -403,6 +409,10 @@ void BL_ArmatureObject::ProcessReplica()
 
   m_objArma = m_pBlenderObject;
   m_pose = m_objArma->pose;
+
+  // The replica deforms its own objects.
+  m_deformedObjects.clear();
+  m_deformedObjectsBuildCount = -1;
 }
 
 int BL_ArmatureObject::GetGameObjectType() const
@@ -472,14 +482,101 @@ void BL_ArmatureObject::SetPose(bPose *pose)
   m_lastapplyframe = -1.0;
 }
 
-void BL_ArmatureObject::SetPoseByAction(bAction *action, float localtime)
+bool BL_ArmatureObject::SetPoseByAction(bAction *action, float localtime)
 {
+  // Sample the pose channels directly, the sample is shared with the other armatures.
+  BL_ActionPoseCache *poseCache = KX_GameObject::GetScene()->GetActionPoseCache();
+  if (poseCache->SetPose(action, GetArmature(), m_pose, localtime)) {
+    return true;
+  }
+
+  // The action animates other properties, use the animation system.
   Object *arm = GetArmatureObject();
 
   PointerRNA ptrrna;
   RNA_id_pointer_create(&arm->id, &ptrrna);
 
   animsys_evaluate_action(&ptrrna, action, localtime, false);
+
+  return false;
+}
+
+static bool object_is_deformed_by_armature(Object *ob, Object *armature)
+{
+  VirtualModifierData virtualModifierData;
+  // Include the virtual modifier of the armature parenting.
+  for (ModifierData *md = modifiers_getVirtualModifierList(ob, &virtualModifierData); md;
+       md = md->next) {
+    if (md->type == eModifierType_Armature && ((ArmatureModifierData *)md)->object == armature) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void collect_deformed_object(ID *id, void *user_data)
+{
+  if (GS(id->name) != ID_OB) {
+    return;
+  }
+
+  BL_ArmatureObject *armature = (BL_ArmatureObject *)user_data;
+  Object *ob = (Object *)id;
+  if (ob != armature->GetArmatureObject() &&
+      object_is_deformed_by_armature(ob, armature->GetArmatureObject())) {
+    armature->AddDeformedObject(ob);
+  }
+}
+
+void BL_ArmatureObject::AddDeformedObject(Object *ob)
+{
+  m_deformedObjects.push_back(ob);
+}
+
+bool BL_ArmatureObject::UpdateEvaluatedPose(Depsgraph *depsgraph)
+{
+  Object *ob_eval = DEG_get_evaluated_object(depsgraph, m_objArma);
+  // The pose of an armature not evaluated yet or rebuilt is created by the depsgraph.
+  if (ob_eval == m_objArma || !ob_eval->pose || (ob_eval->pose->flag & POSE_RECALC) ||
+      BLI_listbase_count(&ob_eval->pose->chanbase) != BLI_listbase_count(&m_pose->chanbase)) {
+    return false;
+  }
+
+  extract_pose_from_pose(ob_eval->pose, m_pose);
+  BKE_pose_where_is(depsgraph, DEG_get_evaluated_scene(depsgraph), ob_eval);
+
+  // Same as the depsgraph pose evaluation, the armature modifier reads the segments.
+  for (bPoseChannel *pchan = (bPoseChannel *)ob_eval->pose->chanbase.first; pchan;
+       pchan = pchan->next) {
+    if (pchan->bone && pchan->bone->segments > 1) {
+      BKE_pchan_bbone_segments_cache_compute(pchan);
+    }
+
+    // Keep the game pose matrices up to date for the channels and the debug draw.
+    bPoseChannel *pchan_orig = pchan->orig_pchan;
+    if (pchan_orig) {
+      copy_m4_m4(pchan_orig->pose_mat, pchan->pose_mat);
+      copy_m4_m4(pchan_orig->chan_mat, pchan->chan_mat);
+      copy_v3_v3(pchan_orig->pose_head, pchan->pose_mat[3]);
+      copy_m4_m4(pchan_orig->constinv, pchan->constinv);
+      copy_v3_v3(pchan_orig->pose_tail, pchan->pose_tail);
+    }
+  }
+
+  /* Only the deformation of the meshes is evaluated by the depsgraph. The deformed objects are
+   * found from the relations, they can use the armature without being parented to it. */
+  const int buildCount = DEG_get_build_count(depsgraph);
+  if (buildCount != m_deformedObjectsBuildCount) {
+    m_deformedObjects.clear();
+    DEG_foreach_dependent_ID(depsgraph, &m_objArma->id, collect_deformed_object, this);
+    m_deformedObjectsBuildCount = buildCount;
+  }
+
+  for (Object *ob : m_deformedObjects) {
+    DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
+  }
+
+  return true;
 }
 
 void BL_ArmatureObject::BlendInPose(bPose *blend_pose, float weight, short mode)
@@ -40,6 +40,7 @@ struct bArmature;
 struct Bone;
 struct bPose;
 struct bConstraint;
+struct Depsgraph;
 struct Object;
 class MT_Matrix4x4;
 class KX_BlenderSceneConverter;
@@ -72,6 +73,11 @@ class BL_ArmatureObject : public KX_GameObject {
 
   double m_lastapplyframe;
 
+  /// Objects deformed by the armature, tagged when the pose is evaluated in the game engine.
+  std::vector<Object *> m_deformedObjects;
+  /// Depsgraph build count of the deformed objects, see DEG_get_build_count.
+  int m_deformedObjectsBuildCount;
+
  public:
   BL_ArmatureObject(void *sgReplicationInfo,
                     SG_Callbacks callbacks,
@@ -94,9 +100,17 @@ class BL_ArmatureObject : public KX_GameObject {
   /// Never edit this, only for accessing names.
   bPose *GetOrigPose();
   void ApplyPose();
-  void SetPoseByAction(bAction *action, float localtime);
+  /// Return true if the pose channels were sampled without the animation system.
+  bool SetPoseByAction(bAction *action, float localtime);
   void BlendInPose(bPose *blend_pose, float weight, short mode);
   void RestorePose();
+  /** Evaluate the bone matrices of the evaluated armature from the pose and tag the deformed
+   * meshes, the depsgraph doesn't evaluate the armature itself.
+   * \return false if the armature isn't evaluated yet and must be tagged for update.
+   */
+  bool UpdateEvaluatedPose(Depsgraph *depsgraph);
+  /// Register an object deformed by the armature, used while collecting them.
+  void AddDeformedObject(Object *ob);
 
   bool UpdateTimestep(double curtime);
 
@@ -81,6 +81,7 @@
 #include "KX_FontObject.h"
 #include "KX_LodManager.h"
 #include "KX_PythonComponent.h"
+#include "KX_PythonComponentManager.h"
 
 #include "RAS_ICanvas.h"
 #include "RAS_Polygon.h"
@@ -132,6 +133,7 @@
 #include "DNA_world_types.h"
 #include "DNA_sound_types.h"
 #include "DNA_key_types.h"
+#include "DNA_modifier_types.h"
 #include "DNA_armature_types.h"
 #include "DNA_action_types.h"
 #include "DNA_object_force_types.h"
@@ -155,6 +157,7 @@ extern "C" {
 #include "BKE_layer.h"
 #include "BKE_material.h" /* give_current_material */
 #include "BKE_mesh_runtime.h"
+#include "BKE_modifier.h"
 #include "BKE_image.h"
 #include "IMB_imbuf_types.h"
 #include "BKE_displist.h"
@@ -417,6 +420,25 @@ static RAS_MaterialBucket *material_from_mesh(Material *ma,
   return bucket;
 }
 
+// Return true if the evaluated positions of the object mesh differ from the original ones.
+static bool object_mesh_is_deformed(Object *ob, Mesh *mesh)
+{
+  if (mesh->key) {
+    return true;
+  }
+
+  VirtualModifierData virtualModifierData;
+  // Include the virtual modifiers of the armature, curve and lattice parentings.
+  for (ModifierData *md = modifiers_getVirtualModifierList(ob, &virtualModifierData); md;
+       md = md->next) {
+    if ((md->mode & eModifierMode_Realtime) && !modifier_isNonGeometrical(md)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 /* blenderobj can be nullptr, make sure its checked for */
 RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
                                Object *blenderobj,
@@ -442,8 +464,9 @@ RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
   Scene *bl_scene = scene->GetBlenderScene();
   ViewLayer *view_layer = BKE_view_layer_default_view(bl_scene);
   Depsgraph *depsgraph = BKE_scene_get_depsgraph(G_MAIN, bl_scene, view_layer, false);
-  Object *ob_eval = DEG_get_evaluated_object(depsgraph, blenderobj);
-  Mesh *final_me = (Mesh *)ob_eval->data;
+  // Without object there's no evaluated data, e.g when converting meshes of a library.
+  Mesh *final_me = blenderobj ? (Mesh *)DEG_get_evaluated_object(depsgraph, blenderobj)->data :
+                                mesh;
   DerivedMesh *dm = CDDM_from_mesh(final_me);
   DM_ensure_tessface(dm);
 
@@ -498,6 +521,13 @@ RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
 
   meshobj = new RAS_MeshObject(mesh, blenderobj, layersInfo);
   meshobj->m_sharedvertex_map.resize(totverts);
+  /* Keep the display array vertex of each loop to write the vertex buffer edits back to the
+   * original mesh, only possible when the modifiers don't change the topology. */
+  if (final_me->totvert == mesh->totvert && final_me->totloop == mesh->totloop &&
+      final_me->totpoly == mesh->totpoly) {
+    meshobj->m_loopVertices.resize(final_me->totloop);
+    meshobj->m_deformed = blenderobj && object_mesh_is_deformed(blenderobj, mesh);
+  }
 
   // Initialize vertex format with used uv and color layers.
   RAS_TexVertFormat vertformat;
@@ -576,6 +606,9 @@ RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
 
       // Add tracked vertices by the mpoly.
       vertices[vertid] = meshobj->AddVertex(meshmat, pt, uvs, tan, rgba, no, flat, vertid);
+      if (!meshobj->m_loopVertices.empty()) {
+        meshobj->m_loopVertices[j] = vertices[vertid];
+      }
     }
 
     // Convert to edges of material is rendering wire.
@@ -624,6 +657,22 @@ RAS_MeshObject *BL_ConvertMesh(Mesh *mesh,
   return meshobj;
 }
 
+/* Convert a material not used by any mesh yet, its shader is compiled to be ready
+ * for the meshes using it later. */
+RAS_MaterialBucket *BL_ConvertMaterial(Material *mat,
+                                       KX_Scene *scene,
+                                       RAS_Rasterizer *rasty,
+                                       KX_BlenderSceneConverter &converter)
+{
+  const bool converted = (converter.FindMaterial(mat) != nullptr);
+  RAS_MaterialBucket *bucket = material_from_mesh(mat, (1 << 20) - 1, scene, rasty, converter);
+  if (!converted) {
+    bucket->GetPolyMaterial()->OnConstruction();
+  }
+
+  return bucket;
+}
+
 static PHY_ShapeProps *CreateShapePropsFromBlenderObject(struct Object *blenderobject)
 {
   PHY_ShapeProps *shapeProps = new PHY_ShapeProps;
@@ -1614,6 +1663,12 @@ void BL_ConvertBlenderObjects(struct Main *maggie,
     BL_ConvertComponentsObject(gameobj, blenderobj);
   }
 
+  // Only the components of the active objects are updated.
+  KX_PythonComponentManager *componentManager = kxscene->GetPythonComponentManager();
+  for (KX_GameObject *gameobj : objectlist) {
+    componentManager->RegisterObject(gameobj);
+  }
+
   // cleanup converted set of group objects
   convertedlist->Release();
   sumolist->Release();
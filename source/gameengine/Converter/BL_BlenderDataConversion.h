@@ -44,6 +44,11 @@ class RAS_MeshObject *BL_ConvertMesh(struct Mesh *mesh,
                                      class KX_BlenderSceneConverter &converter,
                                      bool libloading);
 
+class RAS_MaterialBucket *BL_ConvertMaterial(struct Material *mat,
+                                             class KX_Scene *scene,
+                                             class RAS_Rasterizer *rasty,
+                                             class KX_BlenderSceneConverter &converter);
+
 void BL_ConvertBlenderObjects(struct Main *maggie,
                               struct Depsgraph *depsgraph,
                               class KX_Scene *kxscene,
@@ -46,8 +46,11 @@
 #include "KX_BlenderSceneConverter.h"
 #include "BL_BlenderDataConversion.h"
 #include "BL_ActionActuator.h"
+#include "BL_ActionPoseCache.h"
 #include "KX_BlenderMaterial.h"
 
+#include "SG_Node.h"
+
 #include "LA_SystemCommandLine.h"
 
 #include "DummyPhysicsEnvironment.h"
@@ -67,25 +70,41 @@
 #include "BKE_main.h"
 
 extern "C" {
+#include "DNA_action_types.h"
+#include "DNA_anim_types.h"
+#include "DNA_collection_types.h"
+#include "DNA_image_types.h"
 #include "DNA_mesh_types.h"
 #include "DNA_material_types.h"
+#include "DNA_object_types.h"
+#include "DNA_packedFile_types.h"
 #include "BLI_blenlib.h"
 #include "BLI_linklist.h"
 #include "BLO_readfile.h"
 #include "BKE_global.h"
+#include "BKE_collection.h"
+#include "BKE_customdata.h"
 #include "BKE_layer.h"
 #include "BKE_lib_id.h"
 #include "BKE_material.h"  // BKE_material_copy
 #include "BKE_mesh.h"      // BKE_mesh_copy
 #include "BKE_idcode.h"
+#include "BKE_image.h"
 #include "BKE_report.h"
 #include "BKE_scene.h"
+#include "IMB_imbuf.h"
+#include "GPU_texture.h"
 }
 
 #include "BLI_task.h"
 #include "CM_Message.h"
 
+#include "PIL_time.h"
+
+#include <algorithm>
 #include <cstring>
+#include <set>
+#include <unordered_map>
 
 KX_BlenderConverter::SceneSlot::SceneSlot() = default;
 
@@ -121,7 +140,16 @@ void KX_BlenderConverter::SceneSlot::Merge(const KX_BlenderSceneConverter &conve
 }
 
 KX_BlenderConverter::KX_BlenderConverter(Main *maggie, KX_KetsjiEngine *engine)
-    : m_maggie(maggie), m_ketsjiEngine(engine), m_alwaysUseExpandFraming(false)
+    : m_streamrunning(0),
+      m_streammemory(0),
+      m_streambudget(0),
+      m_maggie(maggie),
+      m_memorystatsvalid(false),
+      m_memorybudget(0),
+      m_memorybudgetexceeded(false),
+      m_memorybudgettime(0.0),
+      m_ketsjiEngine(engine),
+      m_alwaysUseExpandFraming(false)
 {
   BKE_main_id_tag_all(maggie, LIB_TAG_DOIT, false);  // avoid re-tagging later on
   m_threadinfo.m_pool = BLI_task_pool_create(engine->GetTaskScheduler(), nullptr);
@@ -237,6 +265,8 @@ void KX_BlenderConverter::ConvertScene(KX_Scene *destinationscene,
                            libloading);
 
   m_sceneSlots.emplace(destinationscene, sceneConverter);
+
+  InvalidateMemoryStats();
 }
 
 /** This function removes all entities stored in the converter for that scene
@@ -264,6 +294,8 @@ void KX_BlenderConverter::RemoveScene(KX_Scene *scene)
   scene->Release();
 
   m_sceneSlots.erase(scene);
+
+  InvalidateMemoryStats();
 }
 
 void KX_BlenderConverter::SetAlwaysUseExpandFraming(bool to_what)
@@ -329,17 +361,58 @@ void KX_BlenderConverter::MergeAsyncLoads()
 
     delete merge_scenes;
     (*mit)->SetData(nullptr);
+    InvalidateMemoryStats();
 
     (*mit)->Finish();
   }
 
   m_mergequeue.clear();
 
+  std::vector<KX_LibLoadStatus *> streammergequeue;
+  streammergequeue.swap(m_streammergequeue);
+
   m_threadinfo.m_mutex.Unlock();
+
+  // Streamed items are converted outside of the lock, the workers can keep loading.
+  for (KX_LibLoadStatus *status : streammergequeue) {
+    MergeStreamItem(status);
+  }
+
+  UpdateStreaming();
+  UpdateMemoryBudget();
 }
 
+/// Library shared by its streamed items, so it's opened and indexed once.
+struct StreamLibrary {
+  /// Opened by the first worker linking from it, only used with the link mutex locked.
+  BlendHandle *handle;
+  /// Number of queued, loading or unmerged items of the library, only used by the main thread.
+  unsigned int users;
+};
+
+/// Library item loaded by the workers, owned by its status until merged.
+struct StreamItem {
+  std::string path;
+  short idcode;
+  std::string name;
+  StreamLibrary *library;
+  /// Main holding the linked item, nullptr until linked.
+  Main *maggie;
+  /// Converted objects of a collection to merge.
+  KX_Scene *scene;
+  size_t memory;
+};
+
 void KX_BlenderConverter::FinalizeAsyncLoads()
 {
+  // Cancel the streamed items which didn't start loading.
+  for (KX_LibLoadStatus *status : m_streamqueue) {
+    m_status_map.erase(status->GetLibraryName());
+    ReleaseStreamItem(status);
+    delete status;
+  }
+  m_streamqueue.clear();
+
   // Finish all loading libraries.
   BLI_task_pool_work_and_wait(m_threadinfo.m_pool);
   // Merge all libraries data in the current scene, to avoid memory leak of unmerged scenes.
@@ -378,6 +451,47 @@ static void async_convert(TaskPool *pool, void *ptr, int UNUSED(threadid))
   status->GetConverter()->AddScenesToMergeQueue(status);
 }
 
+static size_t customdata_memory(const CustomData *data, int count)
+{
+  size_t size = 0;
+  for (int i = 0; i < data->totlayer; ++i) {
+    size += (size_t)CustomData_sizeof(data->layers[i].type) * count;
+  }
+  return size;
+}
+
+/** Estimate the memory used by the data of a streamed item, only the geometry and packed
+ * images are counted as they are the bulk of the data of a level.
+ */
+static size_t stream_item_memory(Main *maggie)
+{
+  size_t size = 0;
+
+  for (Mesh *me = (Mesh *)maggie->meshes.first; me; me = (Mesh *)me->id.next) {
+    size += customdata_memory(&me->vdata, me->totvert);
+    size += customdata_memory(&me->edata, me->totedge);
+    size += customdata_memory(&me->fdata, me->totface);
+    size += customdata_memory(&me->ldata, me->totloop);
+    size += customdata_memory(&me->pdata, me->totpoly);
+  }
+
+  for (Image *ima = (Image *)maggie->images.first; ima; ima = (Image *)ima->id.next) {
+    LISTBASE_FOREACH (ImagePackedFile *, imapf, &ima->packedfiles) {
+      if (imapf->packedfile) {
+        size += imapf->packedfile->size;
+      }
+    }
+  }
+
+  return size;
+}
+
+static void async_load_item(TaskPool *pool, void *ptr, int UNUSED(threadid))
+{
+  KX_LibLoadStatus *status = (KX_LibLoadStatus *)ptr;
+  status->GetConverter()->LoadStreamItem(status);
+}
+
 KX_LibLoadStatus *KX_BlenderConverter::LinkBlendFileMemory(void *data,
                                                            int length,
                                                            const char *path,
@@ -457,6 +571,10 @@ KX_LibLoadStatus *KX_BlenderConverter::LinkBlendFile(BlendHandle *bpy_openlib,
   BKE_reports_init(&reports, RPT_STORE);
 
   short flag = 0;  // don't need any special options
+
+  // The streaming workers may be linking.
+  m_linkmutex.Lock();
+
   // created only for linking, then freed
   Main *main_tmp = BLO_library_link_begin(main_newlib, &bpy_openlib, (char *)path);
 
@@ -473,6 +591,8 @@ KX_LibLoadStatus *KX_BlenderConverter::LinkBlendFile(BlendHandle *bpy_openlib,
 
   BLO_library_link_end(main_tmp, &bpy_openlib, flag, main_newlib, nullptr, nullptr, nullptr);
 
+  m_linkmutex.Unlock();
+
   BLO_blendhandle_close(bpy_openlib);
 
   BKE_reports_clear(&reports);
@@ -568,6 +688,8 @@ KX_LibLoadStatus *KX_BlenderConverter::LinkBlendFile(BlendHandle *bpy_openlib,
     }
   }
 
+  InvalidateMemoryStats();
+
   if (!(options & LIB_LOAD_ASYNC)) {
     status->Finish();
   }
@@ -576,6 +698,214 @@ KX_LibLoadStatus *KX_BlenderConverter::LinkBlendFile(BlendHandle *bpy_openlib,
   return status;
 }
 
+KX_LibLoadStatus *KX_BlenderConverter::LinkBlendFileItem(const char *path,
+                                                         const char *group,
+                                                         const char *name,
+                                                         int priority,
+                                                         KX_Scene *scene_merge,
+                                                         char **err_str)
+{
+  const short idcode = BKE_idcode_from_name(group);
+  static char err_local[255];
+
+  if (!ELEM(idcode, ID_ME, ID_MA, ID_GR)) {
+    snprintf(err_local, sizeof(err_local), "invalid ID type given \"%s\"\n", group);
+    *err_str = err_local;
+    return nullptr;
+  }
+
+  if (!BLI_is_file(path)) {
+    snprintf(err_local, sizeof(err_local), "could not open blendfile \"%s\"\n", path);
+    *err_str = err_local;
+    return nullptr;
+  }
+
+  const std::string libname = std::string(path) + "/" + group + "/" + name;
+  if (m_status_map.count(libname) || GetMainDynamicPath(libname)) {
+    snprintf(
+        err_local, sizeof(err_local), "library item already loaded \"%s\"\n", libname.c_str());
+    *err_str = err_local;
+    return nullptr;
+  }
+
+  KX_LibLoadStatus *status = new KX_LibLoadStatus(this, m_ketsjiEngine, scene_merge, libname);
+  status->SetPriority(priority);
+  StreamLibrary *&library = m_streamlibraries[path];
+  if (!library) {
+    library = new StreamLibrary{nullptr, 0};
+  }
+  ++library->users;
+
+  // Deleted in ReleaseStreamItem.
+  status->SetData(new StreamItem{path, idcode, name, library, nullptr, nullptr, 0});
+
+  m_status_map[libname] = status;
+  m_streamqueue.push_back(status);
+
+  UpdateStreaming();
+
+  return status;
+}
+
+void KX_BlenderConverter::LoadStreamItem(KX_LibLoadStatus *status)
+{
+  StreamItem *item = (StreamItem *)status->GetData();
+
+  Main *main_newlib = BKE_main_new();
+  ID *id = nullptr;
+
+  m_linkmutex.Lock();
+
+  BlendHandle *&bpy_openlib = item->library->handle;
+  if (!bpy_openlib) {
+    bpy_openlib = BLO_blendhandle_from_file(item->path.c_str(), nullptr);
+  }
+
+  if (bpy_openlib) {
+    Main *main_tmp = BLO_library_link_begin(main_newlib, &bpy_openlib, item->path.c_str());
+    id = BLO_library_link_named_part(main_tmp, &bpy_openlib, item->idcode, item->name.c_str());
+    // The handle is kept for the next items, unless freed for endian switched files.
+    BLO_library_link_end(main_tmp, &bpy_openlib, 0, main_newlib, nullptr, nullptr, nullptr);
+  }
+
+  m_linkmutex.Unlock();
+
+  item->maggie = main_newlib;
+  item->memory = stream_item_memory(main_newlib);
+  status->AddProgress(0.5f);
+
+  if (id && item->idcode == ID_GR) {
+    // Instance the collection in its own scene to convert the objects like a scene.
+    Scene *scene = BKE_scene_add(main_newlib, item->name.c_str());
+    scene->gm = status->GetMergeScene()->GetBlenderScene()->gm;
+    BKE_collection_child_add(main_newlib, scene->master_collection, (Collection *)id);
+
+    item->scene = status->GetEngine()->CreateScene(scene, true);
+  }
+  status->AddProgress(0.4f);
+
+  m_threadinfo.m_mutex.Lock();
+  m_streammergequeue.push_back(status);
+  m_threadinfo.m_mutex.Unlock();
+}
+
+void KX_BlenderConverter::MergeStreamItem(KX_LibLoadStatus *status)
+{
+  StreamItem *item = (StreamItem *)status->GetData();
+  KX_Scene *scene_merge = status->GetMergeScene();
+  Main *maggie = item->maggie;
+
+  --m_streamrunning;
+
+  BLI_strncpy(maggie->name, status->GetLibraryName().c_str(), sizeof(maggie->name));
+  m_DynamicMaggie.push_back(maggie);
+
+  m_streamitems[maggie] = item->memory;
+  m_streammemory += item->memory;
+
+  if (BLI_listbase_is_empty(which_libbase(maggie, item->idcode))) {
+    CM_Error("could not load \"" << item->name << "\" from library \"" << item->path << "\"");
+  }
+
+  switch (item->idcode) {
+    case ID_ME: {
+      KX_BlenderSceneConverter sceneConverter;
+      for (ID *mesh = (ID *)maggie->meshes.first; mesh; mesh = (ID *)mesh->next) {
+        RAS_MeshObject *meshobj = BL_ConvertMesh((Mesh *)mesh,
+                                                 nullptr,
+                                                 scene_merge,
+                                                 m_ketsjiEngine->GetRasterizer(),
+                                                 sceneConverter,
+                                                 false);
+        scene_merge->GetLogicManager()->RegisterMeshName(meshobj->GetName(), meshobj);
+      }
+      m_sceneSlots[scene_merge].Merge(sceneConverter);
+      break;
+    }
+    case ID_MA: {
+      KX_BlenderSceneConverter sceneConverter;
+      for (ID *mat = (ID *)maggie->materials.first; mat; mat = (ID *)mat->next) {
+        BL_ConvertMaterial(
+            (Material *)mat, scene_merge, m_ketsjiEngine->GetRasterizer(), sceneConverter);
+      }
+      m_sceneSlots[scene_merge].Merge(sceneConverter);
+      break;
+    }
+    case ID_GR: {
+      if (item->scene) {
+        scene_merge->MergeScene(item->scene);
+        delete item->scene;
+      }
+      break;
+    }
+  }
+
+  ReleaseStreamItem(status);
+
+  InvalidateMemoryStats();
+
+  status->Finish();
+}
+
+void KX_BlenderConverter::ReleaseStreamItem(KX_LibLoadStatus *status)
+{
+  StreamItem *item = (StreamItem *)status->GetData();
+  StreamLibrary *library = item->library;
+
+  // No worker uses the library once all its items are merged or cancelled.
+  if (--library->users == 0) {
+    if (library->handle) {
+      BLO_blendhandle_close(library->handle);
+    }
+    m_streamlibraries.erase(item->path);
+    delete library;
+  }
+
+  delete item;
+  status->SetData(nullptr);
+}
+
+void KX_BlenderConverter::UpdateStreaming()
+{
+  const unsigned int maxrunning = BLI_task_scheduler_num_threads(
+      m_ketsjiEngine->GetTaskScheduler());
+
+  /* The memory of an item is known once loaded, the budget is checked before starting each
+   * item and can be exceeded by the items being loaded. */
+  while (!m_streamqueue.empty() && m_streamrunning < maxrunning &&
+         (m_streambudget == 0 || m_streammemory < m_streambudget)) {
+    // Highest priority first, in request order for equal priorities.
+    std::vector<KX_LibLoadStatus *>::iterator it = std::max_element(
+        m_streamqueue.begin(),
+        m_streamqueue.end(),
+        [](KX_LibLoadStatus *status1, KX_LibLoadStatus *status2) {
+          return status1->GetPriority() < status2->GetPriority();
+        });
+
+    KX_LibLoadStatus *status = *it;
+    m_streamqueue.erase(it);
+    ++m_streamrunning;
+
+    BLI_task_pool_push(
+        m_threadinfo.m_pool, async_load_item, (void *)status, false, TASK_PRIORITY_LOW);
+  }
+}
+
+void KX_BlenderConverter::SetStreamBudget(size_t budget)
+{
+  m_streambudget = budget;
+}
+
+size_t KX_BlenderConverter::GetStreamBudget() const
+{
+  return m_streambudget;
+}
+
+size_t KX_BlenderConverter::GetStreamMemory() const
+{
+  return m_streammemory;
+}
+
 /** Note m_map_*** are all ok and don't need to be freed
  * most are temp and NewRemoveObject frees m_map_gameobject_to_blender */
 bool KX_BlenderConverter::FreeBlendFile(Main *maggie)
@@ -651,6 +981,7 @@ bool KX_BlenderConverter::FreeBlendFile(Main *maggie)
           ++it;
         }
       }
+      scene->GetActionPoseCache()->RemoveTaggedActions();
 
       // removed tagged objects and meshes
       CListValue<KX_GameObject> *obj_lists[] = {
@@ -770,16 +1101,317 @@ bool KX_BlenderConverter::FreeBlendFile(Main *maggie)
   delete m_status_map[maggie->name];
   m_status_map.erase(maggie->name);
 
+  std::map<Main *, size_t>::iterator itemit = m_streamitems.find(maggie);
+  if (itemit != m_streamitems.end()) {
+    m_streammemory -= itemit->second;
+    m_streamitems.erase(itemit);
+  }
+
   BKE_main_free(maggie);
 
+  InvalidateMemoryStats();
+
   return true;
 }
 
 bool KX_BlenderConverter::FreeBlendFile(const std::string &path)
 {
+  // Streamed items not loaded yet are just removed from the queue.
+  for (std::vector<KX_LibLoadStatus *>::iterator it = m_streamqueue.begin(),
+                                                 end = m_streamqueue.end();
+       it != end;
+       ++it) {
+    KX_LibLoadStatus *status = *it;
+    if (status->GetLibraryName() == path) {
+      m_status_map.erase(path);
+      m_streamqueue.erase(it);
+      ReleaseStreamItem(status);
+      delete status;
+      return true;
+    }
+  }
+
   return FreeBlendFile(GetMainDynamicPath(path));
 }
 
+static size_t action_memory(bAction *action)
+{
+  size_t size = 0;
+  LISTBASE_FOREACH (FCurve *, fcu, &action->curves) {
+    size += sizeof(FCurve) + fcu->totvert * (fcu->bezt ? sizeof(BezTriple) : sizeof(FPoint));
+  }
+  return size;
+}
+
+static size_t image_memory(Image *ima)
+{
+  // Don't load the images not used yet.
+  if (!BKE_image_has_loaded_ibuf(ima)) {
+    return 0;
+  }
+
+  void *lock;
+  ImBuf *ibuf = BKE_image_acquire_ibuf(ima, nullptr, &lock);
+  const size_t size = ibuf ? IMB_get_size_in_memory(ibuf) : 0;
+  BKE_image_release_ibuf(ima, ibuf, lock);
+
+  return size;
+}
+
+void KX_BlenderConverter::ComputeMemoryStats()
+{
+  m_memorystats.Clear();
+
+  // Library owning each datablock, the datablocks of the main file are not listed.
+  std::unordered_map<void *, const char *> idToLibrary;
+  for (Main *maggie : m_DynamicMaggie) {
+    m_memorystats.m_libraries[maggie->name] = 0;
+
+    ListBase *lbarray[MAX_LIBARRAY];
+    int a = set_listbasepointers(maggie, lbarray);
+    while (a--) {
+      for (ID *id = (ID *)lbarray[a]->first; id; id = (ID *)id->next) {
+        idToLibrary[id] = maggie->name;
+      }
+    }
+  }
+
+  auto findLibrary = [&idToLibrary](void *id) -> const char * {
+    std::unordered_map<void *, const char *>::const_iterator it = idToLibrary.find(id);
+    return (it != idToLibrary.end()) ? it->second : nullptr;
+  };
+
+  // Textures can be shared between the materials of the scenes.
+  std::set<GPUTexture *> textures;
+
+  for (const auto &pair : m_sceneSlots) {
+    const SceneSlot &sceneSlot = pair.second;
+
+    for (const std::unique_ptr<RAS_MeshObject> &meshobj : sceneSlot.m_meshobjects) {
+      const char *library = findLibrary(meshobj->GetOrigMesh());
+      m_memorystats.Add(KX_MemoryStats::mc_meshes, library, meshobj->GetMemorySize());
+
+#ifdef WITH_BULLET
+      // Only the static triangle mesh shapes are shared and registered per mesh.
+      CcdShapeConstructionInfo *shapeInfo = CcdShapeConstructionInfo::FindMesh(
+          meshobj.get(), nullptr, false);
+      if (shapeInfo) {
+        m_memorystats.Add(
+            KX_MemoryStats::mc_physicsShapes, library, shapeInfo->GetMemorySize());
+      }
+#endif
+    }
+
+    for (const std::unique_ptr<KX_BlenderMaterial> &mat : sceneSlot.m_materials) {
+      for (unsigned short i = 0; i < RAS_Texture::MaxUnits; ++i) {
+        RAS_Texture *tex = mat->GetTexture(i);
+        if (!tex || !tex->Ok()) {
+          continue;
+        }
+
+        GPUTexture *gputex = tex->GetGPUTexture();
+        if (gputex && textures.insert(gputex).second) {
+          m_memorystats.Add(KX_MemoryStats::mc_textures,
+                            findLibrary(tex->GetImage()),
+                            GPU_texture_memory_usage(gputex));
+        }
+      }
+    }
+  }
+
+  std::vector<Main *> mains = m_DynamicMaggie;
+  mains.push_back(m_maggie);
+
+  for (Main *maggie : mains) {
+    const char *library = (maggie == m_maggie) ? nullptr : maggie->name;
+
+    for (Image *ima = (Image *)maggie->images.first; ima; ima = (Image *)ima->id.next) {
+      m_memorystats.Add(KX_MemoryStats::mc_images, library, image_memory(ima));
+    }
+
+    for (bAction *action = (bAction *)maggie->actions.first; action;
+         action = (bAction *)action->id.next) {
+      m_memorystats.Add(KX_MemoryStats::mc_actions, library, action_memory(action));
+    }
+  }
+
+  m_memorystatsvalid = true;
+}
+
+const KX_MemoryStats &KX_BlenderConverter::GetMemoryStats(bool update)
+{
+  if (update || !m_memorystatsvalid) {
+    ComputeMemoryStats();
+  }
+
+  /* Replicas are counted by the scenes, each one is a game object, its scene graph node and
+   * a copy of its blender object. */
+  size_t numReplicas = 0;
+  for (KX_Scene *scene : m_ketsjiEngine->CurrentScenes()) {
+    numReplicas += scene->GetNumReplicas();
+  }
+  m_memorystats.m_categories[KX_MemoryStats::mc_replicas] = numReplicas * (sizeof(KX_GameObject) +
+                                                                           sizeof(SG_Node) +
+                                                                           sizeof(Object));
+
+  return m_memorystats;
+}
+
+void KX_BlenderConverter::InvalidateMemoryStats()
+{
+  m_memorystatsvalid = false;
+}
+
+void KX_BlenderConverter::SetMemoryBudget(size_t budget)
+{
+  m_memorybudget = budget;
+  m_memorybudgetexceeded = false;
+}
+
+size_t KX_BlenderConverter::GetMemoryBudget() const
+{
+  return m_memorybudget;
+}
+
+static void collect_id(std::set<ID *> &ids, void *id)
+{
+  if (id) {
+    ids.insert((ID *)id);
+  }
+}
+
+void KX_BlenderConverter::CollectReferencedData()
+{
+  m_referencedids.clear();
+
+  for (KX_Scene *scene : m_ketsjiEngine->CurrentScenes()) {
+    collect_id(m_referencedids, scene->GetBlenderScene());
+
+    for (KX_GameObject *gameobj : scene->GetObjectList()) {
+      collect_id(m_referencedids, gameobj->GetBlenderObject());
+
+      for (unsigned short i = 0, size = gameobj->GetMeshCount(); i < size; ++i) {
+        RAS_MeshObject *mesh = gameobj->GetMesh(i);
+        collect_id(m_referencedids, mesh->GetOrigMesh());
+
+        for (int mat_index = 0, nummat = mesh->NumMaterials(); mat_index < nummat; ++mat_index) {
+          collect_id(m_referencedids,
+                     mesh->GetMeshMaterial(mat_index)
+                         ->GetBucket()
+                         ->GetPolyMaterial()
+                         ->GetBlenderMaterial());
+        }
+      }
+
+      gameobj->CollectActions(m_referencedids);
+      for (SCA_IActuator *actuator : gameobj->GetActuators()) {
+        if (actuator->IsType(SCA_IActuator::KX_ACT_ACTION)) {
+          collect_id(m_referencedids, static_cast<BL_ActionActuator *>(actuator)->GetAction());
+        }
+      }
+    }
+
+    // Meshes only registered by name, as the streamed ones, are used by replaceMesh later.
+    for (const std::pair<const std::string, void *> &pair :
+         scene->GetLogicManager()->GetMeshMap()) {
+      RAS_MeshObject *meshobj = (RAS_MeshObject *)pair.second;
+      if (meshobj) {
+        collect_id(m_referencedids, meshobj->GetOrigMesh());
+      }
+    }
+  }
+}
+
+bool KX_BlenderConverter::IsLibraryReferenced(Main *maggie)
+{
+  for (ListBase *lb : {&maggie->scenes,
+                       &maggie->objects,
+                       &maggie->meshes,
+                       &maggie->materials,
+                       &maggie->actions}) {
+    LISTBASE_FOREACH (ID *, id, lb) {
+      if (m_referencedids.count(id)) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+/// Seconds between two memory budget checks while nothing can be freed.
+#define MEMORY_BUDGET_CHECK_INTERVAL 1.0
+
+void KX_BlenderConverter::UpdateMemoryBudget()
+{
+  if (m_memorybudget == 0) {
+    return;
+  }
+
+  /* Nothing could be freed at the last check. The libraries become unreferenced when the
+   * objects using them are removed, so check again once the data changed or after a delay. */
+  const double time = PIL_check_seconds_timer();
+  if (m_memorybudgetexceeded && m_memorystatsvalid &&
+      (time - m_memorybudgettime) < MEMORY_BUDGET_CHECK_INTERVAL) {
+    return;
+  }
+
+  const KX_MemoryStats &stats = GetMemoryStats(false);
+  if (stats.GetTotal() <= m_memorybudget) {
+    m_memorybudgetexceeded = false;
+    return;
+  }
+
+  m_memorybudgettime = time;
+  CollectReferencedData();
+
+  // Try to free the libraries from the largest to the smallest.
+  std::vector<std::pair<size_t, std::string>> libraries;
+  for (const auto &pair : stats.m_libraries) {
+    libraries.emplace_back(pair.second, pair.first);
+  }
+  std::sort(libraries.rbegin(), libraries.rend());
+
+  for (const std::pair<size_t, std::string> &library : libraries) {
+    Main *maggie = GetMainDynamicPath(library.second);
+    const std::map<std::string, KX_LibLoadStatus *>::iterator it = m_status_map.find(
+        library.second);
+    // Libraries being loaded can't be freed.
+    if (!maggie || (it != m_status_map.end() && !it->second->IsFinished()) ||
+        IsLibraryReferenced(maggie)) {
+      continue;
+    }
+
+    CM_Message("memory budget exceeded, freeing unreferenced library \""
+               << library.second << "\" (" << library.first << " bytes)");
+    FreeBlendFile(maggie);
+
+    if (GetMemoryStats(false).GetTotal() <= m_memorybudget) {
+      return;
+    }
+
+    // Freeing removed objects and can make other libraries unreferenced.
+    CollectReferencedData();
+  }
+
+  // Report once the libraries responsible for the exceeded budget.
+  if (!m_memorybudgetexceeded) {
+    m_memorybudgetexceeded = true;
+
+    const KX_MemoryStats &remaining = GetMemoryStats(false);
+    CM_Warning("memory budget of " << m_memorybudget << " bytes exceeded, "
+                                   << remaining.GetTotal() << " bytes used");
+    for (unsigned short i = KX_MemoryStats::mc_first; i < KX_MemoryStats::mc_numCategories;
+         ++i) {
+      CM_Warning("\t" << KX_MemoryStats::m_categoryLabels[i] << ": "
+                      << remaining.m_categories[i]);
+    }
+    for (const auto &pair : remaining.m_libraries) {
+      CM_Warning("\tlibrary \"" << pair.first << "\": " << pair.second);
+    }
+  }
+}
+
 void KX_BlenderConverter::MergeScene(KX_Scene *to, KX_Scene *from)
 {
   SceneSlot &sceneSlotFrom = m_sceneSlots[from];
@@ -880,6 +1512,8 @@ RAS_MeshObject *KX_BlenderConverter::ConvertMeshSpecial(KX_Scene *kx_scene,
 
   m_sceneSlots[kx_scene].Merge(sceneConverter);
 
+  InvalidateMemoryStats();
+
   return meshobj;
 }
 
@@ -33,6 +33,7 @@
 #define __KX_BLENDERCONVERTER_H__
 
 #include <map>
+#include <set>
 #include <vector>
 
 #ifdef _MSC_VER  // MSVC doesn't support incomplete type in std::unique_ptr.
@@ -44,6 +45,8 @@
 
 #include "CM_Thread.h"
 
+#include "KX_MemoryStats.h"
+
 class CStringValue;
 class KX_BlenderSceneConverter;
 class KX_KetsjiEngine;
@@ -54,6 +57,7 @@ class SCA_IActuator;
 class SCA_IController;
 class RAS_MeshObject;
 class RAS_Rasterizer;
+struct ID;
 struct Main;
 struct BlendHandle;
 struct Mesh;
@@ -63,6 +67,7 @@ struct bAction;
 struct bActuator;
 struct bController;
 struct TaskPool;
+struct StreamLibrary;
 struct Depsgraph;
 
 template<class Value> using UniquePtrList = std::vector<std::unique_ptr<Value>>;
@@ -96,12 +101,53 @@ class KX_BlenderConverter {
   std::map<std::string, KX_LibLoadStatus *> m_status_map;
   std::vector<KX_LibLoadStatus *> m_mergequeue;
 
+  /// Streamed library items waiting for a worker, see LinkBlendFileItem.
+  std::vector<KX_LibLoadStatus *> m_streamqueue;
+  /// Streamed library items loaded by the workers and waiting to be merged.
+  std::vector<KX_LibLoadStatus *> m_streammergequeue;
+  /// Number of streamed items being loaded by the workers.
+  unsigned int m_streamrunning;
+  /// Estimated memory of the loaded streamed items and the budget they can use, 0 for no budget.
+  size_t m_streammemory;
+  size_t m_streambudget;
+  /// Library linking is not reentrant, the workers and the main thread link one at a time.
+  CM_ThreadMutex m_linkmutex;
+  /// Libraries of the streamed items, opened once for all their items.
+  std::map<std::string, StreamLibrary *> m_streamlibraries;
+
   Main *m_maggie;
   std::vector<Main *> m_DynamicMaggie;
 
+  /// Estimated memory of the loaded streamed items.
+  std::map<Main *, size_t> m_streamitems;
+
+  KX_MemoryStats m_memorystats;
+  /// The memory statistics must be computed again after a conversion or a free.
+  bool m_memorystatsvalid;
+  /// Memory the converted data can use before unreferenced libraries are freed, 0 for no budget.
+  size_t m_memorybudget;
+  bool m_memorybudgetexceeded;
+  /// Time of the last budget check which couldn't free enough.
+  double m_memorybudgettime;
+  /** Data used by the active scenes, of the main file and the libraries. Kept apart from the ID
+   * tags which are used by FreeBlendFile to select the data to free.
+   */
+  std::set<ID *> m_referencedids;
+
   KX_KetsjiEngine *m_ketsjiEngine;
   bool m_alwaysUseExpandFraming;
 
+  /// Convert a streamed item loaded by a worker into its merge scene.
+  void MergeStreamItem(KX_LibLoadStatus *status);
+  /// Free the item of a merged or cancelled streamed item and close its unused library.
+  void ReleaseStreamItem(KX_LibLoadStatus *status);
+
+  void ComputeMemoryStats();
+  /// Collect the data used by the active scenes, once for all libraries.
+  void CollectReferencedData();
+  /// Return true if the collected data includes data of a library, see CollectReferencedData.
+  bool IsLibraryReferenced(Main *maggie);
+
  public:
   KX_BlenderConverter(Main *maggie, KX_KetsjiEngine *engine);
   virtual ~KX_BlenderConverter();
@@ -147,9 +193,39 @@ class KX_BlenderConverter {
                                   char **err_str,
                                   short options);
 
+  /** Queue the loading of a single mesh, material or collection of a library, it is linked
+   * and converted by the workers in order of priority while the memory budget allows it.
+   * The item is stored in its own Main named "path/group/name" to be freed independently.
+   */
+  KX_LibLoadStatus *LinkBlendFileItem(const char *path,
+                                      const char *group,
+                                      const char *name,
+                                      int priority,
+                                      KX_Scene *scene_merge,
+                                      char **err_str);
+  /// Link and convert a streamed item, called by the workers.
+  void LoadStreamItem(KX_LibLoadStatus *status);
+  /// Start the loading of the queued streamed items of highest priority.
+  void UpdateStreaming();
+
+  void SetStreamBudget(size_t budget);
+  size_t GetStreamBudget() const;
+  size_t GetStreamMemory() const;
+
   bool FreeBlendFile(Main *maggie);
   bool FreeBlendFile(const std::string &path);
 
+  /** Return the memory used by the converted data, computed again if invalid or when update
+   * is true to include the data created after the conversion like image buffers.
+   */
+  const KX_MemoryStats &GetMemoryStats(bool update);
+  void InvalidateMemoryStats();
+
+  void SetMemoryBudget(size_t budget);
+  size_t GetMemoryBudget() const;
+  /// Free the unreferenced libraries, largest first, while the memory budget is exceeded.
+  void UpdateMemoryBudget();
+
   RAS_MeshObject *ConvertMeshSpecial(KX_Scene *kx_scene, Main *maggie, const std::string &name);
 
   void MergeScene(KX_Scene *to, KX_Scene *from);
@@ -785,8 +785,7 @@ void BL_ConvertActuators(const char *maggiename,
 
         unsigned long seedArg = randAct->seed;
         if (seedArg == 0) {
-          seedArg = (int)(ketsjiEngine->GetRealTime() * 100000.0);
-          seedArg ^= (intptr_t)randAct;
+          seedArg = ketsjiEngine->GenerateRandomSeed((intptr_t)randAct);
         }
         SCA_RandomActuator::KX_RANDOMACT_MODE modeArg = SCA_RandomActuator::KX_RANDOMACT_NODEF;
         SCA_RandomActuator *tmprandomact;
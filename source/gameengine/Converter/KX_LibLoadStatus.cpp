@@ -27,6 +27,8 @@
 #include "KX_LibLoadStatus.h"
 #include "PIL_time.h"
 
+#include <climits>
+
 KX_LibLoadStatus::KX_LibLoadStatus(class KX_BlenderConverter *kx_converter,
                                    class KX_KetsjiEngine *kx_engine,
                                    class KX_Scene *merge_scene,
@@ -37,6 +39,7 @@ KX_LibLoadStatus::KX_LibLoadStatus(class KX_BlenderConverter *kx_converter,
       m_data(nullptr),
       m_libname(path),
       m_progress(0.0f),
+      m_priority(0),
       m_finished(false)
 #ifdef WITH_PYTHON
       ,
@@ -109,6 +112,11 @@ class KX_Scene *KX_LibLoadStatus::GetMergeScene()
   return m_mergescene;
 }
 
+const std::string &KX_LibLoadStatus::GetLibraryName() const
+{
+  return m_libname;
+}
+
 void KX_LibLoadStatus::SetData(void *data)
 {
   m_data = data;
@@ -136,6 +144,16 @@ void KX_LibLoadStatus::AddProgress(float progress)
   RunProgressCallback();
 }
 
+void KX_LibLoadStatus::SetPriority(int priority)
+{
+  m_priority = priority;
+}
+
+int KX_LibLoadStatus::GetPriority() const
+{
+  return m_priority;
+}
+
 #ifdef WITH_PYTHON
 
 PyMethodDef KX_LibLoadStatus::Methods[] = {
@@ -149,6 +167,7 @@ PyAttributeDef KX_LibLoadStatus::Attributes[] = {
     // pyattr_set_onprogress),
     KX_PYATTRIBUTE_FLOAT_RO("progress", KX_LibLoadStatus, m_progress),
     KX_PYATTRIBUTE_STRING_RO("libraryName", KX_LibLoadStatus, m_libname),
+    KX_PYATTRIBUTE_INT_RW("priority", INT_MIN, INT_MAX, true, KX_LibLoadStatus, m_priority),
     KX_PYATTRIBUTE_RO_FUNCTION("timeTaken", KX_LibLoadStatus, pyattr_get_timetaken),
     KX_PYATTRIBUTE_BOOL_RO("finished", KX_LibLoadStatus, m_finished),
     KX_PYATTRIBUTE_NULL  // Sentinel
@@ -37,6 +37,8 @@ class KX_LibLoadStatus : public PyObjectPlus {
   std::string m_libname;
 
   float m_progress;
+  /// Order of the streamed libraries waiting to be loaded, highest first.
+  int m_priority;
   double m_starttime;
   double m_endtime;
 
@@ -61,6 +63,7 @@ class KX_LibLoadStatus : public PyObjectPlus {
   class KX_BlenderConverter *GetConverter();
   class KX_KetsjiEngine *GetEngine();
   class KX_Scene *GetMergeScene();
+  const std::string &GetLibraryName() const;
 
   void SetData(void *data);
   void *GetData();
@@ -74,6 +77,9 @@ class KX_LibLoadStatus : public PyObjectPlus {
   float GetProgress();
   void AddProgress(float progress);
 
+  void SetPriority(int priority);
+  int GetPriority() const;
+
 #ifdef WITH_PYTHON
   static PyObject *pyattr_get_onfinish(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
   static int pyattr_set_onfinish(PyObjectPlus *self_v,
@@ -0,0 +1,64 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Converter/KX_MemoryStats.cpp
+ *  \ingroup bgeconv
+ */
+
+#include "KX_MemoryStats.h"
+
+const std::string KX_MemoryStats::m_categoryLabels[KX_MemoryStats::mc_numCategories] = {
+    "Meshes",          // mc_meshes
+    "Physics Shapes",  // mc_physicsShapes
+    "Textures",        // mc_textures
+    "Images",          // mc_images
+    "Actions",         // mc_actions
+    "Replicas",        // mc_replicas
+};
+
+KX_MemoryStats::KX_MemoryStats()
+{
+  Clear();
+}
+
+void KX_MemoryStats::Clear()
+{
+  for (unsigned short i = mc_first; i < mc_numCategories; ++i) {
+    m_categories[i] = 0;
+  }
+  m_libraries.clear();
+}
+
+void KX_MemoryStats::Add(Category category, const char *library, size_t size)
+{
+  m_categories[category] += size;
+  if (library) {
+    m_libraries[library] += size;
+  }
+}
+
+size_t KX_MemoryStats::GetTotal() const
+{
+  size_t total = 0;
+  for (unsigned short i = mc_first; i < mc_numCategories; ++i) {
+    total += m_categories[i];
+  }
+  return total;
+}
@@ -0,0 +1,58 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_MemoryStats.h
+ *  \ingroup bgeconv
+ */
+
+#ifndef __KX_MEMORYSTATS_H__
+#define __KX_MEMORYSTATS_H__
+
+#include <map>
+#include <string>
+
+/// Estimated memory used by the game engine data, by category and by library.
+struct KX_MemoryStats {
+  enum Category {
+    mc_first = 0,
+    mc_meshes = 0,
+    mc_physicsShapes,
+    mc_textures,
+    mc_images,
+    mc_actions,
+    mc_replicas,
+    mc_numCategories
+  };
+
+  static const std::string m_categoryLabels[mc_numCategories];
+
+  size_t m_categories[mc_numCategories];
+  /// Memory of the data of each library loaded with LibLoad, the main file isn't included.
+  std::map<std::string, size_t> m_libraries;
+
+  KX_MemoryStats();
+
+  void Clear();
+  /// Account memory of a category, library is nullptr for the data of the main file.
+  void Add(Category category, const char *library, size_t size);
+  size_t GetTotal() const;
+};
+
+#endif  // __KX_MEMORYSTATS_H__
@@ -46,6 +46,11 @@ class SCA_AlwaysSensor : public SCA_ISensor {
   virtual bool Evaluate();
   virtual bool IsPositiveTrigger();
   virtual void Init();
+
+  virtual sensortype GetSensorType()
+  {
+    return ST_ALWAYS;
+  }
 };
 
 #endif /* __SCA_ALWAYSSENSOR_H__ */
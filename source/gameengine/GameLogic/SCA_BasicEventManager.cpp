@@ -36,6 +36,12 @@
 #include "SCA_BasicEventManager.h"
 #include "SCA_LogicManager.h"
 #include "SCA_ISensor.h"
+#include "SCA_AlwaysSensor.h"
+#include "SCA_PropertySensor.h"
+
+#include "BLI_utildefines.h"
+
+#include <algorithm>
 
 SCA_BasicEventManager::SCA_BasicEventManager(class SCA_LogicManager *logicmgr)
     : SCA_EventManager(logicmgr, BASIC_EVENTMGR)
@@ -46,9 +52,48 @@ SCA_BasicEventManager::~SCA_BasicEventManager()
 {
 }
 
+bool SCA_BasicEventManager::RegisterSensor(SCA_ISensor *sensor)
+{
+  if (!SCA_EventManager::RegisterSensor(sensor)) {
+    return false;
+  }
+
+  m_entries.push_back({sensor, sensor->GetSensorType()});
+  return true;
+}
+
+bool SCA_BasicEventManager::RemoveSensor(SCA_ISensor *sensor)
+{
+  if (!SCA_EventManager::RemoveSensor(sensor)) {
+    return false;
+  }
+
+  std::vector<SensorEntry>::iterator it = std::find_if(
+      m_entries.begin(), m_entries.end(), [sensor](const SensorEntry &entry) {
+        return entry.m_sensor == sensor;
+      });
+  BLI_assert(it != m_entries.end());
+  m_entries.erase(it);
+  return true;
+}
+
 void SCA_BasicEventManager::NextFrame()
 {
-  for (SCA_ISensor *sensor : m_sensors) {
-    sensor->Activate(m_logicmgr);
+  // Keep the registration order, it defines the order of the triggered controllers.
+  for (const SensorEntry &entry : m_entries) {
+    switch (entry.m_type) {
+      case SCA_ISensor::ST_ALWAYS: {
+        entry.m_sensor->ActivateNative<SCA_AlwaysSensor>(m_logicmgr);
+        break;
+      }
+      case SCA_ISensor::ST_PROPERTY: {
+        entry.m_sensor->ActivateNative<SCA_PropertySensor>(m_logicmgr);
+        break;
+      }
+      default: {
+        entry.m_sensor->Activate(m_logicmgr);
+        break;
+      }
+    }
   }
 }
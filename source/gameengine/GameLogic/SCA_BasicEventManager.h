@@ -36,12 +36,26 @@
 #define __SCA_BASICEVENTMANAGER_H__
 
 #include "SCA_EventManager.h"
+#include "SCA_ISensor.h"
 
 class SCA_BasicEventManager : public SCA_EventManager {
+ private:
+  /// A sensor with its type tag, used to evaluate the native sensors without virtual calls.
+  struct SensorEntry {
+    SCA_ISensor *m_sensor;
+    SCA_ISensor::sensortype m_type;
+  };
+
+  /// The sensors of m_sensors with their type, in registration order.
+  std::vector<SensorEntry> m_entries;
+
  public:
   SCA_BasicEventManager(class SCA_LogicManager *logicmgr);
   ~SCA_BasicEventManager();
 
+  virtual bool RegisterSensor(SCA_ISensor *sensor);
+  virtual bool RemoveSensor(SCA_ISensor *sensor);
+
   virtual void NextFrame();
 };
 
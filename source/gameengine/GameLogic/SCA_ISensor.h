@@ -96,6 +96,9 @@ class SCA_ISensor : public SCA_ILogicBrick {
     ST_TOUCH,
     ST_NEAR,
     ST_RADAR,
+    ST_ALWAYS,
+    ST_PROPERTY,
+    ST_KEYBOARD,
     // to be updated as needed
   };
 
@@ -109,6 +112,20 @@ class SCA_ISensor : public SCA_ILogicBrick {
   /* level of individual sensors. Mapping the old activate()s is easy.     */
   /* The IsPosTrig() also has to change, to keep things consistent.        */
   void Activate(SCA_LogicManager *logicmgr);
+
+  /** Same as Activate but with the evaluation functions of the final sensor class
+   * resolved at compile time, used by the event managers for the common native sensors
+   * to avoid two virtual calls per sensor and per frame.
+   */
+  template <class Sensor> void ActivateNative(SCA_LogicManager *logicmgr)
+  {
+    if (m_links && !m_suspended) {
+      Sensor *sensor = static_cast<Sensor *>(this);
+      const bool result = sensor->Sensor::Evaluate();
+      ProcessTrigger(logicmgr, result, sensor->Sensor::IsPositiveTrigger());
+    }
+  }
+
   virtual bool Evaluate() = 0;
   virtual bool IsPositiveTrigger();
   virtual void Init();
@@ -135,6 +152,12 @@ class SCA_ISensor : public SCA_ILogicBrick {
   void UnlinkController(SCA_IController *controller);
   void UnlinkAllControllers();
   void ActivateControllers(SCA_LogicManager *logicmgr);
+  /** Update the sensor state and trigger the linked controllers according to the
+   * pulse, tap and level options.
+   * \param result The result of Evaluate.
+   * \param positive The result of IsPositiveTrigger.
+   */
+  void ProcessTrigger(SCA_LogicManager *logicmgr, bool result, bool positive);
 
   virtual void ProcessReplica();
 
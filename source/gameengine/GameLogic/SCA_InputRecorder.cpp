@@ -0,0 +1,365 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/GameLogic/SCA_InputRecorder.cpp
+ *  \ingroup gamelogic
+ */
+
+#include "SCA_InputRecorder.h"
+
+#include "CM_Message.h"
+
+#include <cstring>
+#include <stdint.h>
+
+static const char recorderMagic[8] = {'B', 'G', 'E', 'I', 'N', 'P', 'U', 'T'};
+static const uint32_t recorderVersion = 1;
+
+SCA_InputRecorder::SCA_InputRecorder(const std::string &filepath, Mode mode)
+    : m_mode(mode), m_valid(false), m_finished(false), m_frameCount(0)
+{
+  for (unsigned short i = 0; i < SCA_IInputDevice::MAX_KEYS; ++i) {
+    m_lastStates[i] = {SCA_InputEvent::NONE, 0, 0};
+  }
+
+  if (m_mode == RECORD) {
+    m_stream.open(filepath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (m_stream.is_open()) {
+      WriteHeader();
+      m_valid = m_stream.good();
+    }
+  }
+  else {
+    m_stream.open(filepath, std::ios::in | std::ios::binary);
+    if (m_stream.is_open()) {
+      m_valid = ReadHeader();
+    }
+  }
+
+  if (!m_valid) {
+    CM_Error("input recorder: failed to " << ((m_mode == RECORD) ? "create" : "read")
+                                          << " file \"" << filepath << "\"");
+  }
+}
+
+SCA_InputRecorder::~SCA_InputRecorder()
+{
+  if (m_stream.is_open()) {
+    m_stream.close();
+  }
+}
+
+void SCA_InputRecorder::WriteHeader()
+{
+  m_stream.write(recorderMagic, sizeof(recorderMagic));
+  Write(recorderVersion);
+  Write((uint32_t)SCA_IInputDevice::MAX_KEYS);
+}
+
+bool SCA_InputRecorder::ReadHeader()
+{
+  char magic[sizeof(recorderMagic)];
+  m_stream.read(magic, sizeof(magic));
+  if (!m_stream.good() || memcmp(magic, recorderMagic, sizeof(magic)) != 0) {
+    return false;
+  }
+
+  uint32_t version;
+  uint32_t maxkeys;
+  if (!Read(version) || !Read(maxkeys)) {
+    return false;
+  }
+
+  if (version != recorderVersion || maxkeys != SCA_IInputDevice::MAX_KEYS) {
+    CM_Error("input recorder: incompatible recording, version " << version);
+    return false;
+  }
+
+  return true;
+}
+
+bool SCA_InputRecorder::ReadChunkTag(ChunkType chunk)
+{
+  if (m_stream.peek() != chunk) {
+    return false;
+  }
+
+  m_stream.get();
+  return true;
+}
+
+SCA_InputRecorder::Mode SCA_InputRecorder::GetMode() const
+{
+  return m_mode;
+}
+
+bool SCA_InputRecorder::IsValid() const
+{
+  return m_valid;
+}
+
+bool SCA_InputRecorder::IsFinished() const
+{
+  return m_finished;
+}
+
+unsigned int SCA_InputRecorder::GetFrameCount() const
+{
+  return m_frameCount;
+}
+
+long SCA_InputRecorder::ProcessSeed(long seed)
+{
+  m_mutex.Lock();
+  const long result = ProcessSeedChunk(seed);
+  m_mutex.Unlock();
+
+  return result;
+}
+
+long SCA_InputRecorder::ProcessSeedChunk(long seed)
+{
+  if (!m_valid) {
+    return seed;
+  }
+
+  if (m_mode == RECORD) {
+    m_stream.put(CHUNK_SEED);
+    Write((int64_t)seed);
+    return seed;
+  }
+
+  int64_t recordedSeed;
+  if (ReadChunkTag(CHUNK_SEED) && Read(recordedSeed)) {
+    return (long)recordedSeed;
+  }
+
+  CM_Warning("input recorder: no recorded seed at frame " << m_frameCount
+                                                           << ", the replay diverged");
+  return seed;
+}
+
+bool SCA_InputRecorder::ProcessClock(double &clockTime, double &timeStep)
+{
+  m_mutex.Lock();
+  const bool result = ProcessClockChunk(clockTime, timeStep);
+  m_mutex.Unlock();
+
+  return result;
+}
+
+bool SCA_InputRecorder::ProcessClockChunk(double &clockTime, double &timeStep)
+{
+  if (!m_valid || m_finished) {
+    return false;
+  }
+
+  if (m_mode == RECORD) {
+    m_stream.put(CHUNK_CLOCK);
+    Write(clockTime);
+    Write(timeStep);
+    return true;
+  }
+
+  if (!ReadChunkTag(CHUNK_CLOCK) || !Read(clockTime) || !Read(timeStep)) {
+    m_finished = true;
+    return false;
+  }
+
+  return true;
+}
+
+bool SCA_InputRecorder::IsInputModified(const SCA_InputEvent &event) const
+{
+  const InputState &state = m_lastStates[event.m_type];
+  return (event.m_status.size() > 1 || event.m_values.size() > 1 || !event.m_queue.empty() ||
+          event.m_status.back() != state.m_status || event.m_values.back() != state.m_value ||
+          event.m_unicode != state.m_unicode);
+}
+
+void SCA_InputRecorder::WriteInput(unsigned short index, const SCA_InputEvent &event)
+{
+  Write((uint16_t)index);
+
+  Write((uint16_t)event.m_status.size());
+  for (SCA_InputEvent::SCA_EnumInputs status : event.m_status) {
+    Write((uint8_t)status);
+  }
+
+  Write((uint16_t)event.m_queue.size());
+  for (SCA_InputEvent::SCA_EnumInputs queue : event.m_queue) {
+    Write((uint8_t)queue);
+  }
+
+  Write((uint16_t)event.m_values.size());
+  for (int value : event.m_values) {
+    Write((int32_t)value);
+  }
+
+  Write((uint32_t)event.m_unicode);
+}
+
+bool SCA_InputRecorder::ReadInput(SCA_IInputDevice *device)
+{
+  uint16_t index;
+  if (!Read(index) || index >= SCA_IInputDevice::MAX_KEYS) {
+    return false;
+  }
+
+  SCA_InputEvent &event = device->GetInput((SCA_IInputDevice::SCA_EnumInputs)index);
+
+  uint16_t size;
+  uint8_t status;
+  int32_t value;
+  uint32_t unicode;
+
+  if (!Read(size) || size == 0) {
+    return false;
+  }
+  event.m_status.clear();
+  for (uint16_t i = 0; i < size; ++i) {
+    if (!Read(status)) {
+      return false;
+    }
+    event.m_status.push_back((SCA_InputEvent::SCA_EnumInputs)status);
+  }
+
+  if (!Read(size)) {
+    return false;
+  }
+  event.m_queue.clear();
+  for (uint16_t i = 0; i < size; ++i) {
+    if (!Read(status)) {
+      return false;
+    }
+    event.m_queue.push_back((SCA_InputEvent::SCA_EnumInputs)status);
+  }
+
+  if (!Read(size) || size == 0) {
+    return false;
+  }
+  event.m_values.clear();
+  for (uint16_t i = 0; i < size; ++i) {
+    if (!Read(value)) {
+      return false;
+    }
+    event.m_values.push_back(value);
+  }
+
+  if (!Read(unicode)) {
+    return false;
+  }
+  event.m_unicode = unicode;
+
+  return true;
+}
+
+bool SCA_InputRecorder::ProcessInputs(SCA_IInputDevice *device)
+{
+  m_mutex.Lock();
+  const bool result = ProcessInputsChunk(device);
+  m_mutex.Unlock();
+
+  return result;
+}
+
+bool SCA_InputRecorder::ProcessInputsChunk(SCA_IInputDevice *device)
+{
+  if (!m_valid || m_finished) {
+    return false;
+  }
+
+  if (m_mode == RECORD) {
+    uint16_t numModified = 0;
+    for (unsigned short i = 0; i < SCA_IInputDevice::MAX_KEYS; ++i) {
+      if (IsInputModified(device->GetInput((SCA_IInputDevice::SCA_EnumInputs)i))) {
+        ++numModified;
+      }
+    }
+
+    m_stream.put(CHUNK_INPUT);
+    Write(numModified);
+    for (unsigned short i = 0; i < SCA_IInputDevice::MAX_KEYS; ++i) {
+      const SCA_InputEvent &event = device->GetInput((SCA_IInputDevice::SCA_EnumInputs)i);
+      if (IsInputModified(event)) {
+        WriteInput(i, event);
+      }
+    }
+
+    const std::wstring &text = device->GetText();
+    Write((uint16_t)text.size());
+    for (wchar_t c : text) {
+      Write((uint32_t)c);
+    }
+  }
+  else {
+    uint16_t numModified;
+    if (!ReadChunkTag(CHUNK_INPUT) || !Read(numModified)) {
+      m_finished = true;
+      return false;
+    }
+
+    /* Discard any input received from the system since the last frame, the inputs are
+     * reset to the state they had at the end of the recorded previous frame. */
+    for (unsigned short i = 0; i < SCA_IInputDevice::MAX_KEYS; ++i) {
+      SCA_InputEvent &event = device->GetInput((SCA_IInputDevice::SCA_EnumInputs)i);
+      const InputState &state = m_lastStates[i];
+      event.m_status.assign(1, state.m_status);
+      event.m_values.assign(1, state.m_value);
+      event.m_queue.clear();
+      event.m_unicode = state.m_unicode;
+    }
+
+    for (uint16_t i = 0; i < numModified; ++i) {
+      if (!ReadInput(device)) {
+        CM_Error("input recorder: corrupted input chunk at frame " << m_frameCount);
+        m_finished = true;
+        return false;
+      }
+    }
+
+    uint16_t textSize;
+    if (!Read(textSize)) {
+      m_finished = true;
+      return false;
+    }
+    std::wstring text;
+    for (uint16_t i = 0; i < textSize; ++i) {
+      uint32_t c;
+      if (!Read(c)) {
+        m_finished = true;
+        return false;
+      }
+      text += (wchar_t)c;
+    }
+    device->SetText(text);
+  }
+
+  for (unsigned short i = 0; i < SCA_IInputDevice::MAX_KEYS; ++i) {
+    const SCA_InputEvent &event = device->GetInput((SCA_IInputDevice::SCA_EnumInputs)i);
+    m_lastStates[i] = {event.m_status.back(), event.m_values.back(), event.m_unicode};
+  }
+
+  ++m_frameCount;
+
+  return true;
+}
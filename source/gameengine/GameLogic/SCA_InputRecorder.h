@@ -0,0 +1,132 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file SCA_InputRecorder.h
+ *  \ingroup gamelogic
+ *  \brief Record and replay of the per logic frame input state, clock time and
+ * random seeds to a binary stream, used to replay a play session as a benchmark.
+ */
+
+#ifndef __SCA_INPUTRECORDER_H__
+#define __SCA_INPUTRECORDER_H__
+
+#include "SCA_IInputDevice.h"
+
+#include "CM_Thread.h"
+
+#include <fstream>
+#include <string>
+
+/** The stream is a header followed by a sequence of chunks:
+ *   - SEED: a random seed generated by the engine (random actuators and sensors without a
+ *     user seed, python random).
+ *   - CLOCK: the clock time and time step computed for a render frame.
+ *   - INPUT: the inputs modified during a logic frame, only the inputs which differ from the
+ *     cleared state of the previous frame are written.
+ * Chunks are written and read in the same order as the engine requests them, so a replay
+ * following the same logic paths consumes the stream exactly as it was produced.
+ */
+class SCA_InputRecorder {
+ public:
+  enum Mode { RECORD = 0, REPLAY };
+
+ private:
+  enum ChunkType { CHUNK_SEED = 'S', CHUNK_CLOCK = 'C', CHUNK_INPUT = 'I' };
+
+  /// Last status and value of an input after a logic frame, used to detect modified inputs.
+  struct InputState {
+    SCA_InputEvent::SCA_EnumInputs m_status;
+    int m_value;
+    unsigned int m_unicode;
+  };
+
+  Mode m_mode;
+  std::fstream m_stream;
+  /// Protect the stream, seeds are requested by the async libload conversion threads too.
+  CM_ThreadMutex m_mutex;
+  /// True when the file was opened and the header is valid.
+  bool m_valid;
+  /// True when the replay reached the end of the stream.
+  bool m_finished;
+  /// Number of logic frames recorded or replayed.
+  unsigned int m_frameCount;
+
+  /// Input states at the end of the previous logic frame.
+  InputState m_lastStates[SCA_IInputDevice::MAX_KEYS];
+
+  void WriteHeader();
+  bool ReadHeader();
+
+  /** Return true if the next chunk in the stream is of type chunk and consume its tag, else
+   * leave the stream unchanged.
+   */
+  bool ReadChunkTag(ChunkType chunk);
+
+  template <class T> void Write(const T &value)
+  {
+    m_stream.write((const char *)&value, sizeof(T));
+  }
+  template <class T> bool Read(T &value)
+  {
+    m_stream.read((char *)&value, sizeof(T));
+    return m_stream.good();
+  }
+
+  /// Return true if the input differs from its cleared state of the previous frame.
+  bool IsInputModified(const SCA_InputEvent &event) const;
+  void WriteInput(unsigned short index, const SCA_InputEvent &event);
+  bool ReadInput(SCA_IInputDevice *device);
+
+  /// Implementations of the Process functions, called with m_mutex locked.
+  long ProcessSeedChunk(long seed);
+  bool ProcessClockChunk(double &clockTime, double &timeStep);
+  bool ProcessInputsChunk(SCA_IInputDevice *device);
+
+ public:
+  SCA_InputRecorder(const std::string &filepath, Mode mode);
+  ~SCA_InputRecorder();
+
+  Mode GetMode() const;
+  bool IsValid() const;
+  /// Return true when a replay consumed all the recorded frames.
+  bool IsFinished() const;
+  unsigned int GetFrameCount() const;
+
+  /** Record the seed in record mode, in replay mode return the recorded seed or the passed seed
+   * if the stream doesn't contain a seed at this position. Can be called from the libload
+   * conversion threads.
+   */
+  long ProcessSeed(long seed);
+
+  /** Record clock time and time step in record mode, in replay mode overwrite them
+   * with the recorded values. Return false when there's no more frame to replay.
+   */
+  bool ProcessClock(double &clockTime, double &timeStep);
+
+  /** Record the input state of the device in record mode, in replay mode overwrite
+   * the whole input state of the device with the recorded one.
+   * Return false when there's no more frame to replay.
+   */
+  bool ProcessInputs(SCA_IInputDevice *device);
+};
+
+#endif  // __SCA_INPUTRECORDER_H__
@@ -54,7 +54,8 @@ SCA_IInputDevice *SCA_KeyboardManager::GetInputDevice()
 
 void SCA_KeyboardManager::NextFrame()
 {
+  // Only keyboard sensors are registered to this manager.
   for (SCA_ISensor *sensor : m_sensors) {
-    sensor->Activate(m_logicmgr);
+    sensor->ActivateNative<SCA_KeyboardSensor>(m_logicmgr);
   }
 }
@@ -93,6 +93,11 @@ class SCA_KeyboardSensor : public SCA_ISensor {
   virtual bool Evaluate();
   virtual bool IsPositiveTrigger();
 
+  virtual sensortype GetSensorType()
+  {
+    return ST_KEYBOARD;
+  }
+
 #ifdef WITH_PYTHON
   /* --------------------------------------------------------------------- */
   /* Python interface ---------------------------------------------------- */
@@ -111,8 +111,11 @@ bool SCA_ObjectActuator::Update()
   RemoveAllEvents();
 
   KX_GameObject *parent = static_cast<KX_GameObject *>(GetParent());
-  PHY_ICharacter *character = parent->GetScene()->GetPhysicsEnvironment()->GetCharacterController(
-      parent);
+  // Only lookup the character controller when it's used.
+  PHY_ICharacter *character =
+      (m_bitLocalFlag.CharacterMotion) ?
+          parent->GetScene()->GetPhysicsEnvironment()->GetCharacterController(parent) :
+          nullptr;
 
   if (bNegativeEvent) {
     // If we previously set the linear velocity we now have to inform
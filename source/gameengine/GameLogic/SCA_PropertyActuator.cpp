@@ -52,7 +52,8 @@ SCA_PropertyActuator::SCA_PropertyActuator(SCA_IObject *gameobj,
       m_type(acttype),
       m_propname(propname),
       m_exprtxt(expr),
-      m_sourceObj(sourceObj)
+      m_sourceObj(sourceObj),
+      m_exprCache(nullptr)
 {
   // protect ourselves against someone else deleting the source object
   // don't protect against ourselves: it would create a dead lock
@@ -64,6 +65,41 @@ SCA_PropertyActuator::~SCA_PropertyActuator()
 {
   if (m_sourceObj)
     m_sourceObj->UnregisterActuator(this);
+  ClearExpression();
+}
+
+CExpression *SCA_PropertyActuator::GetExpression()
+{
+  /* The expression is parsed once, the identifiers are resolved by FindIdentifier at each
+   * calculation so the cache stays valid while the properties change.
+   */
+  if (!m_exprCache) {
+    CParser parser;
+    parser.SetContext(AddRef());
+    m_exprCache = parser.ProcessText(m_exprtxt);
+  }
+
+  return m_exprCache;
+}
+
+void SCA_PropertyActuator::ClearExpression()
+{
+  if (m_exprCache) {
+    m_exprCache->Release();
+    m_exprCache = nullptr;
+  }
+}
+
+void SCA_PropertyActuator::Delete()
+{
+  // The cached expression references this actuator as identifier context.
+  ClearExpression();
+  Release();
+}
+
+CValue *SCA_PropertyActuator::FindIdentifier(const std::string &identifiername)
+{
+  return GetParent()->FindIdentifier(identifiername);
 }
 
 bool SCA_PropertyActuator::Update()
@@ -72,7 +108,7 @@ bool SCA_PropertyActuator::Update()
 
   bool bNegativeEvent = IsNegativeEvent();
   RemoveAllEvents();
-  CValue *propowner = GetParent();
+  SCA_IObject *propowner = GetParent();
 
   if (bNegativeEvent) {
     if (m_type == KX_ACT_PROP_LEVEL) {
@@ -86,9 +122,6 @@ bool SCA_PropertyActuator::Update()
     return false;
   }
 
-  CParser parser;
-  parser.SetContext(propowner->AddRef());
-
   CExpression *userexpr = nullptr;
 
   if (m_type == KX_ACT_PROP_TOGGLE) {
@@ -116,7 +149,7 @@ bool SCA_PropertyActuator::Update()
     }
     newval->Release();
   }
-  else if ((userexpr = parser.ProcessText(m_exprtxt))) {
+  else if ((userexpr = GetExpression())) {
     switch (m_type) {
 
       case KX_ACT_PROP_ASSIGN: {
@@ -127,7 +160,10 @@ bool SCA_PropertyActuator::Update()
           oldprop->SetValue(newval);
         }
         else {
-          propowner->SetProperty(m_propname, newval);
+          // Never share the value owned by the cached expression.
+          CValue *copy = newval->GetReplica();
+          propowner->SetProperty(m_propname, copy);
+          copy->Release();
         }
         newval->Release();
         break;
@@ -162,8 +198,6 @@ bool SCA_PropertyActuator::Update()
       default: {
       }
     }
-
-    userexpr->Release();
   }
 
   return result;
@@ -178,6 +212,7 @@ SCA_PropertyActuator::
 
   SCA_PropertyActuator *replica = new SCA_PropertyActuator(*this);
 
+  replica->m_exprCache = nullptr;
   replica->ProcessReplica();
   return replica;
 };
@@ -265,7 +300,8 @@ PyMethodDef SCA_PropertyActuator::Methods[] = {
 PyAttributeDef SCA_PropertyActuator::Attributes[] = {
     KX_PYATTRIBUTE_STRING_RW_CHECK(
         "propName", 0, MAX_PROP_NAME, false, SCA_PropertyActuator, m_propname, CheckProperty),
-    KX_PYATTRIBUTE_STRING_RW("value", 0, 100, false, SCA_PropertyActuator, m_exprtxt),
+    KX_PYATTRIBUTE_STRING_RW_CHECK(
+        "value", 0, 100, false, SCA_PropertyActuator, m_exprtxt, CheckValue),
     KX_PYATTRIBUTE_INT_RW("mode",
                           KX_ACT_PROP_NODEF + 1,
                           KX_ACT_PROP_MAX - 1,
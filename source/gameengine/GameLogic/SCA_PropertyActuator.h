@@ -34,6 +34,8 @@
 
 #include "SCA_IActuator.h"
 
+class CExpression;
+
 class SCA_PropertyActuator : public SCA_IActuator {
   Py_Header
 
@@ -51,6 +53,11 @@ class SCA_PropertyActuator : public SCA_IActuator {
   std::string m_propname;
   std::string m_exprtxt;
   SCA_IObject *m_sourceObj;  // for copy property actuator
+  /// Parsed m_exprtxt, computed at the first update and kept until the text changes.
+  CExpression *m_exprCache;
+
+  CExpression *GetExpression();
+  void ClearExpression();
 
  public:
   SCA_PropertyActuator(SCA_IObject *gameobj,
@@ -64,6 +71,8 @@ class SCA_PropertyActuator : public SCA_IActuator {
   CValue *GetReplica();
 
   virtual void ProcessReplica();
+  virtual void Delete();
+  virtual CValue *FindIdentifier(const std::string &identifiername);
   virtual bool UnlinkObject(SCA_IObject *clientobj);
   virtual void Relink(std::map<SCA_IObject *, SCA_IObject *> &obj_map);
 
@@ -72,6 +81,15 @@ class SCA_PropertyActuator : public SCA_IActuator {
   /* --------------------------------------------------------------------- */
   /* Python interface ---------------------------------------------------- */
   /* --------------------------------------------------------------------- */
+
+#ifdef WITH_PYTHON
+  static int CheckValue(PyObjectPlus *self, const PyAttributeDef *)
+  {
+    // The expression text changed, parse it again at the next update.
+    reinterpret_cast<SCA_PropertyActuator *>(self)->ClearExpression();
+    return 0;
+  }
+#endif  // WITH_PYTHON
 };
 
 #endif /* __KX_PROPERTYACTUATOR_DOC */
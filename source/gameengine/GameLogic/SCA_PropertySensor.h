@@ -78,6 +78,11 @@ class SCA_PropertySensor : public SCA_ISensor {
   virtual bool IsPositiveTrigger();
   virtual CValue *FindIdentifier(const std::string &identifiername);
 
+  virtual sensortype GetSensorType()
+  {
+    return ST_PROPERTY;
+  }
+
 #ifdef WITH_PYTHON
 
   /* --------------------------------------------------------------------- */
@@ -140,6 +140,10 @@ void SCA_SoundActuator::play()
       AUD_Handle_setConeAngleOuter(m_handle, m_3d.cone_outer_angle);
       AUD_Handle_setConeVolumeOuter(m_handle, m_3d.cone_outer_gain);
     }
+    else {
+      // Music and interface sounds stay audible when the device limits the mixed voices.
+      AUD_Handle_setPriority(m_handle, 1);
+    }
 
     if (loop)
       AUD_Handle_setLoopCount(m_handle, -1);
@@ -110,6 +110,8 @@ extern "C" {
 
 #include "BLI_system.h"
 
+#include "PIL_time.h"
+
 #include "windowmanager/WM_api.h"
 #include "windowmanager/wm.h"
 #include "windowmanager/message_bus/wm_message_bus.h"
@@ -540,7 +542,14 @@ static void usage(const std::string &program, bool isBlenderPlayer)
   CM_Message("       show_camera_frustum            0         Show debug camera frustum volume");
   CM_Message(
       "       show_shadow_frustum            0         Show debug light shadow frustum volume");
-  CM_Message("       ignore_deprecation_warnings    1         Ignore deprecation warnings"
+  CM_Message("       ignore_deprecation_warnings    1         Ignore deprecation warnings");
+  CM_Message("       record_input                             Record inputs to the given file");
+  CM_Message("       replay_input                             Replay inputs from the given file");
+  CM_Message("       replay_render                  1         Render frames during replay");
+  CM_Message("       capture                                  Capture all the frames to the given");
+  CM_Message("                                                file, using the scene output format");
+  CM_Message("       capture_frames                 0         Quit after capturing the number of");
+  CM_Message("                                                frames, 0 to capture until the end"
              << std::endl);
   CM_Message("  -p: override python main loop script");
   CM_Message(std::endl);
@@ -553,6 +562,10 @@ static void usage(const std::string &program, bool isBlenderPlayer)
                          << example_filename);
   CM_Message("example: " << program << " -i 232421 -m 16 " << example_pathname
                          << example_filename);
+  CM_Message("example: " << program << " -g replay_input = session.rec " << example_pathname
+                         << example_filename);
+  CM_Message("example: " << program << " -g capture = //capture.mkv -g capture_frames = 600 "
+                         << example_pathname << example_filename);
 }
 
 static void get_filename(int argc, char **argv, char *filename)
@@ -607,6 +620,7 @@ static BlendFileData *load_game_data(const char *progname,
 {
   ReportList reports;
   BlendFileData *bfd = nullptr;
+  const double starttime = PIL_check_seconds_timer();
 
   BKE_reports_init(&reports, RPT_STORE);
 
@@ -622,6 +636,11 @@ static BlendFileData *load_game_data(const char *progname,
     bfd = BLO_read_from_file(progname, BLO_READ_SKIP_NONE, &reports);
   }
 
+  if (bfd && (G.debug & G_DEBUG)) {
+    CM_Debug("game data read from " << progname << " in "
+                                      << (PIL_check_seconds_timer() - starttime) << "s");
+  }
+
   if (!bfd && filename) {
     bfd = load_game_data(filename);
     if (!bfd) {
@@ -1256,6 +1275,9 @@ int main(int argc,
         DRW_engines_register();
 
         do {
+          // Start of the time to first frame printed in debug mode.
+          const double loadstarttime = PIL_check_seconds_timer();
+
           // Read the Blender file
 
           // if we got an exitcode 3 (KX_ExitRequest::START_OTHER_GAME) load a different file
@@ -1518,6 +1540,10 @@ int main(int argc,
             launcher.SetPythonGlobalDict(globalDict);
 #endif  // WITH_PYTHON
 
+            if (G.debug & G_DEBUG) {
+              launcher.SetLoadStartTime(loadstarttime);
+            }
+
             launcher.InitEngine();
 
             // Enter main loop
@@ -418,8 +418,6 @@ void BL_Action::Update(float curtime, bool applyToObject)
   Object *ob = m_obj->GetBlenderObject();  // eevee
 
   if (m_obj->GetGameObjectType() == SCA_IObject::OBJ_ARMATURE) {
-    DEG_id_tag_update(&ob->id, ID_RECALC_TRANSFORM);
-
     // BKE_object_where_is_calc_time(depsgraph, sc, ob, m_localframe);
 
     scene->ResetTaaSamples();
@@ -430,7 +428,7 @@ void BL_Action::Update(float curtime, bool applyToObject)
       obj->GetPose(&m_blendpose);
 
     // Extract the pose from the action
-    obj->SetPoseByAction(m_action, m_localframe);
+    const bool nativePose = obj->SetPoseByAction(m_action, m_localframe);
 
     ignore_parent_tx_bge(G_MAIN, depsgraph, scene, ob);
 
@@ -450,6 +448,13 @@ void BL_Action::Update(float curtime, bool applyToObject)
       obj->BlendInPose(m_blendpose, m_layer_weight, m_blendmode);
 
     obj->UpdateTimestep(curtime);
+
+    /* The bone matrices of natively sampled poses are computed here and only the deformed meshes
+     * are evaluated by the depsgraph. Actions animating other properties need the complete
+     * armature evaluation. */
+    if (!nativePose || !obj->UpdateEvaluatedPose(depsgraph)) {
+      DEG_id_tag_update(&ob->id, ID_RECALC_TRANSFORM);
+    }
   }
   else {
     /* WARNING: The check to be sure the right action is played (to know if the action
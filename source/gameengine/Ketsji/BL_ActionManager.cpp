@@ -144,6 +144,16 @@ void BL_ActionManager::RemoveTaggedActions()
   }
 }
 
+void BL_ActionManager::CollectActions(std::set<ID *> &ids)
+{
+  for (const auto &pair : m_layers) {
+    ID *action = (ID *)pair.second->GetAction();
+    if (action) {
+      ids.insert(action);
+    }
+  }
+}
+
 bool BL_ActionManager::IsActionDone(short layer)
 {
   BL_Action *action = GetAction(layer);
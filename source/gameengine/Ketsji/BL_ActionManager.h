@@ -28,6 +28,7 @@
 #define __BL_ACTIONMANAGER_H__
 
 #include <map>
+#include <set>
 
 // Currently, we use the max value of a short.
 // We should switch to unsigned short; doesn't make sense to support negative layers.
@@ -35,6 +36,7 @@
 #define MAX_ACTION_LAYERS 32767
 
 class BL_Action;
+struct ID;
 
 /**
  * BL_ActionManager is responsible for handling a KX_GameObject's actions.
@@ -101,6 +103,11 @@ class BL_ActionManager {
    */
   void RemoveTaggedActions();
 
+  /**
+   * Add the playing actions to a set of IDs.
+   */
+  void CollectActions(std::set<ID *> &ids);
+
   /**
    * Check if an action has finished playing
    */
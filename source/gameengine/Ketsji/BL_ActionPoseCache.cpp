@@ -0,0 +1,417 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file BL_ActionPoseCache.cpp
+ *  \ingroup ketsji
+ */
+
+#include "BL_ActionPoseCache.h"
+
+#include "MEM_guardedalloc.h"
+
+extern "C" {
+#include "BKE_action.h"
+#include "BKE_fcurve.h"
+#include "BLI_listbase.h"
+#include "BLI_string.h"
+#include "DNA_action_types.h"
+#include "DNA_anim_types.h"
+#include "DNA_armature_types.h"
+#include "DNA_curve_types.h"
+}
+
+#include <algorithm>
+#include <cstddef>
+#include <cmath>
+#include <cstring>
+
+#define IS_TAGGED(_id) ((_id) && (((ID *)_id)->tag & LIB_TAG_DOIT))
+
+/// Pose channel property animated by an action and the location of its values in bPoseChannel.
+struct ChannelProperty {
+  const char *m_name;
+  unsigned int m_size;
+  /// Offset of each array item.
+  unsigned int m_offsets[4];
+};
+
+#define CHANNEL_OFFSET(member, index) (offsetof(bPoseChannel, member) + sizeof(float) * (index))
+
+static const ChannelProperty channelProperties[] = {
+    {"location", 3, {CHANNEL_OFFSET(loc, 0), CHANNEL_OFFSET(loc, 1), CHANNEL_OFFSET(loc, 2)}},
+    {"rotation_quaternion",
+     4,
+     {CHANNEL_OFFSET(quat, 0),
+      CHANNEL_OFFSET(quat, 1),
+      CHANNEL_OFFSET(quat, 2),
+      CHANNEL_OFFSET(quat, 3)}},
+    {"rotation_euler",
+     3,
+     {CHANNEL_OFFSET(eul, 0), CHANNEL_OFFSET(eul, 1), CHANNEL_OFFSET(eul, 2)}},
+    // The RNA axis angle array starts with the angle.
+    {"rotation_axis_angle",
+     4,
+     {CHANNEL_OFFSET(rotAngle, 0),
+      CHANNEL_OFFSET(rotAxis, 0),
+      CHANNEL_OFFSET(rotAxis, 1),
+      CHANNEL_OFFSET(rotAxis, 2)}},
+    {"scale", 3, {CHANNEL_OFFSET(size, 0), CHANNEL_OFFSET(size, 1), CHANNEL_OFFSET(size, 2)}}};
+
+#undef CHANNEL_OFFSET
+
+/** Find the channel and the offset of the value animated by a F-curve.
+ * \return False if the F-curve doesn't animate a pose channel transform.
+ */
+static bool find_channel_value(FCurve *fcu,
+                               bPose *pose,
+                               unsigned int &r_channel,
+                               unsigned int &r_offset)
+{
+  static const char prefix[] = "pose.bones[\"";
+  const char *path = fcu->rna_path;
+  if (strncmp(path, prefix, sizeof(prefix) - 1) != 0) {
+    return false;
+  }
+
+  // Properties names don't contain dots unlike the bone names.
+  const char *property = strrchr(path, '.');
+  if (property - path < 2 || property[-1] != ']' || property[-2] != '"') {
+    return false;
+  }
+  ++property;
+
+  const ChannelProperty *channelProperty = nullptr;
+  for (const ChannelProperty &prop : channelProperties) {
+    if (STREQ(property, prop.m_name)) {
+      channelProperty = &prop;
+      break;
+    }
+  }
+
+  if (!channelProperty || fcu->array_index < 0 ||
+      (unsigned int)fcu->array_index >= channelProperty->m_size) {
+    return false;
+  }
+
+  char *name = BLI_str_quoted_substrN(path, "pose.bones[");
+  if (!name) {
+    return false;
+  }
+
+  bPoseChannel *pchan = BKE_pose_channel_find_name(pose, name);
+  MEM_freeN(name);
+  if (!pchan) {
+    // Like the animation system, unresolved paths are ignored.
+    r_channel = (unsigned int)-1;
+    return true;
+  }
+
+  r_channel = BLI_findindex(&pose->chanbase, pchan);
+  r_offset = channelProperty->m_offsets[fcu->array_index];
+  return true;
+}
+
+/// Return true if the F-curve holds its values between keys, its samples can't be interpolated.
+static bool fcurve_is_stepped(const FCurve *fcu)
+{
+  if (fcu->flag & (FCURVE_DISCRETE_VALUES | FCURVE_INT_VALUES)) {
+    return true;
+  }
+
+  for (const FModifier *fcm = (const FModifier *)fcu->modifiers.first; fcm; fcm = fcm->next) {
+    if (fcm->type == FMODIFIER_TYPE_STEPPED && !(fcm->flag & FMODIFIER_FLAG_MUTED)) {
+      return true;
+    }
+  }
+
+  if (fcu->bezt) {
+    // The interpolation of the last key is never used.
+    for (unsigned int i = 0; i + 1 < fcu->totvert; ++i) {
+      if (fcu->bezt[i].ipo == BEZT_IPO_CONST) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+BL_ActionPoseCache::BL_ActionPoseCache()
+    : m_bakeRate(0.0f),
+      m_numBakedValues(0),
+      m_numSamples(0),
+      m_numBakedSamples(0),
+      m_numSharedSamples(0)
+{
+}
+
+BL_ActionPoseCache::~BL_ActionPoseCache()
+{
+}
+
+BL_ActionPoseCache::ActionBindings &BL_ActionPoseCache::GetBindings(bAction *action,
+                                                                   bArmature *armature,
+                                                                   bPose *pose)
+{
+  const ActionKey key(action, armature);
+  std::map<ActionKey, ActionBindings>::iterator it = m_actions.find(key);
+  if (it != m_actions.end()) {
+    return it->second;
+  }
+
+  ActionBindings &bindings = m_actions[key];
+  bindings.m_native = true;
+  bindings.m_bakeDone = false;
+  bindings.m_bakeStart = 0.0f;
+  bindings.m_bakeStep = 0.0f;
+  bindings.m_numBakedSamples = 0;
+
+  for (FCurve *fcu = (FCurve *)action->curves.first; fcu; fcu = fcu->next) {
+    // Same curves skipped as in the animation system.
+    if (!fcu->rna_path || (fcu->grp && (fcu->grp->flag & AGRP_MUTED)) ||
+        (fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED)) || BKE_fcurve_is_empty(fcu)) {
+      continue;
+    }
+
+    unsigned int channel;
+    unsigned int offset;
+    if (fcu->driver || !find_channel_value(fcu, pose, channel, offset)) {
+      bindings.m_native = false;
+      bindings.m_bindings.clear();
+      break;
+    }
+
+    if (channel != (unsigned int)-1) {
+      bindings.m_bindings.push_back({fcu, channel, offset, fcurve_is_stepped(fcu)});
+    }
+  }
+
+  // Keep the action order for the values animated by several curves, the last one is applied.
+  std::stable_sort(bindings.m_bindings.begin(),
+                   bindings.m_bindings.end(),
+                   [](const Binding &a, const Binding &b) { return a.m_channel < b.m_channel; });
+
+  return bindings;
+}
+
+void BL_ActionPoseCache::Bake(bAction *action, ActionBindings &bindings)
+{
+  // Don't try again at each sample if the bake is skipped.
+  bindings.m_bakeDone = true;
+
+  for (unsigned int i = 0, size = bindings.m_bindings.size(); i < size; ++i) {
+    if (!bindings.m_bindings[i].m_stepped) {
+      bindings.m_bakedBindings.push_back(i);
+    }
+  }
+
+  const unsigned int numBaked = bindings.m_bakedBindings.size();
+  if (numBaked == 0) {
+    return;
+  }
+
+  float start;
+  float end;
+  // The cyclic modifiers are ignored, the frames outside of the range aren't baked.
+  calc_action_range(action, &start, &end, false);
+
+  // Fit the samples in the range, the rate is a minimum.
+  const float numSamplesf = ceilf((end - start) * m_bakeRate) + 1.0f;
+  if (!(numSamplesf * numBaked <= (float)(ACTION_MAX_BAKED_VALUES - m_numBakedValues))) {
+    // The F-curves are evaluated instead.
+    std::vector<unsigned int>().swap(bindings.m_bakedBindings);
+    return;
+  }
+
+  const unsigned int numSamples = (unsigned int)numSamplesf;
+  bindings.m_bakeStart = start;
+  bindings.m_bakeStep = (numSamples > 1) ? (end - start) / (numSamples - 1) : 0.0f;
+  bindings.m_numBakedSamples = numSamples;
+  bindings.m_bakedValues.resize(numSamples * numBaked);
+  m_numBakedValues += numSamples * numBaked;
+
+  float *values = bindings.m_bakedValues.data();
+  for (unsigned int i = 0; i < numSamples; ++i) {
+    const float frame = (i == numSamples - 1) ? end : start + bindings.m_bakeStep * i;
+    for (unsigned int index : bindings.m_bakedBindings) {
+      *values++ = evaluate_fcurve(bindings.m_bindings[index].m_fcurve, frame);
+    }
+  }
+}
+
+bool BL_ActionPoseCache::SampleBaked(const ActionBindings &bindings,
+                                     float frame,
+                                     std::vector<float> &values) const
+{
+  const float pos = (bindings.m_numBakedSamples > 1) ?
+                        (frame - bindings.m_bakeStart) / bindings.m_bakeStep :
+                        0.0f;
+  if (!(pos >= 0.0f && pos <= (float)(bindings.m_numBakedSamples - 1)) ||
+      (bindings.m_numBakedSamples == 1 && frame != bindings.m_bakeStart)) {
+    return false;
+  }
+
+  const unsigned int numBindings = bindings.m_bindings.size();
+  const unsigned int numBaked = bindings.m_bakedBindings.size();
+  const unsigned int index = std::min((unsigned int)pos, bindings.m_numBakedSamples - 1);
+  const float *first = &bindings.m_bakedValues[index * numBaked];
+  // The last sample is used as is.
+  const float *second = (index == bindings.m_numBakedSamples - 1) ? first : first + numBaked;
+  const float factor = pos - index;
+  values.resize(numBindings);
+
+  // Component wise interpolation, as the F-curves interpolate each quaternion component.
+  const unsigned int *bakedBindings = bindings.m_bakedBindings.data();
+  float *result = values.data();
+  for (unsigned int i = 0; i < numBaked; ++i) {
+    result[bakedBindings[i]] = first[i] + (second[i] - first[i]) * factor;
+  }
+
+  if (numBaked != numBindings) {
+    for (unsigned int i = 0; i < numBindings; ++i) {
+      const Binding &binding = bindings.m_bindings[i];
+      if (binding.m_stepped) {
+        result[i] = evaluate_fcurve(binding.m_fcurve, frame);
+      }
+    }
+  }
+
+  return true;
+}
+
+bool BL_ActionPoseCache::SetPose(bAction *action, bArmature *armature, bPose *pose, float frame)
+{
+  if (!action || !pose) {
+    return false;
+  }
+
+  ActionBindings &bindings = GetBindings(action, armature, pose);
+  if (!bindings.m_native) {
+    return false;
+  }
+
+  std::map<float, std::vector<float>>::iterator it = bindings.m_samples.find(frame);
+  if (it == bindings.m_samples.end()) {
+    it = bindings.m_samples.emplace(frame, std::vector<float>()).first;
+    std::vector<float> &values = it->second;
+
+    if (m_bakeRate > 0.0f && !bindings.m_bakeDone && !bindings.m_bindings.empty()) {
+      Bake(action, bindings);
+    }
+
+    if (!bindings.m_bakedValues.empty() && SampleBaked(bindings, frame, values)) {
+      ++m_numBakedSamples;
+    }
+    else {
+      values.reserve(bindings.m_bindings.size());
+      for (const Binding &binding : bindings.m_bindings) {
+        values.push_back(evaluate_fcurve(binding.m_fcurve, frame));
+      }
+    }
+    ++m_numSamples;
+  }
+  else {
+    ++m_numSharedSamples;
+  }
+
+  const std::vector<float> &values = it->second;
+  // The bindings are sorted by channel, the channel list is walked once.
+  bPoseChannel *pchan = (bPoseChannel *)pose->chanbase.first;
+  unsigned int index = 0;
+  for (unsigned int i = 0, size = bindings.m_bindings.size(); i < size; ++i) {
+    const Binding &binding = bindings.m_bindings[i];
+    for (; pchan && index < binding.m_channel; ++index) {
+      pchan = pchan->next;
+    }
+
+    if (!pchan) {
+      break;
+    }
+
+    *(float *)((char *)pchan + binding.m_offset) = values[i];
+  }
+
+  return true;
+}
+
+void BL_ActionPoseCache::NextFrame()
+{
+  for (std::pair<const ActionKey, ActionBindings> &pair : m_actions) {
+    pair.second.m_samples.clear();
+  }
+
+  m_numSamples = 0;
+  m_numBakedSamples = 0;
+  m_numSharedSamples = 0;
+}
+
+void BL_ActionPoseCache::RemoveTaggedActions()
+{
+  for (std::map<ActionKey, ActionBindings>::iterator it = m_actions.begin();
+       it != m_actions.end();) {
+    if (IS_TAGGED(it->first.first) || IS_TAGGED(it->first.second)) {
+      m_numBakedValues -= it->second.m_bakedValues.size();
+      it = m_actions.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+}
+
+float BL_ActionPoseCache::GetBakeRate() const
+{
+  return m_bakeRate;
+}
+
+void BL_ActionPoseCache::SetBakeRate(float rate)
+{
+  rate = std::min(rate, ACTION_MAX_BAKE_RATE);
+  if (rate == m_bakeRate) {
+    return;
+  }
+
+  m_bakeRate = rate;
+  m_numBakedValues = 0;
+  for (std::pair<const ActionKey, ActionBindings> &pair : m_actions) {
+    ActionBindings &bindings = pair.second;
+    bindings.m_bakeDone = false;
+    bindings.m_numBakedSamples = 0;
+    std::vector<unsigned int>().swap(bindings.m_bakedBindings);
+    std::vector<float>().swap(bindings.m_bakedValues);
+  }
+}
+
+unsigned int BL_ActionPoseCache::GetNumSamples() const
+{
+  return m_numSamples;
+}
+
+unsigned int BL_ActionPoseCache::GetNumBakedSamples() const
+{
+  return m_numBakedSamples;
+}
+
+unsigned int BL_ActionPoseCache::GetNumSharedSamples() const
+{
+  return m_numSharedSamples;
+}
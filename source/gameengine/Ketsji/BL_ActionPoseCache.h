@@ -0,0 +1,136 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file BL_ActionPoseCache.h
+ *  \ingroup ketsji
+ *  \brief Evaluate the pose channel transforms of an action without the animation system.
+ *
+ * The F-curves of an action are bound once per armature to the pose channel values they
+ * animate. The values sampled at a frame are kept until the next animation update and shared
+ * by all the armatures playing the action at the same frame, as crowds of a same character do.
+ *
+ * Optionally the bound values are baked at a fixed rate over the action range on first use,
+ * the samples are then interpolated linearly instead of evaluating the F-curves. The stepped
+ * F-curves can't be interpolated and are always evaluated.
+ */
+
+#ifndef __BL_ACTIONPOSECACHE_H__
+#define __BL_ACTIONPOSECACHE_H__
+
+#include <map>
+#include <vector>
+
+/// Maximum baked samples per frame, the baked values grow linearly with the rate.
+#define ACTION_MAX_BAKE_RATE 10.0f
+/// Maximum baked values of all the actions, the actions baked past it evaluate their F-curves.
+#define ACTION_MAX_BAKED_VALUES (16 * 1024 * 1024)
+
+struct bAction;
+struct bArmature;
+struct bPose;
+struct FCurve;
+
+class BL_ActionPoseCache {
+ private:
+  /// F-curve animating a float value of a pose channel.
+  struct Binding {
+    FCurve *m_fcurve;
+    /// Index of the channel in the pose channel list.
+    unsigned int m_channel;
+    /// Offset in bytes of the animated value in bPoseChannel.
+    unsigned int m_offset;
+    /// The F-curve holds its values between keys, it is never baked.
+    bool m_stepped;
+  };
+
+  /// Bindings of an action for the pose channels of an armature.
+  struct ActionBindings {
+    /// False if the action animates other properties than the pose channel transforms.
+    bool m_native;
+    /// Bindings sorted by channel index.
+    std::vector<Binding> m_bindings;
+    /// Values of the bindings per frame, sampled during the current animation update.
+    std::map<float, std::vector<float>> m_samples;
+
+    /// The bake was done or skipped since the last bake rate change.
+    bool m_bakeDone;
+    /// First frame of the baked values.
+    float m_bakeStart;
+    /// Frames between two baked samples.
+    float m_bakeStep;
+    unsigned int m_numBakedSamples;
+    /// Indices of the bindings baked, the ones not stepped.
+    std::vector<unsigned int> m_bakedBindings;
+    /// Values of the baked bindings per baked sample, empty if not baked.
+    std::vector<float> m_bakedValues;
+  };
+
+  typedef std::pair<bAction *, bArmature *> ActionKey;
+
+  std::map<ActionKey, ActionBindings> m_actions;
+
+  /// Baked samples per frame, 0 to evaluate the F-curves.
+  float m_bakeRate;
+  /// Baked values of all the actions, up to ACTION_MAX_BAKED_VALUES.
+  unsigned int m_numBakedValues;
+
+  unsigned int m_numSamples;
+  unsigned int m_numBakedSamples;
+  unsigned int m_numSharedSamples;
+
+  ActionBindings &GetBindings(bAction *action, bArmature *armature, bPose *pose);
+  void Bake(bAction *action, ActionBindings &bindings);
+  /** Interpolate the baked values and evaluate the stepped F-curves.
+   * \return False if the frame is outside of the baked range.
+   */
+  bool SampleBaked(const ActionBindings &bindings, float frame, std::vector<float> &values) const;
+
+ public:
+  BL_ActionPoseCache();
+  ~BL_ActionPoseCache();
+
+  /** Set the pose channel values animated by the action at a frame.
+   * \return False if the action can't be evaluated natively, the caller must then
+   * evaluate it with the animation system.
+   */
+  bool SetPose(bAction *action, bArmature *armature, bPose *pose, float frame);
+
+  /// Forget the sampled values, called before each animation update.
+  void NextFrame();
+  /// Remove the actions and armatures tagged to be freed.
+  void RemoveTaggedActions();
+
+  float GetBakeRate() const;
+  /** Set the baked samples per frame and free the previous baked values, 0 disables baking.
+   * The rate is clamped to ACTION_MAX_BAKE_RATE.
+   */
+  void SetBakeRate(float rate);
+
+  /// Number of action samples evaluated since the last NextFrame.
+  unsigned int GetNumSamples() const;
+  /// Number of action samples interpolated from baked values since the last NextFrame.
+  unsigned int GetNumBakedSamples() const;
+  /// Number of poses set from a sample evaluated for another armature since the last NextFrame.
+  unsigned int GetNumSharedSamples() const;
+};
+
+#endif  // __BL_ACTIONPOSECACHE_H__
@@ -0,0 +1,161 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_DepsgraphProfiler.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_DepsgraphProfiler.h"
+
+#include "depsgraph/DEG_depsgraph_debug.h"
+
+#include <algorithm>
+
+KX_DepsgraphProfiler::KX_DepsgraphProfiler()
+    : m_measurement(0),
+      m_numTaggedIds(0),
+      m_numCopyOnWrite(0),
+      m_lastNumTaggedIds(0),
+      m_lastNumCopyOnWrite(0)
+{
+}
+
+KX_DepsgraphProfiler::~KX_DepsgraphProfiler()
+{
+}
+
+void KX_DepsgraphProfiler::AddTime(std::map<std::string, Entry> &entries,
+                                   unsigned int measurement,
+                                   const char *name,
+                                   double time)
+{
+  std::map<std::string, Entry>::iterator it = entries.find(name);
+  if (it == entries.end()) {
+    it = entries.emplace(name, Entry()).first;
+    // Start the first measurement of the entry.
+    it->second.m_logger.NextMeasurement(0.0);
+  }
+
+  Entry &entry = it->second;
+  entry.m_logger.AddTime(time);
+  entry.m_lastMeasurement = measurement;
+}
+
+std::vector<KX_DepsgraphProfiler::ProfileInfo> KX_DepsgraphProfiler::GetProfileInfo(
+    const std::map<std::string, Entry> &entries)
+{
+  std::vector<ProfileInfo> infos;
+  for (const auto &pair : entries) {
+    const double time = pair.second.m_logger.GetAverage();
+    if (time > 0.0) {
+      infos.push_back({pair.first, time});
+    }
+  }
+
+  std::sort(infos.begin(), infos.end(), [](const ProfileInfo &a, const ProfileInfo &b) {
+    return a.m_time > b.m_time;
+  });
+
+  return infos;
+}
+
+void KX_DepsgraphProfiler::BeginUpdate(double now)
+{
+  m_logger.StartLog(now);
+}
+
+void KX_DepsgraphProfiler::EndUpdate(Depsgraph *depsgraph, double now)
+{
+  m_logger.EndLog(now);
+
+  int numTaggedIds;
+  int numCopyOnWrite;
+  // Nothing was evaluated.
+  if (!DEG_debug_eval_stats_get(depsgraph, &numTaggedIds, &numCopyOnWrite)) {
+    return;
+  }
+
+  m_numTaggedIds += numTaggedIds;
+  m_numCopyOnWrite += numCopyOnWrite;
+
+  std::pair<KX_DepsgraphProfiler *, std::map<std::string, Entry> *> data(this, &m_ids);
+  auto func = [](void *user_data, const char *name, double time) {
+    auto *data = (std::pair<KX_DepsgraphProfiler *, std::map<std::string, Entry> *> *)user_data;
+    AddTime(*data->second, data->first->m_measurement, name, time);
+  };
+
+  DEG_debug_eval_stats_foreach_id(depsgraph, func, &data);
+  data.second = &m_operations;
+  DEG_debug_eval_stats_foreach_operation(depsgraph, func, &data);
+}
+
+void KX_DepsgraphProfiler::NextMeasurement(double now)
+{
+  m_logger.NextMeasurement(now);
+
+  m_lastNumTaggedIds = m_numTaggedIds;
+  m_lastNumCopyOnWrite = m_numCopyOnWrite;
+  m_numTaggedIds = 0;
+  m_numCopyOnWrite = 0;
+
+  ++m_measurement;
+
+  for (std::map<std::string, Entry> *entries : {&m_ids, &m_operations}) {
+    for (std::map<std::string, Entry>::iterator it = entries->begin(); it != entries->end();) {
+      Entry &entry = it->second;
+      // The entry isn't part of the average anymore.
+      if ((m_measurement - entry.m_lastMeasurement) > entry.m_logger.GetMaxNumMeasurements()) {
+        it = entries->erase(it);
+      }
+      else {
+        entry.m_logger.NextMeasurement(now);
+        ++it;
+      }
+    }
+  }
+}
+
+double KX_DepsgraphProfiler::GetAverage() const
+{
+  return m_logger.GetAverage();
+}
+
+unsigned int KX_DepsgraphProfiler::GetNumTaggedIds() const
+{
+  return m_lastNumTaggedIds;
+}
+
+unsigned int KX_DepsgraphProfiler::GetNumCopyOnWrite() const
+{
+  return m_lastNumCopyOnWrite;
+}
+
+std::vector<KX_DepsgraphProfiler::ProfileInfo> KX_DepsgraphProfiler::GetIdProfileInfo() const
+{
+  return GetProfileInfo(m_ids);
+}
+
+std::vector<KX_DepsgraphProfiler::ProfileInfo> KX_DepsgraphProfiler::GetOperationProfileInfo()
+    const
+{
+  return GetProfileInfo(m_operations);
+}
@@ -0,0 +1,97 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_DepsgraphProfiler.h
+ *  \ingroup ketsji
+ *  \brief Average timings of the depsgraph updates of a scene, by evaluated ID and by
+ * operation type.
+ */
+
+#ifndef __KX_DEPSGRAPHPROFILER_H__
+#define __KX_DEPSGRAPHPROFILER_H__
+
+#include "KX_TimeLogger.h"
+
+#include <map>
+#include <vector>
+#include <string>
+
+struct Depsgraph;
+
+class KX_DepsgraphProfiler {
+ public:
+  /// Average evaluation time of an ID or an operation type.
+  struct ProfileInfo {
+    std::string m_name;
+    double m_time;
+  };
+
+ private:
+  struct Entry {
+    KX_TimeLogger m_logger;
+    /// Last measurement the entry was evaluated in.
+    unsigned int m_lastMeasurement;
+  };
+
+  /// Time of the whole updates, including the tag flushing.
+  KX_TimeLogger m_logger;
+  std::map<std::string, Entry> m_ids;
+  std::map<std::string, Entry> m_operations;
+  unsigned int m_measurement;
+
+  /// Evaluated IDs and copy-on-write operations of the current measurement.
+  unsigned int m_numTaggedIds;
+  unsigned int m_numCopyOnWrite;
+  /// Same for the last complete measurement.
+  unsigned int m_lastNumTaggedIds;
+  unsigned int m_lastNumCopyOnWrite;
+
+  static void AddTime(std::map<std::string, Entry> &entries,
+                      unsigned int measurement,
+                      const char *name,
+                      double time);
+  static std::vector<ProfileInfo> GetProfileInfo(const std::map<std::string, Entry> &entries);
+
+ public:
+  KX_DepsgraphProfiler();
+  ~KX_DepsgraphProfiler();
+
+  /// Log the time of a depsgraph update.
+  void BeginUpdate(double now);
+  /// Log the time of a depsgraph update and gather the evaluation statistics.
+  void EndUpdate(Depsgraph *depsgraph, double now);
+
+  /// Logs in next measurement, the entries not evaluated in a while are removed.
+  void NextMeasurement(double now);
+
+  /// Return the average time of the updates.
+  double GetAverage() const;
+  unsigned int GetNumTaggedIds() const;
+  unsigned int GetNumCopyOnWrite() const;
+
+  /// Return the average evaluation time of each ID, slowest first.
+  std::vector<ProfileInfo> GetIdProfileInfo() const;
+  /// Return the average evaluation time of each operation type, slowest first.
+  std::vector<ProfileInfo> GetOperationProfileInfo() const;
+};
+
+#endif  // __KX_DEPSGRAPHPROFILER_H__
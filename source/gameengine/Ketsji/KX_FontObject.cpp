@@ -30,6 +30,7 @@
  */
 
 #include "KX_FontObject.h"
+#include "KX_Globals.h"
 #include "EXP_StringValue.h"
 
 #include "MEM_guardedalloc.h"
@@ -40,12 +41,75 @@ extern "C" {
 #include "BKE_font.h"
 #include "depsgraph/DEG_depsgraph.h"
 #include "DNA_curve_types.h"
+#include "DNA_packedFile_types.h"
+#include "DNA_vfont_types.h"
+#include "BLF_api.h"
+#include "GPU_matrix.h"
 }
 
 #include "CM_Message.h"
 
+#include <map>
+
 #define MAX_BGE_TEXT_LEN 1024  // eevee
 
+/// Glyph size of the dynamic texts, scaled down to the curve font size when drawing.
+#define BGE_FONT_RES 100
+
+/// Fonts loaded for the dynamic texts with their number of users.
+static std::map<VFont *, std::pair<int, unsigned int>> fontUsers;
+
+static int AcquireFont(VFont *vfont)
+{
+  // The builtin font isn't loadable from a file, use the monospace font always loaded.
+  if (!vfont || BKE_vfont_is_builtin(vfont)) {
+    return blf_mono_font;
+  }
+
+  std::map<VFont *, std::pair<int, unsigned int>>::iterator it = fontUsers.find(vfont);
+  if (it != fontUsers.end()) {
+    ++it->second.second;
+    return it->second.first;
+  }
+
+  /* Load a font unique to the game engine to not share (and unload) a font of the user
+   * interface. */
+  int fontid;
+  if (vfont->packedfile) {
+    PackedFile *packedfile = vfont->packedfile;
+    fontid = BLF_load_mem_unique(
+        vfont->id.name + 2, (unsigned char *)packedfile->data, packedfile->size);
+  }
+  else {
+    char expanded[sizeof(vfont->name)];
+    BLI_strncpy(expanded, vfont->name, sizeof(expanded));
+    BLI_path_abs(expanded, KX_GetMainPath().c_str());
+    fontid = BLF_load_unique(expanded);
+  }
+
+  if (fontid == -1) {
+    CM_Error("font \"" << vfont->name << "\" could not be loaded");
+    return blf_mono_font;
+  }
+
+  fontUsers[vfont] = std::make_pair(fontid, 1);
+  return fontid;
+}
+
+static void ReleaseFont(VFont *vfont)
+{
+  std::map<VFont *, std::pair<int, unsigned int>>::iterator it = fontUsers.find(vfont);
+  // Builtin or fallback font.
+  if (it == fontUsers.end()) {
+    return;
+  }
+
+  if (--it->second.second == 0) {
+    BLF_unload_id(it->second.first);
+    fontUsers.erase(it);
+  }
+}
+
 static std::vector<std::string> split_string(std::string str)
 {
   std::vector<std::string> text = std::vector<std::string>();
@@ -69,7 +133,11 @@ KX_FontObject::KX_FontObject(void *sgReplicationInfo,
                              SG_Callbacks callbacks,
                              RAS_Rasterizer *rasterizer,
                              Object *ob)
-    : KX_GameObject(sgReplicationInfo, callbacks), m_object(ob), m_rasterizer(rasterizer)
+    : KX_GameObject(sgReplicationInfo, callbacks),
+      m_object(ob),
+      m_dynamic(false),
+      m_fontId(-1),
+      m_rasterizer(rasterizer)
 {
   Curve *text = static_cast<Curve *>(ob->data);
 
@@ -83,6 +151,10 @@ KX_FontObject::~KX_FontObject()
   // remove font from the scene list
   // it's handled in KX_Scene::NewRemoveObject
   UpdateCurveText(m_backupText);  // eevee
+
+  if (m_dynamic) {
+    ReleaseFont(static_cast<Curve *>(m_object->data)->vfont);
+  }
 }
 
 CValue *KX_FontObject::GetReplica()
@@ -95,6 +167,10 @@ CValue *KX_FontObject::GetReplica()
 void KX_FontObject::ProcessReplica()
 {
   KX_GameObject::ProcessReplica();
+
+  if (m_dynamic) {
+    m_fontId = AcquireFont(static_cast<Curve *>(m_object->data)->vfont);
+  }
 }
 
 void KX_FontObject::SetText(const std::string &text)
@@ -130,10 +206,79 @@ void KX_FontObject::UpdateTextFromProperty()
   CValue *prop = GetProperty("Text");
   if (prop && prop->GetText() != m_text) {
     SetText(prop->GetText());
-    UpdateCurveText(m_text);  // eevee
+    // The dynamic text is drawn from m_texts, the curve is left empty.
+    if (!m_dynamic) {
+      UpdateCurveText(m_text);  // eevee
+    }
+  }
+}
+
+void KX_FontObject::SetDynamic(bool dynamic)
+{
+  if (m_dynamic == dynamic) {
+    return;
+  }
+
+  m_dynamic = dynamic;
+
+  VFont *vfont = static_cast<Curve *>(m_object->data)->vfont;
+  if (m_dynamic) {
+    m_fontId = AcquireFont(vfont);
+    // Tessellate an empty curve once, the text is then drawn in DrawText.
+    UpdateCurveText("");
+  }
+  else {
+    ReleaseFont(vfont);
+    m_fontId = -1;
+    UpdateCurveText(m_text);
   }
 }
 
+bool KX_FontObject::IsDynamic() const
+{
+  return m_dynamic;
+}
+
+void KX_FontObject::DrawText()
+{
+  if (!m_dynamic || !m_bVisible || m_fontId == -1) {
+    return;
+  }
+
+  Curve *cu = static_cast<Curve *>(m_object->data);
+
+  float obmat[4][4];
+  NodeGetWorldTransform().getValue(&obmat[0][0]);
+
+  GPU_matrix_push();
+  GPU_matrix_mul(obmat);
+  GPU_matrix_translate_2f(cu->xof, cu->yof);
+  /* The glyphs are always rasterized at the same size to share the glyph cache between all the
+   * texts using the font, the size of the curve is applied with the matrix. */
+  GPU_matrix_scale_1f(cu->fsize / BGE_FONT_RES);
+
+  BLF_size(m_fontId, BGE_FONT_RES, 72);
+  BLF_color4fv(m_fontId, GetObjectColor().getValue());
+
+  const float lineHeight = cu->linedist * BGE_FONT_RES;
+  for (unsigned int i = 0, size = m_texts.size(); i < size; ++i) {
+    const std::string &line = m_texts[i];
+
+    float xco = 0.0f;
+    if (cu->spacemode == CU_ALIGN_X_MIDDLE) {
+      xco = -BLF_width(m_fontId, line.c_str(), line.size()) * 0.5f;
+    }
+    else if (cu->spacemode == CU_ALIGN_X_RIGHT) {
+      xco = -BLF_width(m_fontId, line.c_str(), line.size());
+    }
+
+    BLF_position(m_fontId, xco, -lineHeight * i, 0.0f);
+    BLF_draw(m_fontId, line.c_str(), line.size());
+  }
+
+  GPU_matrix_pop();
+}
+
 #ifdef WITH_PYTHON
 
 /* ------------------------------------------------------------------------- */
@@ -184,6 +329,7 @@ PyMethodDef KX_FontObject::Methods[] = {
 
 PyAttributeDef KX_FontObject::Attributes[] = {
     KX_PYATTRIBUTE_RW_FUNCTION("text", KX_FontObject, pyattr_get_text, pyattr_set_text),
+    KX_PYATTRIBUTE_RW_FUNCTION("dynamic", KX_FontObject, pyattr_get_dynamic, pyattr_set_dynamic),
     KX_PYATTRIBUTE_NULL  // Sentinel
 };
 
@@ -216,4 +362,27 @@ int KX_FontObject::pyattr_set_text(PyObjectPlus *self_v,
   return PY_SET_ATTR_SUCCESS;
 }
 
+PyObject *KX_FontObject::pyattr_get_dynamic(PyObjectPlus *self_v,
+                                            const KX_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_FontObject *self = static_cast<KX_FontObject *>(self_v);
+  return PyBool_FromLong(self->m_dynamic);
+}
+
+int KX_FontObject::pyattr_set_dynamic(PyObjectPlus *self_v,
+                                      const KX_PYATTRIBUTE_DEF *attrdef,
+                                      PyObject *value)
+{
+  KX_FontObject *self = static_cast<KX_FontObject *>(self_v);
+  const int param = PyObject_IsTrue(value);
+  if (param == -1) {
+    PyErr_SetString(PyExc_AttributeError,
+                    "KX_FontObject.dynamic = bool: KX_FontObject, expected True or False");
+    return PY_SET_ATTR_FAIL;
+  }
+
+  self->SetDynamic(param);
+  return PY_SET_ATTR_SUCCESS;
+}
+
 #endif  // WITH_PYTHON
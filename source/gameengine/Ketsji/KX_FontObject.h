@@ -62,12 +62,24 @@ class KX_FontObject : public KX_GameObject {
   /// Update text from property.
   void UpdateTextFromProperty();
 
+  /** Use the glyph cache of the font to draw the text instead of the curve geometry.
+   * The text can then change every frame without tessellating the curve again.
+   */
+  void SetDynamic(bool dynamic);
+  bool IsDynamic() const;
+  /// Draw the dynamic text, the view and projection matrices must be already set.
+  void DrawText();
+
  protected:
   std::string m_text;
   std::vector<std::string> m_texts;
   Object *m_object;
 
   std::string m_backupText;  // eevee
+  /// True when the text is drawn with the font glyph cache.
+  bool m_dynamic;
+  /// Font used to draw the dynamic text, -1 when not loaded.
+  int m_fontId;
   /// needed for drawing routine
   class RAS_Rasterizer *m_rasterizer;
 
@@ -76,6 +88,10 @@ class KX_FontObject : public KX_GameObject {
   static int pyattr_set_text(PyObjectPlus *self_v,
                              const KX_PYATTRIBUTE_DEF *attrdef,
                              PyObject *value);
+  static PyObject *pyattr_get_dynamic(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_dynamic(PyObjectPlus *self_v,
+                                const KX_PYATTRIBUTE_DEF *attrdef,
+                                PyObject *value);
 #endif
 };
 
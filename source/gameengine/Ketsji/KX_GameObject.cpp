@@ -131,6 +131,8 @@ KX_GameObject::KX_GameObject(void *sgReplicationInfo, SG_Callbacks callbacks)
       m_layer(0),
       m_lodManager(nullptr),
       m_currentLodLevel(0),
+      m_animationLodFactor(1.0f),
+      m_animationLodPhase(0),
       m_pBlenderObject(nullptr),
       m_pBlenderGroupObject(nullptr),
       m_bIsNegativeScaling(false),
@@ -266,7 +268,7 @@ void KX_GameObject::SetBlenderObject(Object *obj)
   }
 }
 
-void KX_GameObject::TagForUpdate(bool is_overlay_pass)
+void KX_GameObject::TagForUpdate()
 {
   float obmat[4][4];
   NodeGetWorldTransform().getValue(&obmat[0][0]);
@@ -311,20 +313,12 @@ void KX_GameObject::TagForUpdate(bool is_overlay_pass)
       }
     }
   }
-  /* Wait the end of all render passes (main + overlay)
-   * to evaluate if the objects were static compared to
-   * the previous frame. If the objects are not static,
-   * then evee engine current TAA sample will be set to 1.
+  /* The scene synchronizes the objects once for all the render passes
+   * (main + overlay + image renders) and keeps the static state until
+   * the end of the frame. If the objects are not static, then evee
+   * engine current TAA sample will be set to 1.
    */
-  if (GetScene()->GetOverlayCamera() && !is_overlay_pass) {
-    // wait
-  }
-  else if (GetScene()->GetOverlayCamera() && is_overlay_pass) {
-    copy_m4_m4(m_prevObmat, obmat);
-  }
-  else {
-    copy_m4_m4(m_prevObmat, obmat);
-  }
+  copy_m4_m4(m_prevObmat, obmat);
 }
 
 void KX_GameObject::ReplicateBlenderObject()
@@ -365,6 +359,7 @@ void KX_GameObject::ReplicateBlenderObject()
     }
 
     DEG_relations_tag_update(bmain);
+    GetScene()->TagDrawObjectsUpdate();
 
     m_pBlenderObject = newob;
     m_isReplica = true;
@@ -380,6 +375,7 @@ void KX_GameObject::RemoveReplicaObject()
     BKE_id_free(bmain, &ob->id);
     SetBlenderObject(nullptr);
     DEG_relations_tag_update(bmain);
+    GetScene()->TagDrawObjectsUpdate();
   }
 }
 
@@ -400,6 +396,7 @@ void KX_GameObject::HideOriginalObject()
     BKE_layer_collection_sync(scene, view_layer);
     DEG_id_tag_update(&scene->id, ID_RECALC_BASE_FLAGS);
     GetScene()->m_hiddenObjectsDuringRuntime.push_back(ob);
+    GetScene()->TagDrawObjectsUpdate();
     GetScene()->ResetTaaSamples();
   }
 }
@@ -778,6 +775,13 @@ void KX_GameObject::RemoveTaggedActions()
   GetActionManager()->RemoveTaggedActions();
 }
 
+void KX_GameObject::CollectActions(std::set<ID *> &ids)
+{
+  if (m_actionManager) {
+    m_actionManager->CollectActions(ids);
+  }
+}
+
 bool KX_GameObject::IsActionDone(short layer)
 {
   return GetActionManager()->IsActionDone(layer);
@@ -788,6 +792,21 @@ void KX_GameObject::UpdateActionManager(float curtime, bool applyToObject)
   GetActionManager()->Update(curtime, applyToObject);
 }
 
+float KX_GameObject::GetAnimationLodFactor() const
+{
+  return m_animationLodFactor;
+}
+
+unsigned int KX_GameObject::GetAnimationLodPhase() const
+{
+  return m_animationLodPhase;
+}
+
+void KX_GameObject::SetAnimationLodPhase(unsigned int phase)
+{
+  m_animationLodPhase = phase;
+}
+
 float KX_GameObject::GetActionFrame(short layer)
 {
   return GetActionManager()->GetActionFrame(layer);
@@ -1144,6 +1163,7 @@ void KX_GameObject::SetVisible(bool v, bool recursive)
 
       BKE_layer_collection_sync(scene, view_layer);
       DEG_id_tag_update(&scene->id, ID_RECALC_BASE_FLAGS);
+      GetScene()->TagDrawObjectsUpdate();
       GetScene()->ResetTaaSamples();
     }
   }
@@ -1751,20 +1771,6 @@ void KX_GameObject::SetComponents(CListValue<KX_PythonComponent> *components)
   m_components = components;
 }
 
-void KX_GameObject::UpdateComponents()
-{
-#ifdef WITH_PYTHON
-  if (!m_components) {
-    return;
-  }
-
-  for (KX_PythonComponent *comp : m_components) {
-    comp->Update();
-  }
-
-#endif  // WITH_PYTHON
-}
-
 KX_Scene *KX_GameObject::GetScene()
 {
   BLI_assert(m_pSGNode);
@@ -2079,6 +2085,8 @@ PyMethodDef KX_GameObject::Methods[] = {
 
 PyAttributeDef KX_GameObject::Attributes[] = {
     KX_PYATTRIBUTE_SHORT_RO("currentLodLevel", KX_GameObject, m_currentLodLevel),
+    KX_PYATTRIBUTE_FLOAT_RW(
+        "animationLodFactor", 0.0f, FLT_MAX, KX_GameObject, m_animationLodFactor),
     KX_PYATTRIBUTE_RW_FUNCTION(
         "lodManager", KX_GameObject, pyattr_get_lodManager, pyattr_set_lodManager),
     KX_PYATTRIBUTE_RW_FUNCTION("name", KX_GameObject, pyattr_get_name, pyattr_set_name),
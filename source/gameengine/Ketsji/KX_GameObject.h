@@ -39,6 +39,7 @@
 #  pragma warning(disable : 4355)
 #endif
 
+#include <set>
 #include <stddef.h>
 
 #include "EXP_ListValue.h"
@@ -102,6 +103,10 @@ class KX_GameObject : public SCA_IObject {
   std::vector<RAS_MeshObject *> m_meshes;
   KX_LodManager *m_lodManager;
   short m_currentLodLevel;
+  /// Factor of the camera distance used to select the animation update rate, 0 for full rate.
+  float m_animationLodFactor;
+  /// Offset of the frames the animations are updated at a reduced rate.
+  unsigned int m_animationLodPhase;
   struct Object *m_pBlenderObject;
   struct Object *m_pBlenderGroupObject;
 
@@ -137,7 +142,7 @@ class KX_GameObject : public SCA_IObject {
  public:
   /* EEVEE INTEGRATION */
 
-  void TagForUpdate(bool is_overlay_pass);
+  void TagForUpdate();
   void ReplicateBlenderObject();
   void HideOriginalObject();
   void RemoveReplicaObject();
@@ -294,6 +299,11 @@ class KX_GameObject : public SCA_IObject {
    */
   void RemoveTaggedActions();
 
+  /**
+   * Add the playing actions to a set of IDs, without creating an action manager.
+   */
+  void CollectActions(std::set<ID *> &ids);
+
   /**
    * Check if an action has finished playing
    */
@@ -307,6 +317,10 @@ class KX_GameObject : public SCA_IObject {
    */
   void UpdateActionManager(float curtime, bool applyObject);
 
+  float GetAnimationLodFactor() const;
+  unsigned int GetAnimationLodPhase() const;
+  void SetAnimationLodPhase(unsigned int phase);
+
   /*********************************
    * End Animation API
    *********************************/
@@ -736,8 +750,6 @@ class KX_GameObject : public SCA_IObject {
   CListValue<KX_PythonComponent> *GetComponents() const;
   /// Add a components.
   void SetComponents(CListValue<KX_PythonComponent> *components);
-  /// Updates the components.
-  void UpdateComponents();
 
   KX_Scene *GetScene();
 
@@ -0,0 +1,197 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_GlobalDictStatus.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_GlobalDictStatus.h"
+#include "PIL_time.h"
+
+KX_GlobalDictStatus::KX_GlobalDictStatus(Mode mode, const std::string &path)
+    : m_mode(mode),
+      m_path(path),
+      m_numWrittenKeys(0),
+      m_success(false),
+      m_finished(false)
+#ifdef WITH_PYTHON
+      ,
+      m_finish_cb(nullptr)
+#endif
+{
+  m_endtime = m_starttime = PIL_check_seconds_timer();
+}
+
+KX_GlobalDictStatus::~KX_GlobalDictStatus()
+{
+#ifdef WITH_PYTHON
+  Py_XDECREF(m_finish_cb);
+#endif
+}
+
+KX_GlobalDictStatus::Mode KX_GlobalDictStatus::GetMode() const
+{
+  return m_mode;
+}
+
+const std::string &KX_GlobalDictStatus::GetPath() const
+{
+  return m_path;
+}
+
+std::vector<KX_GlobalDictStatus::Chunk> &KX_GlobalDictStatus::GetChunks()
+{
+  return m_chunks;
+}
+
+void KX_GlobalDictStatus::SetNumWrittenKeys(int num)
+{
+  m_numWrittenKeys = num;
+}
+
+void KX_GlobalDictStatus::SetSuccess(bool success)
+{
+  m_success = success;
+}
+
+bool KX_GlobalDictStatus::GetSuccess() const
+{
+  return m_success;
+}
+
+void KX_GlobalDictStatus::Finish()
+{
+  m_finished = true;
+  m_endtime = PIL_check_seconds_timer();
+  // The marshalled data can be big, the status could be kept by the user.
+  std::vector<Chunk>().swap(m_chunks);
+
+#ifdef WITH_PYTHON
+  if (m_finish_cb) {
+    PyObject *args = Py_BuildValue("(O)", GetProxy());
+
+    if (!PyObject_Call(m_finish_cb, args, nullptr)) {
+      PyErr_Print();
+      PyErr_Clear();
+    }
+
+    Py_DECREF(args);
+  }
+#endif
+}
+
+#ifdef WITH_PYTHON
+
+PyMethodDef KX_GlobalDictStatus::Methods[] = {
+    {nullptr, nullptr}  // Sentinel
+};
+
+PyAttributeDef KX_GlobalDictStatus::Attributes[] = {
+    KX_PYATTRIBUTE_RW_FUNCTION(
+        "onFinish", KX_GlobalDictStatus, pyattr_get_onfinish, pyattr_set_onfinish),
+    KX_PYATTRIBUTE_STRING_RO("path", KX_GlobalDictStatus, m_path),
+    KX_PYATTRIBUTE_BOOL_RO("finished", KX_GlobalDictStatus, m_finished),
+    KX_PYATTRIBUTE_BOOL_RO("success", KX_GlobalDictStatus, m_success),
+    KX_PYATTRIBUTE_INT_RO("numWrittenKeys", KX_GlobalDictStatus, m_numWrittenKeys),
+    KX_PYATTRIBUTE_RO_FUNCTION("timeTaken", KX_GlobalDictStatus, pyattr_get_timetaken),
+    KX_PYATTRIBUTE_NULL  // Sentinel
+};
+
+PyTypeObject KX_GlobalDictStatus::Type = {PyVarObject_HEAD_INIT(nullptr, 0) "KX_GlobalDictStatus",
+                                          sizeof(PyObjectPlus_Proxy),
+                                          0,
+                                          py_base_dealloc,
+                                          0,
+                                          0,
+                                          0,
+                                          0,
+                                          py_base_repr,
+                                          0,
+                                          0,
+                                          0,
+                                          0,
+                                          0,
+                                          0,
+                                          0,
+                                          0,
+                                          0,
+                                          Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+                                          0,
+                                          0,
+                                          0,
+                                          0,
+                                          0,
+                                          0,
+                                          0,
+                                          Methods,
+                                          0,
+                                          0,
+                                          &PyObjectPlus::Type,
+                                          0,
+                                          0,
+                                          0,
+                                          0,
+                                          0,
+                                          0,
+                                          py_base_new};
+
+PyObject *KX_GlobalDictStatus::pyattr_get_onfinish(PyObjectPlus *self_v,
+                                                   const KX_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_GlobalDictStatus *self = static_cast<KX_GlobalDictStatus *>(self_v);
+
+  if (self->m_finish_cb) {
+    Py_INCREF(self->m_finish_cb);
+    return self->m_finish_cb;
+  }
+
+  Py_RETURN_NONE;
+}
+
+int KX_GlobalDictStatus::pyattr_set_onfinish(PyObjectPlus *self_v,
+                                             const KX_PYATTRIBUTE_DEF *attrdef,
+                                             PyObject *value)
+{
+  KX_GlobalDictStatus *self = static_cast<KX_GlobalDictStatus *>(self_v);
+
+  if (!PyCallable_Check(value)) {
+    PyErr_SetString(PyExc_TypeError,
+                    "KX_GlobalDictStatus.onFinish requires a callable object");
+    return PY_SET_ATTR_FAIL;
+  }
+
+  Py_XDECREF(self->m_finish_cb);
+
+  Py_INCREF(value);
+  self->m_finish_cb = value;
+
+  return PY_SET_ATTR_SUCCESS;
+}
+
+PyObject *KX_GlobalDictStatus::pyattr_get_timetaken(PyObjectPlus *self_v,
+                                                    const KX_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_GlobalDictStatus *self = static_cast<KX_GlobalDictStatus *>(self_v);
+
+  return PyFloat_FromDouble(self->m_endtime - self->m_starttime);
+}
+#endif  // WITH_PYTHON
@@ -0,0 +1,94 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_GlobalDictStatus.h
+ *  \ingroup ketsji
+ *  \brief Status of an asynchronous save or load of bge.logic.globalDict.
+ */
+
+#ifndef __KX_GLOBALDICTSTATUS_H__
+#define __KX_GLOBALDICTSTATUS_H__
+
+#include "EXP_PyObjectPlus.h"
+
+#include <string>
+#include <vector>
+
+class KX_GlobalDictStatus : public PyObjectPlus {
+  Py_Header
+
+ public:
+  enum Mode { SAVE = 0, SAVE_INCREMENTAL, LOAD };
+
+  /// Marshalled top level item of the dict, an empty key means a whole marshalled dict.
+  struct Chunk {
+    std::string m_key;
+    std::string m_value;
+  };
+
+ private:
+  Mode m_mode;
+  std::string m_path;
+  /// Items written by the save task or read by the load task, freed once finished.
+  std::vector<Chunk> m_chunks;
+
+  /// Number of items compressed and written by a save, the others were unchanged.
+  int m_numWrittenKeys;
+  bool m_success;
+  bool m_finished;
+  double m_starttime;
+  double m_endtime;
+
+#ifdef WITH_PYTHON
+  PyObject *m_finish_cb;
+#endif
+
+ public:
+  KX_GlobalDictStatus(Mode mode, const std::string &path);
+  virtual ~KX_GlobalDictStatus();
+
+  Mode GetMode() const;
+  const std::string &GetPath() const;
+  std::vector<Chunk> &GetChunks();
+
+  void SetNumWrittenKeys(int num);
+  void SetSuccess(bool success);
+  bool GetSuccess() const;
+
+  inline bool IsFinished() const
+  {
+    return m_finished;
+  }
+
+  /// Called in the logic thread when the task is done, run the finish callback.
+  void Finish();
+
+#ifdef WITH_PYTHON
+  static PyObject *pyattr_get_onfinish(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_onfinish(PyObjectPlus *self_v,
+                                 const KX_PYATTRIBUTE_DEF *attrdef,
+                                 PyObject *value);
+  static PyObject *pyattr_get_timetaken(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
+#endif
+};
+
+#endif  // __KX_GLOBALDICTSTATUS_H__
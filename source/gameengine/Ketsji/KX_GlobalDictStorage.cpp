@@ -0,0 +1,451 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_GlobalDictStorage.cpp
+ *  \ingroup ketsji
+ */
+
+#ifdef WITH_PYTHON
+
+#  include "KX_GlobalDictStorage.h"
+
+#  include "CM_Message.h"
+
+#  include "BLI_fileops.h"
+#  include "BLI_task.h"
+
+#  include <marshal.h>
+#  include <zlib.h>
+
+#  include <cstdio>
+#  include <cstring>
+
+/* Chunked file layout, integers are unsigned 32 bits in the native byte order:
+ * magic, number of chunks, then for each chunk:
+ * key size, marshalled key, raw value size, compressed value size, compressed value. */
+static const char chunkFileMagic[] = "BGEDICT1";
+static const size_t chunkFileMagicSize = sizeof(chunkFileMagic) - 1;
+
+// Favor the speed, the saves are frequent and the marshalled data compress well.
+static const int chunkCompressionLevel = 1;
+
+static bool write_uint(FILE *fp, unsigned int value)
+{
+  const uint32_t data = value;
+  return (fwrite(&data, sizeof(data), 1, fp) == 1);
+}
+
+static bool write_data(FILE *fp, const std::string &data)
+{
+  return (data.empty() || fwrite(data.data(), 1, data.size(), fp) == data.size());
+}
+
+static bool read_uint(const char *&buffer, const char *end, unsigned int &r_value)
+{
+  uint32_t data;
+  if ((size_t)(end - buffer) < sizeof(data)) {
+    return false;
+  }
+
+  memcpy(&data, buffer, sizeof(data));
+  buffer += sizeof(data);
+  r_value = data;
+  return true;
+}
+
+static bool read_data(const char *&buffer, const char *end, size_t size, std::string &r_data)
+{
+  if ((size_t)(end - buffer) < size) {
+    return false;
+  }
+
+  r_data.assign(buffer, size);
+  buffer += size;
+  return true;
+}
+
+static PyObject *get_global_dict_module()
+{
+  PyObject *gameLogic = PyImport_ImportModule("GameLogic");
+  if (!gameLogic) {
+    PyErr_Clear();
+    CM_Error("bge.logic failed to import bge.logic.globalDict will be lost");
+  }
+
+  return gameLogic;
+}
+
+KX_GlobalDictStorage::KX_GlobalDictStorage()
+{
+  // A single worker keeps the saves of a same file in order.
+  m_taskScheduler = BLI_task_scheduler_create(1);
+  m_taskPool = BLI_task_pool_create(m_taskScheduler, this);
+}
+
+KX_GlobalDictStorage::~KX_GlobalDictStorage()
+{
+  BLI_task_pool_work_and_wait(m_taskPool);
+  BLI_task_pool_free(m_taskPool);
+  BLI_task_scheduler_free(m_taskScheduler);
+
+  // Status not finished by Finalize, only their python references are left.
+  for (KX_GlobalDictStatus *status : m_finishedStatus) {
+    Py_DECREF(status->GetProxy());
+  }
+}
+
+PyObject *KX_GlobalDictStorage::Save(const std::string &path, bool incremental)
+{
+  KX_GlobalDictStatus *status = new KX_GlobalDictStatus(
+      incremental ? KX_GlobalDictStatus::SAVE_INCREMENTAL : KX_GlobalDictStatus::SAVE, path);
+  PyObject *proxy = status->NewProxy(true);
+  // Keep the status alive until it's finished, the user can drop it before.
+  Py_INCREF(proxy);
+
+  std::vector<KX_GlobalDictStatus::Chunk> &chunks = status->GetChunks();
+  bool success = false;
+
+  PyObject *gameLogic = get_global_dict_module();
+  if (gameLogic) {
+    PyObject *pyGlobalDict = PyDict_GetItemString(PyModule_GetDict(gameLogic), "globalDict");
+    if (pyGlobalDict) {
+      success = true;
+
+      PyObject *key;
+      PyObject *value;
+      Py_ssize_t pos = 0;
+      // Snapshot the items, the worker only deals with bytes.
+      while (PyDict_Next(pyGlobalDict, &pos, &key, &value)) {
+        PyObject *keyMarshal = PyMarshal_WriteObjectToString(key, Py_MARSHAL_VERSION);
+        PyObject *valueMarshal = keyMarshal ?
+                                     PyMarshal_WriteObjectToString(value, Py_MARSHAL_VERSION) :
+                                     nullptr;
+
+        if (valueMarshal) {
+          chunks.push_back({std::string(PyBytes_AS_STRING(keyMarshal),
+                                        PyBytes_GET_SIZE(keyMarshal)),
+                            std::string(PyBytes_AS_STRING(valueMarshal),
+                                        PyBytes_GET_SIZE(valueMarshal))});
+        }
+
+        Py_XDECREF(keyMarshal);
+        Py_XDECREF(valueMarshal);
+
+        if (!valueMarshal) {
+          PyErr_Clear();
+          CM_Error("bge.logic.globalDict could not be marshal'd");
+          success = false;
+          break;
+        }
+      }
+    }
+    else {
+      CM_Error("bge.logic.globalDict was removed");
+    }
+    Py_DECREF(gameLogic);
+  }
+
+  if (success) {
+    BLI_task_pool_push(m_taskPool, SaveTask, status, false, TASK_PRIORITY_LOW);
+  }
+  else {
+    // Nothing to write, report the failure in the next update.
+    AddFinishedStatus(status);
+  }
+
+  return proxy;
+}
+
+PyObject *KX_GlobalDictStorage::Load(const std::string &path)
+{
+  KX_GlobalDictStatus *status = new KX_GlobalDictStatus(KX_GlobalDictStatus::LOAD, path);
+  PyObject *proxy = status->NewProxy(true);
+  Py_INCREF(proxy);
+
+  BLI_task_pool_push(m_taskPool, LoadTask, status, false, TASK_PRIORITY_LOW);
+
+  return proxy;
+}
+
+void KX_GlobalDictStorage::Update()
+{
+  m_mutex.Lock();
+  std::vector<KX_GlobalDictStatus *> finishedStatus;
+  finishedStatus.swap(m_finishedStatus);
+  m_mutex.Unlock();
+
+  for (KX_GlobalDictStatus *status : finishedStatus) {
+    if (status->GetMode() == KX_GlobalDictStatus::LOAD && status->GetSuccess()) {
+      status->SetSuccess(ApplyChunks(status->GetChunks()));
+    }
+
+    status->Finish();
+    // Release the reference taken at the task creation, python may delete the status.
+    Py_DECREF(status->GetProxy());
+  }
+}
+
+void KX_GlobalDictStorage::Finalize()
+{
+  BLI_task_pool_work_and_wait(m_taskPool);
+  Update();
+}
+
+void KX_GlobalDictStorage::AddFinishedStatus(KX_GlobalDictStatus *status)
+{
+  m_mutex.Lock();
+  m_finishedStatus.push_back(status);
+  m_mutex.Unlock();
+}
+
+bool KX_GlobalDictStorage::WriteFile(KX_GlobalDictStatus *status)
+{
+  const std::vector<KX_GlobalDictStatus::Chunk> &chunks = status->GetChunks();
+  std::map<std::string, CachedChunk> &cache = m_cache[status->GetPath()];
+  const bool incremental = (status->GetMode() == KX_GlobalDictStatus::SAVE_INCREMENTAL);
+
+  // Only the current items are kept in the cache, the removed ones are dropped.
+  std::map<std::string, CachedChunk> newCache;
+  int numWrittenKeys = 0;
+
+  for (const KX_GlobalDictStatus::Chunk &chunk : chunks) {
+    std::map<std::string, CachedChunk>::iterator it = cache.find(chunk.m_key);
+    if (incremental && it != cache.end() && it->second.m_value == chunk.m_value) {
+      newCache[chunk.m_key] = std::move(it->second);
+      continue;
+    }
+
+    uLongf compressedSize = compressBound(chunk.m_value.size());
+    std::string compressed(compressedSize, '\0');
+    if (compress2((Bytef *)&compressed[0],
+                  &compressedSize,
+                  (const Bytef *)chunk.m_value.data(),
+                  chunk.m_value.size(),
+                  chunkCompressionLevel) != Z_OK) {
+      CM_Error("could not compress bge.logic.globalDict");
+      // The cache could reference chunks moved from it.
+      m_cache.erase(status->GetPath());
+      return false;
+    }
+    compressed.resize(compressedSize);
+
+    newCache[chunk.m_key] = {chunk.m_value, std::move(compressed)};
+    ++numWrittenKeys;
+  }
+
+  cache.swap(newCache);
+  status->SetNumWrittenKeys(numWrittenKeys);
+
+  // Write in a temporary file first, a failing save never corrupts the previous file.
+  const std::string &path = status->GetPath();
+  const std::string tmpPath = path + ".tmp";
+
+  FILE *fp = BLI_fopen(tmpPath.c_str(), "wb");
+  if (!fp) {
+    CM_Error("could not open '" << tmpPath << "'");
+    return false;
+  }
+
+  bool success = (fwrite(chunkFileMagic, 1, chunkFileMagicSize, fp) == chunkFileMagicSize) &&
+                 write_uint(fp, chunks.size());
+
+  for (std::vector<KX_GlobalDictStatus::Chunk>::const_iterator it = chunks.begin();
+       success && it != chunks.end();
+       ++it) {
+    const CachedChunk &cached = cache[it->m_key];
+    success = write_uint(fp, it->m_key.size()) && write_data(fp, it->m_key) &&
+              write_uint(fp, cached.m_value.size()) && write_uint(fp, cached.m_data.size()) &&
+              write_data(fp, cached.m_data);
+  }
+
+  success = (fclose(fp) == 0) && success;
+
+  if (success) {
+#  ifdef WIN32
+    success = (BLI_rename(tmpPath.c_str(), path.c_str()) == 0);
+#  else
+    // Atomically replace the previous file.
+    success = (rename(tmpPath.c_str(), path.c_str()) == 0);
+#  endif
+  }
+
+  if (!success) {
+    CM_Error("could not write '" << path << "'");
+    BLI_delete(tmpPath.c_str(), false, false);
+  }
+
+  return success;
+}
+
+void KX_GlobalDictStorage::SaveTask(TaskPool *pool, void *taskdata, int UNUSED(threadid))
+{
+  KX_GlobalDictStorage *self = (KX_GlobalDictStorage *)BLI_task_pool_userdata(pool);
+  KX_GlobalDictStatus *status = (KX_GlobalDictStatus *)taskdata;
+
+  self->m_taskMutex.Lock();
+  status->SetSuccess(self->WriteFile(status));
+  self->m_taskMutex.Unlock();
+
+  self->AddFinishedStatus(status);
+}
+
+void KX_GlobalDictStorage::LoadTask(TaskPool *pool, void *taskdata, int UNUSED(threadid))
+{
+  KX_GlobalDictStorage *self = (KX_GlobalDictStorage *)BLI_task_pool_userdata(pool);
+  KX_GlobalDictStatus *status = (KX_GlobalDictStatus *)taskdata;
+  const std::string &path = status->GetPath();
+
+  // Wait for the previous saves.
+  self->m_taskMutex.Lock();
+
+  FILE *fp = BLI_fopen(path.c_str(), "rb");
+  if (fp) {
+    fseek(fp, 0, SEEK_END);
+    const long size = ftell(fp);
+    rewind(fp);
+
+    if (size >= 0) {
+      std::string buffer(size, '\0');
+      if (size == 0 || fread(&buffer[0], 1, size, fp) == (size_t)size) {
+        status->SetSuccess(DecodeFile(buffer.data(), buffer.size(), status->GetChunks()));
+      }
+    }
+
+    if (!status->GetSuccess()) {
+      CM_Error("could not read '" << path << "'");
+    }
+
+    fclose(fp);
+  }
+  else {
+    CM_Error("could not open '" << path << "'");
+  }
+
+  self->m_taskMutex.Unlock();
+
+  self->AddFinishedStatus(status);
+}
+
+bool KX_GlobalDictStorage::DecodeFile(const char *buffer,
+                                      size_t size,
+                                      std::vector<KX_GlobalDictStatus::Chunk> &chunks)
+{
+  // Files written by saveGlobalDict are a single marshalled dict.
+  if (size < chunkFileMagicSize || memcmp(buffer, chunkFileMagic, chunkFileMagicSize) != 0) {
+    chunks.push_back({std::string(), std::string(buffer, size)});
+    return true;
+  }
+
+  const char *end = buffer + size;
+  buffer += chunkFileMagicSize;
+
+  unsigned int numChunks;
+  if (!read_uint(buffer, end, numChunks)) {
+    return false;
+  }
+
+  std::string compressed;
+  for (unsigned int i = 0; i < numChunks; ++i) {
+    KX_GlobalDictStatus::Chunk chunk;
+    unsigned int keySize;
+    unsigned int rawSize;
+    unsigned int compressedSize;
+    if (!read_uint(buffer, end, keySize) || !read_data(buffer, end, keySize, chunk.m_key) ||
+        !read_uint(buffer, end, rawSize) || !read_uint(buffer, end, compressedSize) ||
+        !read_data(buffer, end, compressedSize, compressed)) {
+      return false;
+    }
+
+    chunk.m_value.resize(rawSize);
+    uLongf uncompressedSize = rawSize;
+    if (uncompress((Bytef *)&chunk.m_value[0],
+                   &uncompressedSize,
+                   (const Bytef *)compressed.data(),
+                   compressed.size()) != Z_OK ||
+        uncompressedSize != rawSize) {
+      return false;
+    }
+
+    chunks.push_back(std::move(chunk));
+  }
+
+  return true;
+}
+
+bool KX_GlobalDictStorage::ApplyChunks(const std::vector<KX_GlobalDictStatus::Chunk> &chunks)
+{
+  PyObject *gameLogic = get_global_dict_module();
+  if (!gameLogic) {
+    return false;
+  }
+
+  // Decode all the items before touching globalDict, a corrupted file changes nothing.
+  PyObject *pyNewDict = PyDict_New();
+  bool success = true;
+
+  for (const KX_GlobalDictStatus::Chunk &chunk : chunks) {
+    PyObject *value = PyMarshal_ReadObjectFromString(chunk.m_value.data(),
+                                                     chunk.m_value.size());
+    if (!value) {
+      success = false;
+      break;
+    }
+
+    if (chunk.m_key.empty()) {
+      success = PyDict_Check(value) && (PyDict_Update(pyNewDict, value) == 0);
+    }
+    else {
+      PyObject *key = PyMarshal_ReadObjectFromString(chunk.m_key.data(), chunk.m_key.size());
+      success = key && (PyDict_SetItem(pyNewDict, key, value) == 0);
+      Py_XDECREF(key);
+    }
+
+    Py_DECREF(value);
+
+    if (!success) {
+      break;
+    }
+  }
+
+  if (success) {
+    PyObject *pyGlobalDict = PyDict_GetItemString(PyModule_GetDict(gameLogic), "globalDict");
+    if (pyGlobalDict) {
+      PyDict_Clear(pyGlobalDict);
+      PyDict_Update(pyGlobalDict, pyNewDict);
+    }
+    else {
+      /* this should not happen, but cant find the original globalDict, just assign it then */
+      PyDict_SetItemString(PyModule_GetDict(gameLogic), "globalDict", pyNewDict);
+    }
+  }
+  else {
+    PyErr_Clear();
+    CM_Error("could not marshall string");
+  }
+
+  Py_DECREF(pyNewDict);
+  Py_DECREF(gameLogic);
+
+  return success;
+}
+
+#endif  // WITH_PYTHON
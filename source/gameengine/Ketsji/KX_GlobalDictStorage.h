@@ -0,0 +1,109 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_GlobalDictStorage.h
+ *  \ingroup ketsji
+ *  \brief Save and load bge.logic.globalDict in a worker thread.
+ *
+ * The dict is marshalled by top level item in the logic thread, the items are then
+ * compressed and written in a chunked file by a single worker. Each chunk keeps its
+ * marshalled and compressed data cached so an incremental save only compresses the items
+ * whose marshalled data changed.
+ */
+
+#ifndef __KX_GLOBALDICTSTORAGE_H__
+#define __KX_GLOBALDICTSTORAGE_H__
+
+#ifdef WITH_PYTHON
+
+#  include "KX_GlobalDictStatus.h"
+
+#  include "CM_Thread.h"
+
+#  include <map>
+
+struct TaskPool;
+struct TaskScheduler;
+
+class KX_GlobalDictStorage {
+ private:
+  /// Compressed chunk kept between the saves of a same file.
+  struct CachedChunk {
+    /// Marshalled value, compared to the saved one to find the changed items.
+    std::string m_value;
+    std::string m_data;
+  };
+
+  /// Cached chunks per file path and marshalled key, only used by the tasks.
+  std::map<std::string, std::map<std::string, CachedChunk>> m_cache;
+
+  TaskScheduler *m_taskScheduler;
+  TaskPool *m_taskPool;
+
+  /// Protect m_finishedStatus.
+  CM_ThreadMutex m_mutex;
+  /// Serialize the tasks run by the worker and the ones run in Finalize.
+  CM_ThreadMutex m_taskMutex;
+
+  /// Status of the tasks done but not yet finished in the logic thread.
+  std::vector<KX_GlobalDictStatus *> m_finishedStatus;
+
+  static void SaveTask(TaskPool *pool, void *taskdata, int threadid);
+  static void LoadTask(TaskPool *pool, void *taskdata, int threadid);
+
+  /// Compress and write the chunks of a status, return false on failure.
+  bool WriteFile(KX_GlobalDictStatus *status);
+  /// Push a task's status to the list of status to finish in the logic thread.
+  void AddFinishedStatus(KX_GlobalDictStatus *status);
+
+ public:
+  KX_GlobalDictStorage();
+  ~KX_GlobalDictStorage();
+
+  /** Snapshot bge.logic.globalDict and write it to path in the worker.
+   * \param incremental Reuse the compressed data of the items unchanged since the last save.
+   * \return A new python proxy of the status owned by python.
+   */
+  PyObject *Save(const std::string &path, bool incremental);
+  /** Read and decode the file in the worker, globalDict is replaced in the next Update.
+   * \return A new python proxy of the status owned by python.
+   */
+  PyObject *Load(const std::string &path);
+
+  /// Apply the loaded dicts and run the finish callbacks, called once per logic frame.
+  void Update();
+  /// Wait for all the tasks and finish them, also used before the synchronous save and load.
+  void Finalize();
+
+  /** Decode the content of a chunked file or a legacy marshalled file.
+   * \return false if the file is corrupted.
+   */
+  static bool DecodeFile(const char *buffer,
+                         size_t size,
+                         std::vector<KX_GlobalDictStatus::Chunk> &chunks);
+  /// Replace the content of bge.logic.globalDict by the decoded chunks.
+  static bool ApplyChunks(const std::vector<KX_GlobalDictStatus::Chunk> &chunks);
+};
+
+#endif  // WITH_PYTHON
+
+#endif  // __KX_GLOBALDICTSTORAGE_H__
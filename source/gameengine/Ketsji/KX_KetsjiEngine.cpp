@@ -38,6 +38,8 @@
 
 #include <boost/format.hpp>
 
+#include <algorithm>
+
 #include "BLI_task.h"
 
 #include "KX_KetsjiEngine.h"
@@ -54,6 +56,7 @@
 #include "MT_Vector3.h"
 #include "MT_Transform.h"
 #include "SCA_IInputDevice.h"
+#include "SCA_InputRecorder.h"
 #include "KX_Camera.h"
 #include "KX_Light.h"
 #include "KX_Globals.h"
@@ -63,7 +66,10 @@
 #include "KX_NetworkMessageScene.h"
 
 #include "DEV_Joystick.h"   // for DEV_Joystick::HandleEvents
-#include "KX_PythonInit.h"  // for updatePythonJoysticks
+#include "KX_PythonInit.h"  // for updatePythonJoysticks and updateGlobalDictStorage
+#include "KX_PythonComponentManager.h"
+#include "KX_DepsgraphProfiler.h"
+#include "BL_ActionPoseCache.h"
 
 #include "KX_BlenderConverter.h"
 
@@ -74,6 +80,7 @@
 #include "KX_NavMeshObject.h"
 
 extern "C" {
+#include "BLI_path_util.h"
 #include "GPU_matrix.h"
 }
 
@@ -153,6 +160,7 @@ KX_KetsjiEngine::KX_KetsjiEngine(KX_ISystem *system, bContext *C)
       m_kxsystem(system),
       m_converter(nullptr),
       m_inputDevice(nullptr),
+      m_inputRecorder(nullptr),
       m_bInitialized(false),
       m_flags(AUTO_ADD_DEBUG_PROPERTIES),
       m_frameTime(0.0f),
@@ -172,6 +180,7 @@ KX_KetsjiEngine::KX_KetsjiEngine(KX_ISystem *system, bContext *C)
       m_overrideCamZoom(1.0f),
       m_logger(KX_TimeCategoryLogger(25)),
       m_average_framerate(0.0),
+      m_memoryStatsTime(0.0),
       m_showBoundingBox(KX_DebugOption::DISABLE),
       m_showArmature(KX_DebugOption::DISABLE),
       m_showCameraFrustum(KX_DebugOption::DISABLE),
@@ -216,6 +225,17 @@ void KX_KetsjiEngine::SetInputDevice(SCA_IInputDevice *inputDevice)
   m_inputDevice = inputDevice;
 }
 
+void KX_KetsjiEngine::SetInputRecorder(SCA_InputRecorder *recorder)
+{
+  m_inputRecorder = recorder;
+
+  if (m_inputRecorder) {
+    // The python random generator is seeded from the recording to be replayed identically.
+    MT_srand(GenerateRandomSeed(0));
+    SetFlag(USE_EXTERNAL_CLOCK, m_inputRecorder->GetMode() == SCA_InputRecorder::REPLAY);
+  }
+}
+
 void KX_KetsjiEngine::SetCanvas(RAS_ICanvas *canvas)
 {
   BLI_assert(canvas);
@@ -283,12 +303,29 @@ void KX_KetsjiEngine::EndFrame()
     PyDict_SetItemString(m_pyprofiledict, m_profileLabels[i].c_str(), val);
     Py_DECREF(val);
   }
+
+  // Time spent in the update of each python component class, part of the logic time.
+  for (KX_Scene *scene : m_scenes) {
+    for (const KX_PythonComponentManager::ProfileInfo &info :
+         scene->GetPythonComponentManager()->GetProfileInfo()) {
+      PyObject *val = PyTuple_New(2);
+      PyTuple_SetItem(val, 0, PyFloat_FromDouble(info.m_time * 1000.0));
+      PyTuple_SetItem(val, 1, PyFloat_FromDouble(info.m_time / tottime * 100.0));
+
+      const std::string label = "Component " + scene->GetName() + "." + info.m_name + ":";
+      PyDict_SetItemString(m_pyprofiledict, label.c_str(), val);
+      Py_DECREF(val);
+    }
+  }
 #endif
 
   m_average_framerate = 1.0 / tottime;
 
   // Go to next profiling measurement, time spent after this call is shown in the next frame.
   m_logger.NextMeasurement(m_kxsystem->GetTimeInSeconds());
+  for (KX_Scene *scene : m_scenes) {
+    scene->GetDepsgraphProfiler()->NextMeasurement(GetRealTime());
+  }
 
   m_logger.StartLog(tc_rasterizer, m_kxsystem->GetTimeInSeconds());
   m_rasterizer->EndFrame();
@@ -346,6 +383,13 @@ bool KX_KetsjiEngine::NextFrame()
     }
   }
 
+  /* The clock time and time step are saved by the recorder, or in case of replay
+   * the recorded values are used as external clock. */
+  if (m_inputRecorder && !m_inputRecorder->ProcessClock(m_clockTime, timestep)) {
+    RequestExit(KX_ExitRequest::QUIT_GAME);
+    return false;
+  }
+
   double deltatime = m_clockTime - m_frameTime;
   if (deltatime < 0.0) {
     // We got here too quickly, which means there is nothing to do, just return and don't render.
@@ -381,9 +425,23 @@ bool KX_KetsjiEngine::NextFrame()
     m_frameTime += framestep;
 
     m_converter->MergeAsyncLoads();
+#ifdef WITH_PYTHON
+    updateGlobalDictStorage();
+#endif
 
     if (m_inputDevice) {
-      m_inputDevice->ReleaseMoveEvent();
+      // In replay the recorded inputs already contain the released move events.
+      if (m_inputRecorder && m_inputRecorder->GetMode() == SCA_InputRecorder::REPLAY) {
+        if (!m_inputRecorder->ProcessInputs(m_inputDevice)) {
+          RequestExit(KX_ExitRequest::QUIT_GAME);
+        }
+      }
+      else {
+        m_inputDevice->ReleaseMoveEvent();
+        if (m_inputRecorder) {
+          m_inputRecorder->ProcessInputs(m_inputDevice);
+        }
+      }
     }
 #ifdef WITH_SDL
     // Handle all SDL Joystick events here to share them for all scenes properly.
@@ -688,6 +746,11 @@ void KX_KetsjiEngine::Render()
       }
     }
   }
+
+  for (KX_Scene *scene : m_scenes) {
+    scene->EndRenderFrame();
+  }
+
   Scene *first_scene = m_scenes->GetFront()->GetBlenderScene();
   if (!(first_scene->gm.flag & GAME_USE_VIEWPORT_RENDER && m_canvas->GetARegion())) {
     GPU_matrix_reset();
@@ -1123,6 +1186,157 @@ void KX_KetsjiEngine::RenderDebugProperties()
           MT_Vector2(xcoord + (int)(2.2 * profile_indent), ycoord), boxSize, white);
       ycoord += const_ysize;
     }
+
+    // Python components time by class, already accounted in the logic time.
+    for (KX_Scene *scene : m_scenes) {
+      for (const KX_PythonComponentManager::ProfileInfo &info :
+           scene->GetPythonComponentManager()->GetProfileInfo()) {
+        debugDraw.RenderText2D(
+            info.m_name + ":", MT_Vector2(xcoord + 2 * const_xindent, ycoord), white);
+
+        debugtxt = (boost::format("%5.2fms | %d%% (%d)") % (info.m_time * 1000.f) %
+                    (int)(info.m_time / tottime * 100.f) % info.m_count)
+                       .str();
+        debugDraw.RenderText2D(
+            debugtxt, MT_Vector2(xcoord + const_xindent + profile_indent, ycoord), white);
+        ycoord += const_ysize;
+      }
+    }
+
+    /* Depsgraph updates by scene, already accounted in the rasterizer time. Only the slowest
+     * operation types and IDs are displayed. */
+    static const unsigned int maxDepsgraphInfos = 5;
+    for (KX_Scene *scene : m_scenes) {
+      const KX_DepsgraphProfiler *profiler = scene->GetDepsgraphProfiler();
+      const double depsgraphTime = profiler->GetAverage();
+
+      debugDraw.RenderText2D("Depsgraph " + scene->GetName() + ":",
+                             MT_Vector2(xcoord + 2 * const_xindent, ycoord),
+                             white);
+      debugtxt = (boost::format("%5.2fms | %d%% (%d IDs, %d CoW)") % (depsgraphTime * 1000.f) %
+                  (int)(depsgraphTime / tottime * 100.f) % profiler->GetNumTaggedIds() %
+                  profiler->GetNumCopyOnWrite())
+                     .str();
+      debugDraw.RenderText2D(
+          debugtxt, MT_Vector2(xcoord + const_xindent + profile_indent, ycoord), white);
+      ycoord += const_ysize;
+
+      for (const std::vector<KX_DepsgraphProfiler::ProfileInfo> &infos :
+           {profiler->GetOperationProfileInfo(), profiler->GetIdProfileInfo()}) {
+        const unsigned int size = std::min<size_t>(infos.size(), maxDepsgraphInfos);
+        for (unsigned int i = 0; i < size; ++i) {
+          const KX_DepsgraphProfiler::ProfileInfo &info = infos[i];
+          debugDraw.RenderText2D(
+              info.m_name + ":", MT_Vector2(xcoord + 3 * const_xindent, ycoord), white);
+
+          debugtxt = (boost::format("%5.2fms | %d%%") % (info.m_time * 1000.f) %
+                      (int)(info.m_time / tottime * 100.f))
+                         .str();
+          debugDraw.RenderText2D(
+              debugtxt, MT_Vector2(xcoord + const_xindent + profile_indent, ycoord), white);
+          ycoord += const_ysize;
+        }
+      }
+    }
+
+    // Action samples evaluated and shared between the armatures playing the same frame.
+    for (KX_Scene *scene : m_scenes) {
+      const BL_ActionPoseCache *poseCache = scene->GetActionPoseCache();
+      if (poseCache->GetNumSamples() == 0) {
+        continue;
+      }
+
+      debugDraw.RenderText2D("Poses " + scene->GetName() + ":",
+                             MT_Vector2(xcoord + 2 * const_xindent, ycoord),
+                             white);
+      debugtxt = (boost::format("%d sampled (%d baked) | %d shared") %
+                  poseCache->GetNumSamples() % poseCache->GetNumBakedSamples() %
+                  poseCache->GetNumSharedSamples())
+                     .str();
+      debugDraw.RenderText2D(
+          debugtxt, MT_Vector2(xcoord + const_xindent + profile_indent, ycoord), white);
+      ycoord += const_ysize;
+    }
+
+    // Animated objects updated at full rate, at a reduced rate and culled armatures.
+    for (KX_Scene *scene : m_scenes) {
+      const unsigned int numReduced = scene->GetNumReducedAnimationUpdates();
+      const unsigned int numTime = scene->GetNumTimeAnimationUpdates();
+      if (numReduced == 0 && numTime == 0) {
+        continue;
+      }
+
+      debugDraw.RenderText2D("Animations " + scene->GetName() + ":",
+                             MT_Vector2(xcoord + 2 * const_xindent, ycoord),
+                             white);
+      debugtxt = (boost::format("%d full | %d reduced | %d time only") %
+                  scene->GetNumFullAnimationUpdates() % numReduced % numTime)
+                     .str();
+      debugDraw.RenderText2D(
+          debugtxt, MT_Vector2(xcoord + const_xindent + profile_indent, ycoord), white);
+      ycoord += const_ysize;
+    }
+
+    // Screenshots and captured frames dropped when the readbacks or the encoder lag.
+    if (m_canvas->GetNumScreenshots() > 0) {
+      debugDraw.RenderText2D("Capture:", MT_Vector2(xcoord + 2 * const_xindent, ycoord), white);
+      debugtxt = (boost::format("%d frames | %d dropped") % m_canvas->GetNumScreenshots() %
+                  m_canvas->GetNumDroppedScreenshots())
+                     .str();
+      debugDraw.RenderText2D(
+          debugtxt, MT_Vector2(xcoord + const_xindent + profile_indent, ycoord), white);
+      ycoord += const_ysize;
+    }
+
+    /* Memory used by the converted data, computed again each second to include the data
+     * created lazily like the image buffers. */
+    const double time = m_kxsystem->GetTimeInSeconds();
+    const bool updateMemory = (time - m_memoryStatsTime) > 1.0;
+    if (updateMemory) {
+      m_memoryStatsTime = time;
+    }
+    const KX_MemoryStats &memoryStats = m_converter->GetMemoryStats(updateMemory);
+    const size_t memoryBudget = m_converter->GetMemoryBudget();
+
+    ycoord += title_y_top_margin;
+    debugDraw.RenderText2D(
+        "Memory", MT_Vector2(xcoord + const_xindent + title_xmargin, ycoord), white);
+    ycoord += const_ysize + title_y_bottom_margin;
+
+    for (unsigned short j = KX_MemoryStats::mc_first; j < KX_MemoryStats::mc_numCategories; ++j) {
+      debugDraw.RenderText2D(KX_MemoryStats::m_categoryLabels[j] + ":",
+                             MT_Vector2(xcoord + const_xindent, ycoord),
+                             white);
+
+      debugtxt = (boost::format("%7.2fMB") % (memoryStats.m_categories[j] / 1048576.0)).str();
+      debugDraw.RenderText2D(
+          debugtxt, MT_Vector2(xcoord + const_xindent + profile_indent, ycoord), white);
+      ycoord += const_ysize;
+    }
+
+    debugDraw.RenderText2D("Total:", MT_Vector2(xcoord + const_xindent, ycoord), white);
+    const double total = memoryStats.GetTotal() / 1048576.0;
+    if (memoryBudget > 0) {
+      debugtxt = (boost::format("%7.2fMB / %.2fMB") % total % (memoryBudget / 1048576.0)).str();
+    }
+    else {
+      debugtxt = (boost::format("%7.2fMB") % total).str();
+    }
+    debugDraw.RenderText2D(
+        debugtxt, MT_Vector2(xcoord + const_xindent + profile_indent, ycoord), white);
+    ycoord += const_ysize;
+
+    // Libraries sharing, to find the ones using most of the budget.
+    for (const auto &pair : memoryStats.m_libraries) {
+      debugDraw.RenderText2D(BLI_path_basename(pair.first.c_str()) + std::string(":"),
+                             MT_Vector2(xcoord + 2 * const_xindent, ycoord),
+                             white);
+
+      debugtxt = (boost::format("%7.2fMB") % (pair.second / 1048576.0)).str();
+      debugDraw.RenderText2D(
+          debugtxt, MT_Vector2(xcoord + const_xindent + profile_indent, ycoord), white);
+      ycoord += const_ysize;
+    }
   }
   // Add the ymargin for titles below the other section of debug info
   ycoord += title_y_top_margin;
@@ -1381,6 +1595,18 @@ double KX_KetsjiEngine::GetRealTime(void) const
   return m_kxsystem->GetTimeInSeconds();
 }
 
+long KX_KetsjiEngine::GenerateRandomSeed(intptr_t salt)
+{
+  long seed = (int)(GetRealTime() * 100000.0);
+  seed ^= salt;
+
+  if (m_inputRecorder) {
+    seed = m_inputRecorder->ProcessSeed(seed);
+  }
+
+  return seed;
+}
+
 void KX_KetsjiEngine::SetAnimFrameRate(double framerate)
 {
   m_anim_framerate = framerate;
@@ -50,6 +50,7 @@ class KX_NetworkMessageManager;
 class RAS_ICanvas;
 class RAS_FrameBuffer;
 class SCA_IInputDevice;
+class SCA_InputRecorder;
 struct EEVEE_ViewLayerData;
 
 enum class KX_ExitRequest {
@@ -140,6 +141,8 @@ class KX_KetsjiEngine {
   PyObject *m_pyprofiledict;
 #endif
   SCA_IInputDevice *m_inputDevice;
+  /// Optional recorder or replayer of the inputs, clock and random seeds.
+  SCA_InputRecorder *m_inputRecorder;
 
   /// Lists of scenes scheduled to be removed at the end of the frame.
   std::vector<std::string> m_removingScenes;
@@ -213,6 +216,8 @@ class KX_KetsjiEngine {
   static const std::string m_profileLabels[tc_numCategories];
   /// Last estimated framerate
   double m_average_framerate;
+  /// Time of the last update of the memory statistics displayed with the profile.
+  double m_memoryStatsTime;
 
   /// Enable debug draw of culling bounding boxes.
   KX_DebugOption m_showBoundingBox;
@@ -288,6 +293,10 @@ class KX_KetsjiEngine {
   void SetCanvas(RAS_ICanvas *canvas);
   void SetRasterizer(RAS_Rasterizer *rasterizer);
   void SetNetworkMessageManager(KX_NetworkMessageManager *manager);
+  /** Set the input recorder, in replay mode the clock and the inputs are driven by
+   * the recorder and the engine uses an external clock.
+   */
+  void SetInputRecorder(SCA_InputRecorder *recorder);
 #ifdef WITH_PYTHON
   PyObject *GetPyProfileDict();
 #endif
@@ -309,6 +318,10 @@ class KX_KetsjiEngine {
   {
     return m_inputDevice;
   }
+  SCA_InputRecorder *GetInputRecorder() const
+  {
+    return m_inputRecorder;
+  }
   KX_NetworkMessageManager *GetNetworkMessageManager() const
   {
     return m_networkMessageManager;
@@ -384,6 +397,13 @@ class KX_KetsjiEngine {
    */
   double GetRealTime(void) const;
 
+  /**
+   * Returns a seed for random generators created without user seed. The seed is
+   * recorded or replayed when an input recorder is used.
+   * \param salt Value mixed to the seed to differentiate generators created at the same time.
+   */
+  long GenerateRandomSeed(intptr_t salt);
+
   /**
    * Gets the number of logic updates per second.
    */
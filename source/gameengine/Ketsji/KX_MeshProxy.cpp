@@ -51,6 +51,11 @@
 #  include "EXP_PyObjectPlus.h"
 #  include "EXP_ListWrapper.h"
 
+#  include "KX_Globals.h"
+
+#  include "DNA_mesh_types.h"
+#  include "depsgraph/DEG_depsgraph.h"
+
 PyTypeObject KX_MeshProxy::Type = {PyVarObject_HEAD_INIT(nullptr, 0) "KX_MeshProxy",
                                    sizeof(PyObjectPlus_Proxy),
                                    0,
@@ -98,6 +103,8 @@ PyMethodDef KX_MeshProxy::Methods[] = {
     {"transform", (PyCFunction)KX_MeshProxy::sPyTransform, METH_VARARGS},
     {"transformUV", (PyCFunction)KX_MeshProxy::sPyTransformUV, METH_VARARGS},
     {"replaceMaterial", (PyCFunction)KX_MeshProxy::sPyReplaceMaterial, METH_VARARGS},
+    {"getVertexBuffer", (PyCFunction)KX_MeshProxy::sPyGetVertexBuffer, METH_VARARGS},
+    {"commitVertexBuffer", (PyCFunction)KX_MeshProxy::sPyCommitVertexBuffer, METH_VARARGS},
     {nullptr, nullptr}  // Sentinel
 };
 
@@ -385,6 +392,290 @@ PyObject *KX_MeshProxy::PyReplaceMaterial(PyObject *args, PyObject *kwds)
   Py_RETURN_NONE;
 }
 
+/// Vertex attributes exposed through the buffer protocol.
+enum KX_VertexBufferAttribute {
+  KX_VERTEX_BUFFER_POSITION = 0,
+  KX_VERTEX_BUFFER_NORMAL,
+  KX_VERTEX_BUFFER_TANGENT,
+  KX_VERTEX_BUFFER_UV,
+  KX_VERTEX_BUFFER_COLOR,
+  KX_VERTEX_BUFFER_MAX
+};
+
+static const struct {
+  const char *name;
+  unsigned short modifiedFlag;
+} vertexBufferAttributes[KX_VERTEX_BUFFER_MAX] = {
+    {"position", RAS_IDisplayArray::POSITION_MODIFIED},
+    {"normal", RAS_IDisplayArray::NORMAL_MODIFIED},
+    {"tangent", RAS_IDisplayArray::TANGENT_MODIFIED},
+    {"uv", RAS_IDisplayArray::UVS_MODIFIED},
+    {"color", RAS_IDisplayArray::COLORS_MODIFIED},
+};
+
+static int kx_mesh_proxy_find_vertex_buffer_attribute(const char *name, const char *error_prefix)
+{
+  for (unsigned short i = 0; i < KX_VERTEX_BUFFER_MAX; ++i) {
+    if (strcmp(vertexBufferAttributes[i].name, name) == 0) {
+      return i;
+    }
+  }
+
+  PyErr_Format(PyExc_ValueError,
+               "%s, unknown attribute \"%s\", expected position, normal, tangent, uv or color",
+               error_prefix,
+               name);
+  return -1;
+}
+
+/// Exporter of the view on a vertex attribute, owning a reference to the mesh proxy.
+struct KX_VertexBufferExporter {
+  PyObject_HEAD
+  /// Python proxy of the mesh.
+  PyObject *mesh;
+  void *buf;
+  Py_ssize_t shape[2];
+  Py_ssize_t strides[2];
+  Py_ssize_t itemsize;
+  const char *format;
+};
+
+static int kx_vertex_buffer_getbuffer(PyObject *self, Py_buffer *view, int flags)
+{
+  KX_VertexBufferExporter *exporter = (KX_VertexBufferExporter *)self;
+
+  if ((flags & PyBUF_STRIDES) != PyBUF_STRIDES) {
+    PyErr_SetString(PyExc_BufferError, "vertex buffer: the attribute view is strided");
+    view->obj = nullptr;
+    return -1;
+  }
+
+  view->buf = exporter->buf;
+  view->obj = self;
+  Py_INCREF(self);
+  view->len = exporter->shape[0] * exporter->shape[1] * exporter->itemsize;
+  view->itemsize = exporter->itemsize;
+  view->readonly = 0;
+  view->ndim = 2;
+  view->format = (flags & PyBUF_FORMAT) ? (char *)exporter->format : nullptr;
+  view->shape = exporter->shape;
+  view->strides = exporter->strides;
+  view->suboffsets = nullptr;
+  view->internal = nullptr;
+
+  return 0;
+}
+
+static void kx_vertex_buffer_dealloc(PyObject *self)
+{
+  Py_XDECREF(((KX_VertexBufferExporter *)self)->mesh);
+  PyObject_Del(self);
+}
+
+static PyBufferProcs kx_vertex_buffer_as_buffer = {kx_vertex_buffer_getbuffer, nullptr};
+
+static PyTypeObject KX_VertexBufferExporter_Type = {
+    PyVarObject_HEAD_INIT(nullptr, 0) "KX_VertexBuffer",
+    sizeof(KX_VertexBufferExporter),
+    0,
+    kx_vertex_buffer_dealloc};
+
+/// Initialize the exporter type on first use, return -1 on failure.
+static int kx_vertex_buffer_type_ready()
+{
+  if (KX_VertexBufferExporter_Type.tp_as_buffer) {
+    return 0;
+  }
+
+  KX_VertexBufferExporter_Type.tp_flags = Py_TPFLAGS_DEFAULT;
+  KX_VertexBufferExporter_Type.tp_as_buffer = &kx_vertex_buffer_as_buffer;
+  if (PyType_Ready(&KX_VertexBufferExporter_Type) == -1) {
+    KX_VertexBufferExporter_Type.tp_as_buffer = nullptr;
+    return -1;
+  }
+
+  return 0;
+}
+
+PyObject *KX_MeshProxy::PyGetVertexBuffer(PyObject *args, PyObject *kwds)
+{
+  int matindex;
+  const char *name;
+  int layer = 0;
+
+  if (!PyArg_ParseTuple(args, "is|i:getVertexBuffer", &matindex, &name, &layer)) {
+    return nullptr;
+  }
+
+  const char *error_prefix = "mesh.getVertexBuffer(matid, attribute, layer)";
+
+  RAS_MeshMaterial *mmat = m_meshobj->GetMeshMaterial(matindex); /* can be nullptr*/
+  RAS_IDisplayArray *array = mmat ? mmat->GetDisplayArray() : nullptr;
+  if (!array) {
+    PyErr_Format(PyExc_ValueError, "%s: invalid material index %d", error_prefix, matindex);
+    return nullptr;
+  }
+
+  const int attribute = kx_mesh_proxy_find_vertex_buffer_attribute(name, error_prefix);
+  if (attribute == -1) {
+    return nullptr;
+  }
+
+  /* The view points directly to the interleaved vertex memory of the display array, each
+   * attribute is seen as a (vertex count, component count) array strided by the vertex size
+   * so that numpy operations apply to all the vertices without any copy. */
+  intptr_t offset;
+  Py_ssize_t components;
+  Py_ssize_t itemsize = sizeof(float);
+  const char *format = "f";
+  int layers = 1;
+
+  switch (attribute) {
+    case KX_VERTEX_BUFFER_POSITION: {
+      offset = array->GetVertexXYZOffset();
+      components = 3;
+      break;
+    }
+    case KX_VERTEX_BUFFER_NORMAL: {
+      offset = array->GetVertexNormalOffset();
+      components = 3;
+      break;
+    }
+    case KX_VERTEX_BUFFER_TANGENT: {
+      offset = array->GetVertexTangentOffset();
+      components = 4;
+      break;
+    }
+    case KX_VERTEX_BUFFER_UV: {
+      layers = array->GetVertexUvSize();
+      components = 2;
+      offset = array->GetVertexUVOffset() + layer * components * sizeof(float);
+      break;
+    }
+    case KX_VERTEX_BUFFER_COLOR:
+    default: {
+      layers = array->GetVertexColorSize();
+      components = 4;
+      itemsize = sizeof(unsigned char);
+      format = "B";
+      offset = array->GetVertexColorOffset() + layer * sizeof(unsigned int);
+      break;
+    }
+  }
+
+  if (layer < 0 || layer >= layers) {
+    PyErr_Format(PyExc_ValueError,
+                 "%s: invalid layer %d, the mesh has %d %s layers",
+                 error_prefix,
+                 layer,
+                 layers,
+                 name);
+    return nullptr;
+  }
+
+  if (kx_vertex_buffer_type_ready() == -1) {
+    return nullptr;
+  }
+
+  KX_VertexBufferExporter *exporter = PyObject_New(KX_VertexBufferExporter,
+                                                   &KX_VertexBufferExporter_Type);
+  if (!exporter) {
+    return nullptr;
+  }
+
+  // The exporter keeps the mesh proxy alive as long as a view on its vertices exists.
+  exporter->mesh = GetProxy();
+  exporter->buf = (char *)array->GetVertexPointer() + offset;
+  exporter->shape[0] = array->GetVertexCount();
+  exporter->shape[1] = components;
+  exporter->strides[0] = array->GetVertexMemorySize();
+  exporter->strides[1] = itemsize;
+  exporter->itemsize = itemsize;
+  exporter->format = format;
+
+  PyObject *view = PyMemoryView_FromObject((PyObject *)exporter);
+  Py_DECREF(exporter);
+
+  return view;
+}
+
+PyObject *KX_MeshProxy::PyCommitVertexBuffer(PyObject *args, PyObject *kwds)
+{
+  int matindex = -1;
+  PyObject *pyattributes = nullptr;
+
+  if (!PyArg_ParseTuple(args, "|iO:commitVertexBuffer", &matindex, &pyattributes)) {
+    return nullptr;
+  }
+
+  const char *error_prefix = "mesh.commitVertexBuffer(matid, attributes)";
+
+  unsigned short flag = RAS_IDisplayArray::MESH_MODIFIED;
+  if (pyattributes && pyattributes != Py_None) {
+    PyObject *fast = PySequence_Fast(pyattributes, error_prefix);
+    if (!fast) {
+      return nullptr;
+    }
+
+    flag = RAS_IDisplayArray::NONE_MODIFIED;
+    for (Py_ssize_t i = 0, size = PySequence_Fast_GET_SIZE(fast); i < size; ++i) {
+      const char *name = _PyUnicode_AsString(PySequence_Fast_GET_ITEM(fast, i));
+      const int attribute = name ? kx_mesh_proxy_find_vertex_buffer_attribute(name, error_prefix) :
+                                   -1;
+      if (attribute == -1) {
+        if (!name) {
+          PyErr_Format(PyExc_TypeError, "%s, expected a sequence of strings", error_prefix);
+        }
+        Py_DECREF(fast);
+        return nullptr;
+      }
+      flag |= vertexBufferAttributes[attribute].modifiedFlag;
+    }
+    Py_DECREF(fast);
+  }
+
+  if (matindex < -1 || matindex >= m_meshobj->NumMaterials()) {
+    PyErr_Format(PyExc_ValueError, "%s: invalid material index %d", error_prefix, matindex);
+    return nullptr;
+  }
+
+  if (!m_meshobj->IsOrigMeshWritable()) {
+    PyErr_Format(PyExc_RuntimeError,
+                 "%s: the modifiers of the mesh change its topology, the vertices can't be "
+                 "written back",
+                 error_prefix);
+    return nullptr;
+  }
+
+  // Explicitly committed positions of a deformed mesh would be deformed a second time.
+  if (m_meshobj->m_deformed && pyattributes && pyattributes != Py_None &&
+      (flag & RAS_IDisplayArray::POSITION_MODIFIED)) {
+    PyErr_Format(PyExc_RuntimeError,
+                 "%s: the mesh is deformed by modifiers or shape keys, the positions can't be "
+                 "written back",
+                 error_prefix);
+    return nullptr;
+  }
+
+  for (unsigned short i = 0, num = m_meshobj->NumMaterials(); i < num; ++i) {
+    if (matindex != -1 && matindex != i) {
+      continue;
+    }
+
+    RAS_IDisplayArray *array = m_meshobj->GetMeshMaterial(i)->GetDisplayArray();
+    array->AppendModifiedFlag(flag);
+  }
+
+  // The rendered mesh is the original mesh evaluated by the depsgraph.
+  if (m_meshobj->UpdateOrigMesh()) {
+    Mesh *mesh = m_meshobj->GetOrigMesh();
+    DEG_id_tag_update(&mesh->id, ID_RECALC_GEOMETRY);
+    KX_GetActiveScene()->ResetTaaSamples();
+  }
+
+  Py_RETURN_NONE;
+}
+
 PyObject *KX_MeshProxy::pyattr_get_materials(PyObjectPlus *self_v,
                                              const KX_PYATTRIBUTE_DEF *attrdef)
 {
@@ -77,6 +77,8 @@ class KX_MeshProxy : public CValue {
   KX_PYMETHOD(KX_MeshProxy, Transform);
   KX_PYMETHOD(KX_MeshProxy, TransformUV);
   KX_PYMETHOD(KX_MeshProxy, ReplaceMaterial);
+  KX_PYMETHOD(KX_MeshProxy, GetVertexBuffer);
+  KX_PYMETHOD(KX_MeshProxy, CommitVertexBuffer);
 
   static PyObject *pyattr_get_materials(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
   static PyObject *pyattr_get_numMaterials(PyObjectPlus *self_v,
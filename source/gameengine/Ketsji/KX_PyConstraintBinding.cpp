@@ -111,7 +111,8 @@ PyDoc_STRVAR(gPySetUseEpa__doc__,
              "Very experimental, not recommended");
 PyDoc_STRVAR(gPySetSolverType__doc__,
              "setSolverType(int solverType)\n"
-             "Very experimental, not recommended");
+             "Set the solver type, SOLVER_SEQUENTIAL, SOLVER_PARALLEL_ISLANDS or\n"
+             "SOLVER_PARALLEL_ISLANDS_DETERMINISTIC");
 
 PyDoc_STRVAR(gPyCreateConstraint__doc__,
              "createConstraint(ob1,ob2,float restLength,float restitution,float damping)\n"
@@ -718,6 +719,12 @@ PyMODINIT_FUNC initConstraintPythonBinding()
   KX_MACRO_addTypesToDict(d, VEHICLE_CONSTRAINT, PHY_VEHICLE_CONSTRAINT);
   KX_MACRO_addTypesToDict(d, GENERIC_6DOF_CONSTRAINT, PHY_GENERIC_6DOF_CONSTRAINT);
 
+  // Solver types to be used with setSolverType() python function
+  KX_MACRO_addTypesToDict(d, SOLVER_SEQUENTIAL, PHY_SOLVER_SEQUENTIAL);
+  KX_MACRO_addTypesToDict(d, SOLVER_PARALLEL_ISLANDS, PHY_SOLVER_PARALLEL_ISLANDS);
+  KX_MACRO_addTypesToDict(
+      d, SOLVER_PARALLEL_ISLANDS_DETERMINISTIC, PHY_SOLVER_PARALLEL_ISLANDS_DETERMINISTIC);
+
   // Check for errors
   if (PyErr_Occurred()) {
     Py_FatalError("can't initialize module PhysicsConstraints");
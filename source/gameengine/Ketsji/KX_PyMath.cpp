@@ -209,4 +209,46 @@ PyObject *PyColorFromVector(const MT_Vector3 &vec)
 #  endif
 }
 
+bool PyFloatBufferGet(
+    PyObject *pyval, Py_buffer *view, bool writable, Py_ssize_t size, const char *error_prefix)
+{
+  const int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0);
+  if (PyObject_GetBuffer(pyval, view, flags) == -1) {
+    PyErr_Format(PyExc_TypeError,
+                 "%s, expected a %scontiguous buffer of floats",
+                 error_prefix,
+                 writable ? "writable " : "");
+    return false;
+  }
+
+  // Skip the byte order character, only native order is supported.
+  const char *format = view->format ? view->format : "B";
+  if ((format[0] == '@' || format[0] == '=') && format[1] != '\0') {
+    ++format;
+  }
+
+  if (!((format[0] == 'f' && view->itemsize == sizeof(float)) ||
+        (format[0] == 'd' && view->itemsize == sizeof(double))) ||
+      format[1] != '\0') {
+    PyErr_Format(PyExc_TypeError,
+                 "%s, expected a buffer of 32 or 64 bits floats, not \"%s\"",
+                 error_prefix,
+                 view->format ? view->format : "B");
+    PyBuffer_Release(view);
+    return false;
+  }
+
+  if ((view->len / view->itemsize) < size) {
+    PyErr_Format(PyExc_ValueError,
+                 "%s, buffer too small, expected at least %d floats, got %d",
+                 error_prefix,
+                 (int)size,
+                 (int)(view->len / view->itemsize));
+    PyBuffer_Release(view);
+    return false;
+  }
+
+  return true;
+}
+
 #endif  // WITH_PYTHON
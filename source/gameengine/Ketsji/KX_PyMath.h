@@ -296,6 +296,36 @@ PyObject *PyObjectFrom(const MT_Vector4 &pos);
  */
 PyObject *PyColorFromVector(const MT_Vector3 &vec);
 
+/**
+ * Get a C contiguous buffer of 32 or 64 bits floats from a python object
+ * supporting the buffer protocol (e.g numpy arrays, array.array, memoryview).
+ * The buffer must be released with PyBuffer_Release.
+ * \param writable Request a writable buffer.
+ * \param size The minimal number of floats in the buffer.
+ */
+bool PyFloatBufferGet(
+    PyObject *pyval, Py_buffer *view, bool writable, Py_ssize_t size, const char *error_prefix);
+
+/// Read the float at index in a buffer returned by PyFloatBufferGet.
+inline float PyFloatBufferRead(const Py_buffer *view, Py_ssize_t index)
+{
+  if (view->itemsize == sizeof(double)) {
+    return ((double *)view->buf)[index];
+  }
+  return ((float *)view->buf)[index];
+}
+
+/// Write the float at index in a buffer returned by PyFloatBufferGet.
+inline void PyFloatBufferWrite(Py_buffer *view, Py_ssize_t index, float value)
+{
+  if (view->itemsize == sizeof(double)) {
+    ((double *)view->buf)[index] = value;
+  }
+  else {
+    ((float *)view->buf)[index] = value;
+  }
+}
+
 #endif  // WITH_PYTHON
 
 #endif  // __KX_PYMATH_H__
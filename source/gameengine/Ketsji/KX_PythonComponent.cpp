@@ -32,7 +32,13 @@
 #  include "BKE_python_component.h"
 
 KX_PythonComponent::KX_PythonComponent(const std::string &name)
-    : m_pc(nullptr), m_gameobj(nullptr), m_name(name), m_init(false)
+    : m_pc(nullptr),
+      m_gameobj(nullptr),
+      m_name(name),
+      m_init(false),
+      m_enabled(true),
+      m_updateInterval(1),
+      m_elapsedFrames(0)
 {
 }
 
@@ -66,6 +72,7 @@ void KX_PythonComponent::ProcessReplica()
   CValue::ProcessReplica();
   m_gameobj = nullptr;
   m_init = false;
+  m_elapsedFrames = 0;
 }
 
 KX_GameObject *KX_PythonComponent::GetGameObject() const
@@ -97,17 +104,33 @@ void KX_PythonComponent::Start()
   Py_XDECREF(ret);
 }
 
-void KX_PythonComponent::Update()
+bool KX_PythonComponent::ScheduleUpdate()
+{
+  if (!m_enabled) {
+    return false;
+  }
+
+  if (++m_elapsedFrames < m_updateInterval) {
+    return false;
+  }
+
+  m_elapsedFrames = 0;
+  return true;
+}
+
+void KX_PythonComponent::Update(PyObject *updateFunc)
 {
   if (!m_init) {
     Start();
     m_init = true;
   }
 
-  PyObject *pycomp = GetProxy();
-  if (!PyObject_CallMethod(pycomp, "update", "")) {
+  PyObject *ret = PyObject_CallFunctionObjArgs(updateFunc, GetProxy(), nullptr);
+  if (!ret) {
     PyErr_Print();
   }
+
+  Py_XDECREF(ret);
 }
 
 PyObject *KX_PythonComponent::py_component_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
@@ -167,6 +190,8 @@ PyMethodDef KX_PythonComponent::Methods[] = {
 
 PyAttributeDef KX_PythonComponent::Attributes[] = {
     KX_PYATTRIBUTE_RO_FUNCTION("object", KX_PythonComponent, pyattr_get_object),
+    KX_PYATTRIBUTE_BOOL_RW("enabled", KX_PythonComponent, m_enabled),
+    KX_PYATTRIBUTE_INT_RW("updateInterval", 1, 10000, true, KX_PythonComponent, m_updateInterval),
     KX_PYATTRIBUTE_NULL  // Sentinel
 };
 
@@ -37,6 +37,12 @@ class KX_PythonComponent : public CValue {
   KX_GameObject *m_gameobj;
   std::string m_name;
   bool m_init;
+  /// False when the component is disabled and must not be updated.
+  bool m_enabled;
+  /// Number of logic frames between two updates.
+  int m_updateInterval;
+  /// Number of logic frames elapsed since the last update.
+  int m_elapsedFrames;
 
  public:
   KX_PythonComponent(const std::string &name);
@@ -54,7 +60,15 @@ class KX_PythonComponent : public CValue {
   void SetBlenderPythonComponent(PythonComponent *pc);
 
   void Start();
-  void Update();
+
+  /** Return true if the component must be updated this logic frame, according to its
+   * enabled state and update interval.
+   */
+  bool ScheduleUpdate();
+  /** Update the component by calling the function update of its class.
+   * \param updateFunc The unbound update function of the component class.
+   */
+  void Update(PyObject *updateFunc);
 
   static PyObject *py_component_new(PyTypeObject *type, PyObject *args, PyObject *kwds);
 
@@ -0,0 +1,230 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_PythonComponentManager.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_PythonComponentManager.h"
+#include "KX_PythonComponent.h"
+#include "KX_GameObject.h"
+#include "KX_KetsjiEngine.h"
+#include "KX_Globals.h"
+
+#include <algorithm>
+
+KX_PythonComponentManager::KX_PythonComponentManager()
+    : m_updating(false), m_removedComponents(false)
+{
+}
+
+KX_PythonComponentManager::~KX_PythonComponentManager()
+{
+#ifdef WITH_PYTHON
+  for (ComponentGroup &group : m_groups) {
+    Py_DECREF(group.m_type);
+  }
+#endif  // WITH_PYTHON
+}
+
+void KX_PythonComponentManager::AddComponents(KX_GameObject *gameobj)
+{
+#ifdef WITH_PYTHON
+  for (KX_PythonComponent *comp : gameobj->GetComponents()) {
+    PyTypeObject *type = Py_TYPE(comp->GetProxy());
+
+    std::vector<ComponentGroup>::iterator it = std::find_if(
+        m_groups.begin(), m_groups.end(), [type](const ComponentGroup &group) {
+          return group.m_type == type;
+        });
+
+    if (it == m_groups.end()) {
+      m_groups.emplace_back();
+      it = m_groups.end() - 1;
+      // The class must outlive the group, the components could be freed before it.
+      Py_INCREF(type);
+      it->m_type = type;
+      it->m_name = type->tp_name;
+    }
+
+    it->m_components.push_back(comp);
+  }
+#endif  // WITH_PYTHON
+}
+
+void KX_PythonComponentManager::RemoveComponents(KX_GameObject *gameobj)
+{
+#ifdef WITH_PYTHON
+  for (KX_PythonComponent *comp : gameobj->GetComponents()) {
+    for (ComponentGroup &group : m_groups) {
+      std::vector<KX_PythonComponent *>::iterator it = std::find(
+          group.m_components.begin(), group.m_components.end(), comp);
+      if (it == group.m_components.end()) {
+        continue;
+      }
+
+      // Keep the components order stable while the group is iterated.
+      if (m_updating) {
+        *it = nullptr;
+        m_removedComponents = true;
+      }
+      else {
+        group.m_components.erase(it);
+      }
+      break;
+    }
+  }
+
+  if (!m_updating) {
+    RemoveEmptyGroups();
+  }
+#endif  // WITH_PYTHON
+}
+
+void KX_PythonComponentManager::RemoveEmptyGroups()
+{
+#ifdef WITH_PYTHON
+  for (std::vector<ComponentGroup>::iterator it = m_groups.begin(); it != m_groups.end();) {
+    if (it->m_components.empty()) {
+      Py_DECREF(it->m_type);
+      it = m_groups.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+#endif  // WITH_PYTHON
+}
+
+void KX_PythonComponentManager::RegisterObject(KX_GameObject *gameobj)
+{
+  if (!gameobj->GetComponents()) {
+    return;
+  }
+
+  if (std::find(m_objects.begin(), m_objects.end(), gameobj) != m_objects.end()) {
+    return;
+  }
+
+  m_objects.push_back(gameobj);
+
+  if (m_updating) {
+    m_pendingObjects.push_back(gameobj);
+  }
+  else {
+    AddComponents(gameobj);
+  }
+}
+
+void KX_PythonComponentManager::UnregisterObject(KX_GameObject *gameobj)
+{
+  std::vector<KX_GameObject *>::iterator it = std::find(
+      m_objects.begin(), m_objects.end(), gameobj);
+  if (it == m_objects.end()) {
+    return;
+  }
+
+  m_objects.erase(it);
+
+  it = std::find(m_pendingObjects.begin(), m_pendingObjects.end(), gameobj);
+  if (it != m_pendingObjects.end()) {
+    // The components were never added to the groups.
+    m_pendingObjects.erase(it);
+  }
+  else {
+    RemoveComponents(gameobj);
+  }
+}
+
+void KX_PythonComponentManager::UpdateComponents()
+{
+#ifdef WITH_PYTHON
+  KX_KetsjiEngine *engine = KX_GetActiveEngine();
+
+  /* Components can add or remove objects during their update, the new objects are only
+   * updated from the next frame and the removed components are cleared at the end.
+   */
+  m_updating = true;
+
+  // The groups can't be reallocated during the loop, new objects are pending.
+  for (ComponentGroup &group : m_groups) {
+    group.m_logger.NextMeasurement(engine->GetRealTime());
+
+    if (group.m_components.empty()) {
+      continue;
+    }
+
+    group.m_logger.StartLog(engine->GetRealTime());
+
+    // Lookup the update function once for all the components of the class.
+    PyObject *updateFunc = PyObject_GetAttrString((PyObject *)group.m_type, "update");
+    if (!updateFunc) {
+      PyErr_Print();
+      group.m_logger.EndLog(engine->GetRealTime());
+      continue;
+    }
+
+    for (unsigned int i = 0; i < group.m_components.size(); ++i) {
+      KX_PythonComponent *comp = group.m_components[i];
+      if (comp && comp->ScheduleUpdate()) {
+        comp->Update(updateFunc);
+      }
+    }
+
+    Py_DECREF(updateFunc);
+
+    group.m_logger.EndLog(engine->GetRealTime());
+  }
+
+  m_updating = false;
+
+  if (m_removedComponents) {
+    for (ComponentGroup &group : m_groups) {
+      group.m_components.erase(
+          std::remove(group.m_components.begin(), group.m_components.end(), nullptr),
+          group.m_components.end());
+    }
+    m_removedComponents = false;
+
+    RemoveEmptyGroups();
+  }
+
+  for (KX_GameObject *gameobj : m_pendingObjects) {
+    AddComponents(gameobj);
+  }
+  m_pendingObjects.clear();
+#endif  // WITH_PYTHON
+}
+
+std::vector<KX_PythonComponentManager::ProfileInfo> KX_PythonComponentManager::GetProfileInfo()
+    const
+{
+  std::vector<ProfileInfo> infos;
+  for (const ComponentGroup &group : m_groups) {
+    if (!group.m_components.empty()) {
+      infos.push_back(
+          {group.m_name, group.m_logger.GetAverage(), (unsigned int)group.m_components.size()});
+    }
+  }
+
+  return infos;
+}
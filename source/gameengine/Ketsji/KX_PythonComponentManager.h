@@ -0,0 +1,97 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_PythonComponentManager.h
+ *  \ingroup ketsji
+ *  \brief Registry of the scene objects owning python components, the components are
+ * updated by batches of the same python class.
+ */
+
+#ifndef __KX_PYTHONCOMPONENTMANAGER_H__
+#define __KX_PYTHONCOMPONENTMANAGER_H__
+
+#include "KX_TimeLogger.h"
+
+#include "EXP_Python.h"
+
+#include <vector>
+#include <string>
+
+class KX_GameObject;
+class KX_PythonComponent;
+
+class KX_PythonComponentManager {
+ public:
+  /// Average time spent to update all the components of a python class.
+  struct ProfileInfo {
+    std::string m_name;
+    double m_time;
+    unsigned int m_count;
+  };
+
+ private:
+  /// All the components of a same python class, updated in a single loop.
+  struct ComponentGroup {
+#ifdef WITH_PYTHON
+    /// Python class of the components, a reference is owned by the group.
+    PyTypeObject *m_type;
+#endif
+    std::string m_name;
+    /// Components of the group, nullptr for components removed during an update.
+    std::vector<KX_PythonComponent *> m_components;
+    KX_TimeLogger m_logger;
+  };
+
+  /// Objects owning at least one component.
+  std::vector<KX_GameObject *> m_objects;
+  /// Objects registered during an update, the groups are not modified while updating.
+  std::vector<KX_GameObject *> m_pendingObjects;
+  std::vector<ComponentGroup> m_groups;
+
+  /// True while the components are updated.
+  bool m_updating;
+  /// True when a component was removed during the update.
+  bool m_removedComponents;
+
+  void AddComponents(KX_GameObject *gameobj);
+  void RemoveComponents(KX_GameObject *gameobj);
+  /// Remove the groups without components and release their python class.
+  void RemoveEmptyGroups();
+
+ public:
+  KX_PythonComponentManager();
+  ~KX_PythonComponentManager();
+
+  /// Register an object if it owns components.
+  void RegisterObject(KX_GameObject *gameobj);
+  void UnregisterObject(KX_GameObject *gameobj);
+
+  /** Update all the enabled components of the registered objects, the components
+   * are dispatched by python class with a single lookup of the update function per class.
+   */
+  void UpdateComponents();
+
+  /// Return the average update time of each component class.
+  std::vector<ProfileInfo> GetProfileInfo() const;
+};
+
+#endif  // __KX_PYTHONCOMPONENTMANAGER_H__
@@ -111,6 +111,7 @@ extern "C" {
 #include "EXP_ListValue.h"
 #include "EXP_InputParser.h"
 #include "KX_Scene.h"
+#include "KX_DepsgraphProfiler.h"
 #include "KX_Globals.h"
 
 #include "KX_NetworkMessageScene.h"  //Needed for sendMessage()
@@ -152,6 +153,7 @@ extern "C" {
 /* for converting new scenes */
 #include "KX_BlenderConverter.h"
 #include "KX_LibLoadStatus.h"
+#include "KX_GlobalDictStorage.h"
 #include "KX_MeshProxy.h" /* for creating a new library of mesh objects */
 extern "C" {
 #include "BKE_idcode.h"
@@ -164,6 +166,7 @@ extern "C" {
 static SCA_PythonKeyboard *gp_PythonKeyboard = nullptr;
 static SCA_PythonMouse *gp_PythonMouse = nullptr;
 static SCA_PythonJoystick *gp_PythonJoysticks[JOYINDEX_MAX] = {nullptr};
+static KX_GlobalDictStorage *gp_GlobalDictStorage = nullptr;
 
 static struct {
   PyObject *path;
@@ -279,6 +282,10 @@ PyDoc_STRVAR(gPySaveGlobalDict_doc,
              "Saves bge.logic.globalDict to a file");
 static PyObject *gPySaveGlobalDict(PyObject *)
 {
+  // Write after the pending asynchronous saves and loads of the file.
+  if (gp_GlobalDictStorage) {
+    gp_GlobalDictStorage->Finalize();
+  }
   saveGamePythonConfig();
 
   Py_RETURN_NONE;
@@ -289,11 +296,49 @@ PyDoc_STRVAR(gPyLoadGlobalDict_doc,
              "Loads bge.logic.globalDict from a file");
 static PyObject *gPyLoadGlobalDict(PyObject *)
 {
+  // Apply the pending asynchronous loads first, they must not replace this load afterward.
+  if (gp_GlobalDictStorage) {
+    gp_GlobalDictStorage->Finalize();
+  }
   loadGamePythonConfig();
 
   Py_RETURN_NONE;
 }
 
+static KX_GlobalDictStorage *getGlobalDictStorage()
+{
+  if (!gp_GlobalDictStorage) {
+    gp_GlobalDictStorage = new KX_GlobalDictStorage();
+  }
+  return gp_GlobalDictStorage;
+}
+
+PyDoc_STRVAR(gPySaveGlobalDictAsync_doc,
+             "saveGlobalDictAsync(incremental=False)\n"
+             "Saves bge.logic.globalDict to a file in a separate thread, returns a "
+             "KX_GlobalDictStatus");
+static PyObject *gPySaveGlobalDictAsync(PyObject *, PyObject *args, PyObject *kwds)
+{
+  int incremental = 0;
+  static const char *kwlist[] = {"incremental", nullptr};
+
+  if (!PyArg_ParseTupleAndKeywords(
+          args, kwds, "|i:saveGlobalDictAsync", const_cast<char **>(kwlist), &incremental)) {
+    return nullptr;
+  }
+
+  return getGlobalDictStorage()->Save(pathGamePythonConfig(), incremental);
+}
+
+PyDoc_STRVAR(gPyLoadGlobalDictAsync_doc,
+             "loadGlobalDictAsync()\n"
+             "Loads bge.logic.globalDict from a file in a separate thread, returns a "
+             "KX_GlobalDictStatus");
+static PyObject *gPyLoadGlobalDictAsync(PyObject *)
+{
+  return getGlobalDictStorage()->Load(pathGamePythonConfig());
+}
+
 PyDoc_STRVAR(gPyGetProfileInfo_doc,
              "getProfileInfo()\n"
              "returns a dictionary with profiling information");
@@ -302,6 +347,106 @@ static PyObject *gPyGetProfileInfo(PyObject *)
   return KX_GetActiveEngine()->GetPyProfileDict();
 }
 
+static PyObject *depsgraph_profile_info_dict(
+    const std::vector<KX_DepsgraphProfiler::ProfileInfo> &infos)
+{
+  PyObject *dict = PyDict_New();
+  for (const KX_DepsgraphProfiler::ProfileInfo &info : infos) {
+    PyObject *val = PyFloat_FromDouble(info.m_time * 1000.0);
+    PyDict_SetItemString(dict, info.m_name.c_str(), val);
+    Py_DECREF(val);
+  }
+  return dict;
+}
+
+PyDoc_STRVAR(gPyGetDepsgraphProfileInfo_doc,
+             "getDepsgraphProfileInfo()\n"
+             "returns a dictionary with the depsgraph update timings of each scene");
+static PyObject *gPyGetDepsgraphProfileInfo(PyObject *)
+{
+  PyObject *result = PyDict_New();
+
+  for (KX_Scene *scene : KX_GetActiveEngine()->CurrentScenes()) {
+    const KX_DepsgraphProfiler *profiler = scene->GetDepsgraphProfiler();
+
+    PyObject *item = PyDict_New();
+    PyObject *val = PyFloat_FromDouble(profiler->GetAverage() * 1000.0);
+    PyDict_SetItemString(item, "time", val);
+    Py_DECREF(val);
+    val = PyLong_FromLong(profiler->GetNumTaggedIds());
+    PyDict_SetItemString(item, "tagged_ids", val);
+    Py_DECREF(val);
+    val = PyLong_FromLong(profiler->GetNumCopyOnWrite());
+    PyDict_SetItemString(item, "copy_on_write", val);
+    Py_DECREF(val);
+    val = depsgraph_profile_info_dict(profiler->GetIdProfileInfo());
+    PyDict_SetItemString(item, "ids", val);
+    Py_DECREF(val);
+    val = depsgraph_profile_info_dict(profiler->GetOperationProfileInfo());
+    PyDict_SetItemString(item, "operations", val);
+    Py_DECREF(val);
+
+    PyDict_SetItemString(result, scene->GetName().c_str(), item);
+    Py_DECREF(item);
+  }
+
+  return result;
+}
+
+PyDoc_STRVAR(gPyGetMemoryStats_doc,
+             "getMemoryStats()\n"
+             "returns a dictionary with the estimated memory used by category and by library");
+static PyObject *gPyGetMemoryStats(PyObject *)
+{
+  const KX_MemoryStats &stats = KX_GetActiveEngine()->GetConverter()->GetMemoryStats(true);
+
+  PyObject *categories = PyDict_New();
+  for (unsigned short i = KX_MemoryStats::mc_first; i < KX_MemoryStats::mc_numCategories; ++i) {
+    PyObject *val = PyLong_FromSize_t(stats.m_categories[i]);
+    PyDict_SetItemString(categories, KX_MemoryStats::m_categoryLabels[i].c_str(), val);
+    Py_DECREF(val);
+  }
+
+  PyObject *libraries = PyDict_New();
+  for (const auto &pair : stats.m_libraries) {
+    PyObject *val = PyLong_FromSize_t(pair.second);
+    PyDict_SetItemString(libraries, pair.first.c_str(), val);
+    Py_DECREF(val);
+  }
+
+  PyObject *total = PyLong_FromSize_t(stats.GetTotal());
+
+  PyObject *dict = PyDict_New();
+  PyDict_SetItemString(dict, "total", total);
+  PyDict_SetItemString(dict, "categories", categories);
+  PyDict_SetItemString(dict, "libraries", libraries);
+  Py_DECREF(total);
+  Py_DECREF(categories);
+  Py_DECREF(libraries);
+
+  return dict;
+}
+
+static PyObject *gPySetMemoryBudget(PyObject *, PyObject *args)
+{
+  Py_ssize_t budget;
+  if (!PyArg_ParseTuple(args, "n:setMemoryBudget", &budget))
+    return nullptr;
+
+  if (budget < 0) {
+    PyErr_SetString(PyExc_ValueError, "setMemoryBudget(budget): budget must be positive");
+    return nullptr;
+  }
+
+  KX_GetActiveEngine()->GetConverter()->SetMemoryBudget(budget);
+  Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetMemoryBudget(PyObject *)
+{
+  return PyLong_FromSize_t(KX_GetActiveEngine()->GetConverter()->GetMemoryBudget());
+}
+
 PyDoc_STRVAR(gPySendMessage_doc,
              "sendMessage(subject, [body, to, from])\n"
              "sends a message in same manner as a message actuator"
@@ -679,6 +824,79 @@ static PyObject *gLibLoad(PyObject *, PyObject *args, PyObject *kwds)
   Py_RETURN_FALSE;
 }
 
+static PyObject *gLibStream(PyObject *, PyObject *args, PyObject *kwds)
+{
+  KX_Scene *kx_scene = nullptr;
+  PyObject *pyscene = Py_None;
+  char *path;
+  char *group;
+  char *name;
+  int priority = 0;
+  char *err_str = nullptr;
+
+  static const char *kwlist[] = {"path", "group", "name", "priority", "scene", nullptr};
+
+  if (!PyArg_ParseTupleAndKeywords(args,
+                                   kwds,
+                                   "sss|iO:LibStream",
+                                   const_cast<char **>(kwlist),
+                                   &path,
+                                   &group,
+                                   &name,
+                                   &priority,
+                                   &pyscene))
+    return nullptr;
+
+  if (!ConvertPythonToScene(pyscene, &kx_scene, true, "invalid scene")) {
+    return nullptr;
+  }
+  if (!kx_scene) {
+    kx_scene = KX_GetActiveScene();
+  }
+
+  char abs_path[FILE_MAX];
+  // Make the path absolute
+  BLI_strncpy(abs_path, path, sizeof(abs_path));
+  BLI_path_abs(abs_path, KX_GetMainPath().c_str());
+
+  KX_LibLoadStatus *status = KX_GetActiveEngine()->GetConverter()->LinkBlendFileItem(
+      abs_path, group, name, priority, kx_scene, &err_str);
+  if (status) {
+    return status->GetProxy();
+  }
+
+  PyErr_SetString(PyExc_ValueError, err_str);
+  return nullptr;
+}
+
+static PyObject *gSetLibStreamBudget(PyObject *, PyObject *args)
+{
+  Py_ssize_t budget;
+  if (!PyArg_ParseTuple(args, "n:setLibStreamBudget", &budget))
+    return nullptr;
+
+  if (budget < 0) {
+    PyErr_SetString(PyExc_ValueError, "setLibStreamBudget(budget): budget must be positive");
+    return nullptr;
+  }
+
+  KX_BlenderConverter *converter = KX_GetActiveEngine()->GetConverter();
+  converter->SetStreamBudget(budget);
+  // A bigger budget can allow the waiting items to load.
+  converter->UpdateStreaming();
+  Py_RETURN_NONE;
+}
+
+static PyObject *gGetLibStreamBudget(PyObject *)
+{
+  return PyLong_FromSize_t(KX_GetActiveEngine()->GetConverter()->GetStreamBudget());
+}
+
+static PyObject *gGetLibStreamMemory(PyObject *)
+{
+  return PyLong_FromSize_t(KX_GetActiveEngine()->GetConverter()->GetStreamMemory());
+}
+
 static PyObject *gLibNew(PyObject *, PyObject *args)
 {
   KX_Scene *kx_scene = KX_GetActiveScene();
@@ -794,6 +1012,14 @@ static struct PyMethodDef game_methods[] = {
      (PyCFunction)gPyLoadGlobalDict,
      METH_NOARGS,
      (const char *)gPyLoadGlobalDict_doc},
+    {"saveGlobalDictAsync",
+     (PyCFunction)gPySaveGlobalDictAsync,
+     METH_VARARGS | METH_KEYWORDS,
+     (const char *)gPySaveGlobalDictAsync_doc},
+    {"loadGlobalDictAsync",
+     (PyCFunction)gPyLoadGlobalDictAsync,
+     METH_NOARGS,
+     (const char *)gPyLoadGlobalDictAsync_doc},
     {"sendMessage", (PyCFunction)gPySendMessage, METH_VARARGS, (const char *)gPySendMessage_doc},
     {"getCurrentController",
      (PyCFunction)SCA_PythonController::sPyGetCurrentController,
@@ -919,11 +1145,37 @@ static struct PyMethodDef game_methods[] = {
      METH_NOARGS,
      (const char *)"Render next frame (if Python has control)"},
     {"getProfileInfo", (PyCFunction)gPyGetProfileInfo, METH_NOARGS, gPyGetProfileInfo_doc},
+    {"getDepsgraphProfileInfo",
+     (PyCFunction)gPyGetDepsgraphProfileInfo,
+     METH_NOARGS,
+     gPyGetDepsgraphProfileInfo_doc},
+    {"getMemoryStats", (PyCFunction)gPyGetMemoryStats, METH_NOARGS, gPyGetMemoryStats_doc},
+    {"setMemoryBudget",
+     (PyCFunction)gPySetMemoryBudget,
+     METH_VARARGS,
+     (const char *)"Sets the memory budget of the converted data"},
+    {"getMemoryBudget",
+     (PyCFunction)gPyGetMemoryBudget,
+     METH_NOARGS,
+     (const char *)"Gets the memory budget of the converted data"},
     /* library functions */
     {"LibLoad", (PyCFunction)gLibLoad, METH_VARARGS | METH_KEYWORDS, (const char *)""},
     {"LibNew", (PyCFunction)gLibNew, METH_VARARGS, (const char *)""},
     {"LibFree", (PyCFunction)gLibFree, METH_VARARGS, (const char *)""},
     {"LibList", (PyCFunction)gLibList, METH_VARARGS, (const char *)""},
+    {"LibStream", (PyCFunction)gLibStream, METH_VARARGS | METH_KEYWORDS, (const char *)""},
+    {"setLibStreamBudget",
+     (PyCFunction)gSetLibStreamBudget,
+     METH_VARARGS,
+     (const char *)"Sets the memory budget of the streamed library items"},
+    {"getLibStreamBudget",
+     (PyCFunction)gGetLibStreamBudget,
+     METH_NOARGS,
+     (const char *)"Gets the memory budget of the streamed library items"},
+    {"getLibStreamMemory",
+     (PyCFunction)gGetLibStreamMemory,
+     METH_NOARGS,
+     (const char *)"Gets the estimated memory of the loaded streamed library items"},
 
     {nullptr, (PyCFunction) nullptr, 0, nullptr}};
 
@@ -2206,6 +2458,9 @@ void initGamePlayerPythonScripting(Main *maggie, int argc, char **argv, bContext
 
 void exitGamePlayerPythonScripting()
 {
+  // Finish the pending saves while the python objects are still valid.
+  finalizeGlobalDictStorage();
+
   /* Clean up the Python mouse and keyboard */
   delete gp_PythonKeyboard;
   gp_PythonKeyboard = nullptr;
@@ -2302,6 +2557,9 @@ void initGamePythonScripting(Main *maggie)
 
 void exitGamePythonScripting()
 {
+  // Finish the pending saves while the python objects are still valid.
+  finalizeGlobalDictStorage();
+
   /* Clean up the Python mouse and keyboard */
   delete gp_PythonKeyboard;
   gp_PythonKeyboard = nullptr;
@@ -2394,6 +2652,22 @@ void updatePythonJoysticks(short (&addrem)[JOYINDEX_MAX])
   Py_DECREF(gameLogic);
 }
 
+void updateGlobalDictStorage()
+{
+  if (gp_GlobalDictStorage) {
+    gp_GlobalDictStorage->Update();
+  }
+}
+
+void finalizeGlobalDictStorage()
+{
+  if (gp_GlobalDictStorage) {
+    gp_GlobalDictStorage->Finalize();
+    delete gp_GlobalDictStorage;
+    gp_GlobalDictStorage = nullptr;
+  }
+}
+
 static struct PyModuleDef Rasterizer_module_def = {
     PyModuleDef_HEAD_INIT,
     "Rasterizer",                    /* m_name */
@@ -2837,37 +3111,13 @@ void loadGamePythonConfig()
     int result = fread(marshal_buffer, 1, marshal_length, fp);
 
     if (result == marshal_length) {
-      /* Restore the dict */
-      PyObject *gameLogic = PyImport_ImportModule("GameLogic");
-
-      if (gameLogic) {
-        PyObject *pyGlobalDict = PyMarshal_ReadObjectFromString(marshal_buffer, marshal_length);
-        if (pyGlobalDict) {
-          PyObject *pyGlobalDict_orig = PyDict_GetItemString(
-              PyModule_GetDict(gameLogic), "globalDict");  // Same as importing the module.
-          if (pyGlobalDict_orig) {
-            PyDict_Clear(pyGlobalDict_orig);
-            PyDict_Update(pyGlobalDict_orig, pyGlobalDict);
-          }
-          else {
-            /* this should not happen, but cant find the original globalDict, just assign it then
-             */
-            PyDict_SetItemString(PyModule_GetDict(gameLogic),
-                                 "globalDict",
-                                 pyGlobalDict);  // Same as importing the module.
-          }
-          Py_DECREF(gameLogic);
-          Py_DECREF(pyGlobalDict);
-        }
-        else {
-          Py_DECREF(gameLogic);
-          PyErr_Clear();
-          CM_Error("could not marshall string");
-        }
+      // Restore the dict, the file can be a legacy marshalled dict or a chunked file.
+      std::vector<KX_GlobalDictStatus::Chunk> chunks;
+      if (KX_GlobalDictStorage::DecodeFile(marshal_buffer, marshal_length, chunks)) {
+        KX_GlobalDictStorage::ApplyChunks(chunks);
       }
       else {
-        PyErr_Clear();
-        CM_Error("bge.logic failed to import bge.logic.globalDict will be lost");
+        CM_Error("could not decode '" << marshal_path << "'");
       }
     }
     else {
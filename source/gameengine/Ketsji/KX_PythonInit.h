@@ -65,6 +65,10 @@ void setupGamePython(KX_KetsjiEngine *ketsjiengine,
 std::string pathGamePythonConfig();
 void saveGamePythonConfig();
 void loadGamePythonConfig();
+/// Apply the loaded globalDict and finish the asynchronous saves and loads.
+void updateGlobalDictStorage();
+/// Wait for the asynchronous saves and loads and free their worker.
+void finalizeGlobalDictStorage();
 
 /// Create a python interpreter and stop the engine until the interpreter is active.
 void createPythonConsole();
@@ -53,6 +53,7 @@
 #  include "KX_ConstraintWrapper.h"
 #  include "SCA_GameActuator.h"
 #  include "KX_LibLoadStatus.h"
+#  include "KX_GlobalDictStatus.h"
 #  include "KX_Light.h"
 #  include "KX_LodLevel.h"
 #  include "KX_LodManager.h"
@@ -229,6 +230,7 @@ PyMODINIT_FUNC initGameTypesPythonBinding(void)
     PyType_Ready_Attr(dict, SCA_GameActuator, init_getset);
     PyType_Ready_Attr(dict, KX_GameObject, init_getset);
     PyType_Ready_Attr(dict, KX_LibLoadStatus, init_getset);
+    PyType_Ready_Attr(dict, KX_GlobalDictStatus, init_getset);
     PyType_Ready_Attr(dict, KX_LightObject, init_getset);
     PyType_Ready_Attr(dict, KX_LodLevel, init_getset);
     PyType_Ready_Attr(dict, KX_LodManager, init_getset);
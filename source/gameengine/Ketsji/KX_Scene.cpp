@@ -87,6 +87,9 @@
 #include "KX_BlenderConverter.h"
 #include "KX_MotionState.h"
 #include "KX_ObstacleSimulation.h"
+#include "KX_PythonComponentManager.h"
+#include "KX_DepsgraphProfiler.h"
+#include "BL_ActionPoseCache.h"
 
 #include "KX_BlenderCanvas.h"
 
@@ -105,18 +108,21 @@
 #include "MEM_guardedalloc.h"
 
 extern "C" {
+#include "BLF_api.h"
 #include "BKE_camera.h"
 #include "BKE_collection.h"
 #include "BKE_layer.h"
 #include "BKE_lib_id.h"
 #include "BKE_main.h"
 #include "BKE_object.h"
+#include "depsgraph/DEG_depsgraph_debug.h"
 #include "depsgraph/DEG_depsgraph_query.h"
 #include "ED_view3d.h"
 #include "DNA_mesh_types.h"
 #include "DNA_windowmanager_types.h"
 #include "DRW_render.h"
 #include "GPU_matrix.h"
+#include "GPU_state.h"
 #include "WM_api.h"
 
 // TEST USE_VIEWPORT_RENDER
@@ -149,6 +155,7 @@ static void *KX_SceneDestructionFunc(SG_Node *node, void *gameobj, void *scene)
 
 bool KX_Scene::KX_ScenegraphUpdateFunc(SG_Node *node, void *gameobj, void *scene)
 {
+  ((KX_Scene *)scene)->TagRenderObjectsUpdate();
   return node->Schedule(((KX_Scene *)scene)->m_sghead);
 }
 
@@ -170,11 +177,14 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
                    KX_NetworkMessageManager *messageManager)
     : CValue(),
       m_resetTaaSamples(false),               // eevee
+      m_renderObjectsDirty(true),             // eevee
+      m_renderObjectsStatic(true),            // eevee
       m_lastReplicatedParentObject(nullptr),  // eevee
       m_gameDefaultCamera(nullptr),           // eevee
       m_shadingTypeBackup(0),                 // eevee
       m_shadingFlagBackup(0),                 // eevee
       m_currentGPUViewport(nullptr),          // eevee
+      m_drawObjectList(nullptr),             // eevee
       m_initMaterialsGPUViewport(nullptr),    // eevee (See comment in .h)
       m_overlayCamera(nullptr),               // eevee (For overlay collections)
       m_keyboardmgr(nullptr),
@@ -184,6 +194,7 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
       m_active_camera(nullptr),
       m_overrideCullingCamera(nullptr),
       m_ueberExecutionPriority(0),
+      m_numReplicas(0),
       m_blenderScene(scene),
       m_isActivedHysteresis(false),
       m_lodHysteresisValue(0),
@@ -199,6 +210,19 @@ KX_Scene::KX_Scene(SCA_IInputDevice *inputDevice,
   m_inactivelist = new CListValue<KX_GameObject>();
   m_cameralist = new CListValue<KX_Camera>();
   m_fontlist = new CListValue<KX_FontObject>();
+  m_componentManager = new KX_PythonComponentManager();
+  m_drawObjectList = DRW_game_object_list_create();
+  m_depsgraphProfiler = new KX_DepsgraphProfiler();
+  m_actionPoseCache = new BL_ActionPoseCache();
+
+  // Distance based animation updates are disabled by default.
+  m_animationLodDistances[0] = m_animationLodDistances[1] = m_animationLodDistances[2] = 0.0f;
+  m_animationCulling = false;
+  m_animationFrame = 0;
+  m_animationLodPhase = 0;
+  m_numFullAnimationUpdates = 0;
+  m_numReducedAnimationUpdates = 0;
+  m_numTimeAnimationUpdates = 0;
 
   m_filterManager = new KX_2DFilterManager();
   m_logicmgr = new SCA_LogicManager();
@@ -396,6 +420,22 @@ KX_Scene::~KX_Scene()
     m_fontlist->Release();
   }
 
+  if (m_componentManager) {
+    delete m_componentManager;
+  }
+
+  if (m_depsgraphProfiler) {
+    delete m_depsgraphProfiler;
+  }
+
+  if (m_actionPoseCache) {
+    delete m_actionPoseCache;
+  }
+
+  if (m_drawObjectList) {
+    DRW_game_object_list_free(m_drawObjectList);
+  }
+
   if (m_filterManager) {
     delete m_filterManager;
   }
@@ -542,6 +582,41 @@ void KX_Scene::ResetTaaSamples()
   m_resetTaaSamples = true;
 }
 
+void KX_Scene::TagDrawObjectsUpdate()
+{
+  DRW_game_object_list_tag_dirty(m_drawObjectList);
+}
+
+void KX_Scene::TagRenderObjectsUpdate()
+{
+  m_renderObjectsDirty = true;
+}
+
+void KX_Scene::SyncRenderObjects()
+{
+  /* The blender objects already have the current transforms from a previous pass
+   * (image render during logic, main or overlay camera), only the depsgraph update
+   * is needed for this pass. */
+  if (!m_renderObjectsDirty) {
+    return;
+  }
+
+  for (KX_GameObject *gameobj : GetObjectList()) {
+    gameobj->TagForUpdate();
+  }
+
+  /* Objects static since the previous synchronization could have moved in a former one
+   * of the same frame, keep the TAA reset for all the passes of the frame. */
+  m_renderObjectsStatic = m_renderObjectsStatic && ObjectsAreStatic();
+  m_staticObjects.clear();
+  m_renderObjectsDirty = false;
+}
+
+void KX_Scene::EndRenderFrame()
+{
+  m_renderObjectsStatic = true;
+}
+
 void KX_Scene::AddOverlayCollection(KX_Camera *overlay_cam, Collection *collection)
 {
   /* Check for already added collections */
@@ -572,6 +647,7 @@ void KX_Scene::AddOverlayCollection(KX_Camera *overlay_cam, Collection *collecti
       replica->Release();
     }
   }
+  TagDrawObjectsUpdate();
   ResetTaaSamples();
 }
 
@@ -606,6 +682,7 @@ void KX_Scene::RemoveOverlayCollection(Collection *collection)
     }
     FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
 
+    TagDrawObjectsUpdate();
     ResetTaaSamples();
   }
 }
@@ -672,6 +749,24 @@ bool KX_Scene::CameraIsInactive(KX_Camera *cam)
 static RAS_Rasterizer::FrameBufferType r = RAS_Rasterizer::RAS_FRAMEBUFFER_FILTER0;
 static RAS_Rasterizer::FrameBufferType s = RAS_Rasterizer::RAS_FRAMEBUFFER_EYE_LEFT0;
 
+void KX_Scene::UpdateDepsgraph(Depsgraph *depsgraph, Main *bmain)
+{
+  KX_KetsjiEngine *engine = KX_GetActiveEngine();
+  const bool profile = engine->GetFlag(KX_KetsjiEngine::SHOW_PROFILE);
+  if (DEG_debug_eval_stats_is_enabled(depsgraph) != profile) {
+    DEG_debug_eval_stats_enable(depsgraph, profile);
+  }
+
+  if (!profile) {
+    BKE_scene_graph_update_tagged(depsgraph, bmain);
+    return;
+  }
+
+  m_depsgraphProfiler->BeginUpdate(engine->GetRealTime());
+  BKE_scene_graph_update_tagged(depsgraph, bmain);
+  m_depsgraphProfiler->EndUpdate(depsgraph, engine->GetRealTime());
+}
+
 void KX_Scene::RenderAfterCameraSetup(KX_Camera *cam, bool is_overlay_pass)
 {
   KX_KetsjiEngine *engine = KX_GetActiveEngine();
@@ -686,15 +781,12 @@ void KX_Scene::RenderAfterCameraSetup(KX_Camera *cam, bool is_overlay_pass)
     depsgraph = BKE_scene_get_depsgraph(bmain, scene, view_layer, true);
   }
 
-  BKE_scene_graph_update_tagged(depsgraph, bmain);
+  UpdateDepsgraph(depsgraph, bmain);
 
-  for (KX_GameObject *gameobj : GetObjectList()) {
-    gameobj->TagForUpdate(is_overlay_pass);
-  }
+  SyncRenderObjects();
 
-  bool reset_taa_samples = !ObjectsAreStatic() || m_resetTaaSamples;
+  bool reset_taa_samples = !m_renderObjectsStatic || m_resetTaaSamples;
   m_resetTaaSamples = false;
-  m_staticObjects.clear();
 
   const RAS_Rect *viewport = &canvas->GetViewportArea();
   int v[4] = {viewport->GetLeft(),
@@ -754,7 +846,8 @@ void KX_Scene::RenderAfterCameraSetup(KX_Camera *cam, bool is_overlay_pass)
                        &window,
                        calledFromConstructor,
                        reset_taa_samples,
-                       is_overlay_pass);
+                       is_overlay_pass,
+                       m_drawObjectList);
 
   RAS_FrameBuffer *input = rasty->GetFrameBuffer(rasty->NextFilterFrameBuffer(r));
   RAS_FrameBuffer *output = rasty->GetFrameBuffer(rasty->NextRenderFrameBuffer(s));
@@ -768,6 +861,11 @@ void KX_Scene::RenderAfterCameraSetup(KX_Camera *cam, bool is_overlay_pass)
   GPU_framebuffer_texture_attach(
       input->GetFrameBuffer(), DRW_viewport_texture_list_get()->depth, 0, 0);
 
+  if (cam && !is_overlay_pass) {
+    GPU_framebuffer_bind(input->GetFrameBuffer());
+    RenderFontObjects(cam);
+  }
+
   RAS_FrameBuffer *f = is_overlay_pass ? input : Render2DFilters(rasty, canvas, input, output);
 
   GPU_framebuffer_restore();
@@ -795,6 +893,44 @@ void KX_Scene::RenderAfterCameraSetup(KX_Camera *cam, bool is_overlay_pass)
   rasty->Disable(RAS_Rasterizer::RAS_BLEND);
 }
 
+void KX_Scene::RenderFontObjects(KX_Camera *cam)
+{
+  std::vector<KX_FontObject *> fonts;
+  for (KX_FontObject *font : m_fontlist) {
+    // Overlay collection objects must not show up in the main pass.
+    if (font->IsDynamic() && !(font->GetBlenderObject()->gameflag & OB_OVERLAY_COLLECTION)) {
+      fonts.push_back(font);
+    }
+  }
+
+  if (fonts.empty()) {
+    return;
+  }
+
+  float viewmat[4][4];
+  float winmat[4][4];
+  cam->GetModelviewMatrix().getValue(&viewmat[0][0]);
+  cam->GetProjectionMatrix().getValue(&winmat[0][0]);
+
+  GPU_matrix_push_projection();
+  GPU_matrix_projection_set(winmat);
+  GPU_matrix_push();
+  GPU_matrix_set(viewmat);
+  GPU_depth_test(true);
+
+  /* The glyphs are batched in a single instanced draw as long as the font and the model view
+   * matrix don't change, so all the lines of a text are drawn at once. */
+  BLF_batch_draw_begin();
+  for (KX_FontObject *font : fonts) {
+    font->DrawText();
+  }
+  BLF_batch_draw_end();
+
+  GPU_depth_test(false);
+  GPU_matrix_pop();
+  GPU_matrix_pop_projection();
+}
+
 void KX_Scene::RenderAfterCameraSetupImageRender(KX_Camera *cam,
                                                  RAS_Rasterizer *rasty,
                                                  const rcti *window)
@@ -808,11 +944,9 @@ void KX_Scene::RenderAfterCameraSetupImageRender(KX_Camera *cam,
     depsgraph = BKE_scene_get_depsgraph(bmain, scene, view_layer, true);
   }
 
-  BKE_scene_graph_update_tagged(depsgraph, bmain);
+  UpdateDepsgraph(depsgraph, bmain);
 
-  for (KX_GameObject *gameobj : GetObjectList()) {
-    gameobj->TagForUpdate(false);
-  }
+  SyncRenderObjects();
 
   SetCurrentGPUViewport(cam->GetGPUViewport());
 
@@ -829,7 +963,8 @@ void KX_Scene::RenderAfterCameraSetupImageRender(KX_Camera *cam,
                             winmat,
                             NULL);
 
-  DRW_game_render_loop(C, m_currentGPUViewport, bmain, scene, window, false, true, false);
+  DRW_game_render_loop(
+      C, m_currentGPUViewport, bmain, scene, window, false, true, false, m_drawObjectList);
 }
 
 /******************End of EEVEE INTEGRATION****************************/
@@ -850,6 +985,36 @@ RAS_BucketManager *KX_Scene::GetBucketManager() const
   return m_bucketmanager;
 }
 
+KX_PythonComponentManager *KX_Scene::GetPythonComponentManager() const
+{
+  return m_componentManager;
+}
+
+KX_DepsgraphProfiler *KX_Scene::GetDepsgraphProfiler() const
+{
+  return m_depsgraphProfiler;
+}
+
+BL_ActionPoseCache *KX_Scene::GetActionPoseCache() const
+{
+  return m_actionPoseCache;
+}
+
+unsigned int KX_Scene::GetNumFullAnimationUpdates() const
+{
+  return m_numFullAnimationUpdates;
+}
+
+unsigned int KX_Scene::GetNumReducedAnimationUpdates() const
+{
+  return m_numReducedAnimationUpdates;
+}
+
+unsigned int KX_Scene::GetNumTimeAnimationUpdates() const
+{
+  return m_numTimeAnimationUpdates;
+}
+
 CListValue<KX_GameObject> *KX_Scene::GetObjectList() const
 {
   return m_objectlist;
@@ -956,6 +1121,9 @@ KX_GameObject *KX_Scene::AddNodeReplicaObject(SG_Node *node, KX_GameObject *game
 
   KX_GameObject *newobj = (KX_GameObject *)gameobj->GetReplica();
   m_map_gameobject_to_replica[gameobj] = newobj;
+  if (newobj->IsReplica()) {
+    ++m_numReplicas;
+  }
 
   // also register 'timers' (time properties) of the replica
   int numprops = newobj->GetPropertyCount();
@@ -1017,6 +1185,8 @@ KX_GameObject *KX_Scene::AddNodeReplicaObject(SG_Node *node, KX_GameObject *game
     }
   }
 
+  m_componentManager->RegisterObject(newobj);
+
   // logic cannot be replicated, until the whole hierarchy is replicated.
   m_logicHierarchicalGameObjects.push_back(newobj);
   // replicate controllers of this node
@@ -1445,6 +1615,10 @@ bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
    */
   gameobj->InvalidateProxy();
 
+  if (gameobj->IsReplica()) {
+    --m_numReplicas;
+  }
+
   // keep the blender->game object association up to date
   // note that all the replicas of an object will have the same
   // blender object, that's why we need to check the game object
@@ -1503,6 +1677,8 @@ bool KX_Scene::NewRemoveObject(KX_GameObject *gameobj)
 
   gameobj->RemoveMeshes();
 
+  m_componentManager->UnregisterObject(gameobj);
+
   bool ret = true;
   if (gameobj->GetGameObjectType() == SCA_IObject::OBJ_LIGHT &&
       m_lightlist->RemoveValue(static_cast<KX_LightObject *>(gameobj)))
@@ -1716,10 +1892,73 @@ void KX_Scene::AddAnimatedObject(KX_GameObject *gameobj)
   const std::vector<KX_GameObject *>::const_iterator it = std::find(
       m_animatedlist.begin(), m_animatedlist.end(), gameobj);
   if (it == m_animatedlist.end()) {
+    // Spread the reduced rate updates of the objects over the frames.
+    gameobj->SetAnimationLodPhase(m_animationLodPhase++);
     m_animatedlist.push_back(gameobj);
   }
 }
 
+/** Test if an armature deforms meshes visible by the camera, using the bounds of
+ * its mesh children in rest pose. Armatures without meshes are always visible.
+ */
+static bool armature_in_frustum(KX_GameObject *gameobj, const SG_Frustum &frustum)
+{
+  CListValue<KX_GameObject> *children = gameobj->GetChildren();
+
+  bool has_mesh = false;
+  bool visible = false;
+  for (KX_GameObject *child : children) {
+    Object *ob = child->GetBlenderObject();
+    BoundBox *bb = ob ? BKE_object_boundbox_get(ob) : nullptr;
+    if (!bb) {
+      continue;
+    }
+
+    has_mesh = true;
+    const MT_Transform trans = child->NodeGetWorldTransform();
+    std::array<MT_Vector3, 8> box;
+    for (unsigned short i = 0; i < 8; ++i) {
+      box[i] = trans(MT_Vector3(bb->vec[i]));
+    }
+
+    if (frustum.BoxInsideFrustum(box) != SG_Frustum::OUTSIDE) {
+      visible = true;
+      break;
+    }
+  }
+
+  children->Release();
+
+  return visible || !has_mesh;
+}
+
+unsigned short KX_Scene::GetAnimationUpdateRate(KX_GameObject *gameobj, KX_Camera *cam)
+{
+  // Only the armature poses are worth skipping, the other animations are always applied.
+  const float lodfactor = gameobj->GetAnimationLodFactor();
+  if (!cam || lodfactor == 0.0f || gameobj->GetGameObjectType() != SCA_IObject::OBJ_ARMATURE) {
+    return 1;
+  }
+
+  if (m_animationCulling && !armature_in_frustum(gameobj, cam->GetFrustum())) {
+    return 0;
+  }
+
+  const float factor = lodfactor * cam->GetLodDistanceFactor();
+  const MT_Vector3 delta = gameobj->NodeGetWorldPosition() - cam->NodeGetWorldPosition();
+  const float distance2 = delta.length2() * factor * factor;
+
+  unsigned short rate = 1;
+  for (unsigned short i = 0; i < 3; ++i) {
+    const float lodDistance = m_animationLodDistances[i];
+    if (lodDistance > 0.0f && distance2 >= lodDistance * lodDistance) {
+      rate = 2 << i;
+    }
+  }
+
+  return rate;
+}
+
 static void update_anim_thread_func(TaskPool *pool, void *taskdata, int UNUSED(threadid))
 {
   KX_GameObject *gameobj, *parent;
@@ -1776,12 +2015,36 @@ static void update_anim_thread_func(TaskPool *pool, void *taskdata, int UNUSED(t
 
 void KX_Scene::UpdateAnimations(double curtime)
 {
+  m_actionPoseCache->NextFrame();
+
+  m_numFullAnimationUpdates = 0;
+  m_numReducedAnimationUpdates = 0;
+  m_numTimeAnimationUpdates = 0;
+  ++m_animationFrame;
+
+  // The frustum is the one of the last render, as for the culling.
+  KX_Camera *cam = m_overrideCullingCamera ? m_overrideCullingCamera : m_active_camera;
+
   // m_animationPoolData.curtime = curtime;
 
   for (KX_GameObject *gameobj : m_animatedlist) {
     // BLI_task_pool_push(m_animationPool, update_anim_thread_func, gameobj, false,
     // TASK_PRIORITY_LOW);
-    gameobj->UpdateActionManager(curtime, true);
+    const unsigned short rate = GetAnimationUpdateRate(gameobj, cam);
+    if (rate == 0) {
+      // Culled armatures only manage the time and end of their actions.
+      gameobj->UpdateActionManager(curtime, false);
+      ++m_numTimeAnimationUpdates;
+    }
+    else if (rate == 1) {
+      gameobj->UpdateActionManager(curtime, true);
+      ++m_numFullAnimationUpdates;
+    }
+    else {
+      const bool apply = ((m_animationFrame + gameobj->GetAnimationLodPhase()) % rate) == 0;
+      gameobj->UpdateActionManager(curtime, apply);
+      ++m_numReducedAnimationUpdates;
+    }
   }
 
   // BLI_task_pool_work_and_wait(m_animationPool);
@@ -1789,20 +2052,8 @@ void KX_Scene::UpdateAnimations(double curtime)
 
 void KX_Scene::LogicUpdateFrame(double curtime)
 {
-  /* Update object components, we copy the object pointer in a second list to make sure that we
-   * iterate on a list which will not be modified, indeed components can add objects in theirs
-   * initialization.
-   */
-
-  std::vector<KX_GameObject *> objects;
-  for (KX_GameObject *gameobj : m_objectlist) {
-    objects.push_back(gameobj);
-  }
-
-  for (std::vector<KX_GameObject *>::iterator it = objects.begin(), end = objects.end(); it != end;
-       ++it) {
-    (*it)->UpdateComponents();
-  }
+  // Update object components, only the objects owning components are iterated.
+  m_componentManager->UpdateComponents();
 
   m_logicmgr->UpdateFrame(curtime);
 }
@@ -1840,6 +2091,9 @@ void KX_Scene::UpdateParents(double curtime)
 
   while ((node = SG_Node::GetNextScheduled(m_sghead)) != nullptr) {
     node->UpdateWorldData(curtime);
+    /* Nodes already scheduled when modified again after a render synchronization
+     * didn't call the schedule callback. */
+    m_renderObjectsDirty = true;
   }
 
   // the list must be empty here
@@ -1895,6 +2149,11 @@ int KX_Scene::GetLodHysteresisValue(void)
   return m_lodHysteresisValue;
 }
 
+unsigned int KX_Scene::GetNumReplicas() const
+{
+  return m_numReplicas;
+}
+
 void KX_Scene::UpdateObjectActivity(void)
 {
   if (m_activity_culling) {
@@ -2072,6 +2331,9 @@ bool KX_Scene::MergeScene(KX_Scene *other)
   for (KX_GameObject *gameobj : *other->GetObjectList()) {
     MergeScene_GameObject(gameobj, this, other);
 
+    other->GetPythonComponentManager()->UnregisterObject(gameobj);
+    m_componentManager->RegisterObject(gameobj);
+
     /* add properties to debug list for LibLoad objects */
     if (KX_GetActiveEngine()->GetFlag(KX_KetsjiEngine::AUTO_ADD_DEBUG_PROPERTIES)) {
       AddObjectDebugProperties(gameobj);
@@ -2155,6 +2417,9 @@ bool KX_Scene::MergeScene(KX_Scene *other)
       timemgr->AddTimeProperty(times[i]);
     }
   }
+
+  TagDrawObjectsUpdate();
+
   return true;
 }
 
@@ -2236,6 +2501,10 @@ PyMethodDef KX_Scene::Methods[] = {
     KX_PYMETHODTABLE(KX_Scene, restart),
     KX_PYMETHODTABLE(KX_Scene, replace),
     KX_PYMETHODTABLE(KX_Scene, drawObstacleSimulation),
+    KX_PYMETHODTABLE(KX_Scene, getObjectsAttribute),
+    KX_PYMETHODTABLE(KX_Scene, setObjectsAttribute),
+    KX_PYMETHODTABLE(KX_Scene, getObjectsProperty),
+    KX_PYMETHODTABLE(KX_Scene, setObjectsProperty),
 
     /* dict style access */
     KX_PYMETHODTABLE(KX_Scene, get),
@@ -2518,6 +2787,33 @@ int KX_Scene::pyattr_set_gravity(PyObjectPlus *self_v,
   return PY_SET_ATTR_SUCCESS;
 }
 
+PyObject *KX_Scene::pyattr_get_action_bake_rate(PyObjectPlus *self_v,
+                                                const KX_PYATTRIBUTE_DEF *attrdef)
+{
+  KX_Scene *self = static_cast<KX_Scene *>(self_v);
+
+  return PyFloat_FromDouble(self->m_actionPoseCache->GetBakeRate());
+}
+
+int KX_Scene::pyattr_set_action_bake_rate(PyObjectPlus *self_v,
+                                          const KX_PYATTRIBUTE_DEF *attrdef,
+                                          PyObject *value)
+{
+  KX_Scene *self = static_cast<KX_Scene *>(self_v);
+
+  const double rate = PyFloat_AsDouble(value);
+  /* Also accounts for non float. Nan and infinite rates would bake unbounded samples. */
+  if (!std::isfinite(rate) || rate < 0.0) {
+    PyErr_SetString(PyExc_AttributeError,
+                    "scene.actionBakeRate = float: KX_Scene, expected a finite float zero or "
+                    "above");
+    return PY_SET_ATTR_FAIL;
+  }
+
+  self->m_actionPoseCache->SetBakeRate(rate);
+  return PY_SET_ATTR_SUCCESS;
+}
+
 PyAttributeDef KX_Scene::Attributes[] = {
     KX_PYATTRIBUTE_RO_FUNCTION("name", KX_Scene, pyattr_get_name),
     KX_PYATTRIBUTE_RO_FUNCTION("objects", KX_Scene, pyattr_get_objects),
@@ -2539,6 +2835,11 @@ PyAttributeDef KX_Scene::Attributes[] = {
     KX_PYATTRIBUTE_RW_FUNCTION(
         "pre_draw_setup", KX_Scene, pyattr_get_drawing_callback, pyattr_set_drawing_callback),
     KX_PYATTRIBUTE_RW_FUNCTION("gravity", KX_Scene, pyattr_get_gravity, pyattr_set_gravity),
+    KX_PYATTRIBUTE_RW_FUNCTION(
+        "actionBakeRate", KX_Scene, pyattr_get_action_bake_rate, pyattr_set_action_bake_rate),
+    KX_PYATTRIBUTE_FLOAT_ARRAY_RW(
+        "animationLodDistances", 0.0f, FLT_MAX, KX_Scene, m_animationLodDistances, 3),
+    KX_PYATTRIBUTE_BOOL_RW("animationCulling", KX_Scene, m_animationCulling),
     KX_PYATTRIBUTE_BOOL_RO("activity_culling", KX_Scene, m_activity_culling),
     KX_PYATTRIBUTE_FLOAT_RW(
         "activity_culling_radius", 0.5f, FLT_MAX, KX_Scene, m_activity_box_radius),
@@ -2638,6 +2939,393 @@ KX_PYMETHODDEF_DOC(KX_Scene,
   Py_RETURN_NONE;
 }
 
+bool KX_Scene::ConvertPythonToGameObjectList(PyObject *value,
+                                             std::vector<KX_GameObject *> &objects,
+                                             const char *error_prefix)
+{
+  PyObject *seq = PySequence_Fast(value, error_prefix);
+  if (!seq) {
+    return false;
+  }
+
+  const Py_ssize_t size = PySequence_Fast_GET_SIZE(seq);
+  PyObject **items = PySequence_Fast_ITEMS(seq);
+  objects.resize(size);
+
+  for (Py_ssize_t i = 0; i < size; ++i) {
+    if (!ConvertPythonToGameObject(m_logicmgr, items[i], &objects[i], false, error_prefix)) {
+      Py_DECREF(seq);
+      return false;
+    }
+  }
+
+  Py_DECREF(seq);
+  return true;
+}
+
+/// Game object attributes accessible in bulk.
+enum KX_BulkAttribute {
+  BULK_POS_LOCAL = 0,
+  BULK_POS_GLOBAL,
+  BULK_ORI_LOCAL,
+  BULK_ORI_GLOBAL,
+  BULK_SCALE_LOCAL,
+  BULK_SCALE_GLOBAL,
+  BULK_LINVEL_LOCAL,
+  BULK_LINVEL_GLOBAL,
+  BULK_ANGVEL_LOCAL,
+  BULK_ANGVEL_GLOBAL,
+  BULK_MAX
+};
+
+static const struct {
+  const char *name;
+  /// Number of floats per object.
+  unsigned short size;
+} bulkAttributes[BULK_MAX] = {{"localPosition", 3},
+                              {"worldPosition", 3},
+                              {"localOrientation", 9},
+                              {"worldOrientation", 9},
+                              {"localScale", 3},
+                              {"worldScale", 3},
+                              {"localLinearVelocity", 3},
+                              {"worldLinearVelocity", 3},
+                              {"localAngularVelocity", 3},
+                              {"worldAngularVelocity", 3}};
+
+static int bulk_attribute_find(const char *name, const char *error_prefix)
+{
+  for (int i = 0; i < BULK_MAX; ++i) {
+    if (STREQ(bulkAttributes[i].name, name)) {
+      return i;
+    }
+  }
+
+  PyErr_Format(PyExc_ValueError, "%s, unsupported attribute \"%s\"", error_prefix, name);
+  return -1;
+}
+
+/// Return true if one of the parents of the node was modified and its world transform is outdated.
+static bool bulk_parent_modified(SG_Node *node)
+{
+  for (SG_Node *parent = node->GetSGParent(); parent; parent = parent->GetSGParent()) {
+    if (parent->IsModified()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void bulk_write_vector(Py_buffer *view, Py_ssize_t offset, const MT_Vector3 &vec)
+{
+  for (unsigned short i = 0; i < 3; ++i) {
+    PyFloatBufferWrite(view, offset + i, vec[i]);
+  }
+}
+
+static MT_Vector3 bulk_read_vector(const Py_buffer *view, Py_ssize_t offset)
+{
+  return MT_Vector3(PyFloatBufferRead(view, offset),
+                    PyFloatBufferRead(view, offset + 1),
+                    PyFloatBufferRead(view, offset + 2));
+}
+
+static void bulk_write_matrix(Py_buffer *view, Py_ssize_t offset, const MT_Matrix3x3 &mat)
+{
+  for (unsigned short i = 0; i < 3; ++i) {
+    for (unsigned short j = 0; j < 3; ++j) {
+      PyFloatBufferWrite(view, offset + i * 3 + j, mat[i][j]);
+    }
+  }
+}
+
+static MT_Matrix3x3 bulk_read_matrix(const Py_buffer *view, Py_ssize_t offset)
+{
+  MT_Matrix3x3 mat;
+  for (unsigned short i = 0; i < 3; ++i) {
+    for (unsigned short j = 0; j < 3; ++j) {
+      mat[i][j] = PyFloatBufferRead(view, offset + i * 3 + j);
+    }
+  }
+  return mat;
+}
+
+KX_PYMETHODDEF_DOC(KX_Scene,
+                   getObjectsAttribute,
+                   "getObjectsAttribute(objects, attribute, buffer)\n"
+                   "Write an attribute of all the objects in a contiguous buffer of floats.\n")
+{
+  PyObject *pyobjects;
+  const char *name;
+  PyObject *pybuffer;
+
+  if (!PyArg_ParseTuple(args, "OsO:getObjectsAttribute", &pyobjects, &name, &pybuffer)) {
+    return nullptr;
+  }
+
+  const char *error_prefix = "scene.getObjectsAttribute(objects, attribute, buffer)";
+
+  const int attribute = bulk_attribute_find(name, error_prefix);
+  if (attribute == -1) {
+    return nullptr;
+  }
+
+  std::vector<KX_GameObject *> objects;
+  if (!ConvertPythonToGameObjectList(pyobjects, objects, error_prefix)) {
+    return nullptr;
+  }
+
+  const unsigned short size = bulkAttributes[attribute].size;
+  Py_buffer view;
+  if (!PyFloatBufferGet(pybuffer, &view, true, objects.size() * size, error_prefix)) {
+    return nullptr;
+  }
+
+  for (unsigned int i = 0, len = objects.size(); i < len; ++i) {
+    KX_GameObject *gameobj = objects[i];
+    const Py_ssize_t offset = i * size;
+    switch (attribute) {
+      case BULK_POS_LOCAL: {
+        bulk_write_vector(&view, offset, gameobj->NodeGetLocalPosition());
+        break;
+      }
+      case BULK_POS_GLOBAL: {
+        bulk_write_vector(&view, offset, gameobj->NodeGetWorldPosition());
+        break;
+      }
+      case BULK_ORI_LOCAL: {
+        bulk_write_matrix(&view, offset, gameobj->NodeGetLocalOrientation());
+        break;
+      }
+      case BULK_ORI_GLOBAL: {
+        bulk_write_matrix(&view, offset, gameobj->NodeGetWorldOrientation());
+        break;
+      }
+      case BULK_SCALE_LOCAL: {
+        bulk_write_vector(&view, offset, gameobj->NodeGetLocalScaling());
+        break;
+      }
+      case BULK_SCALE_GLOBAL: {
+        bulk_write_vector(&view, offset, gameobj->NodeGetWorldScaling());
+        break;
+      }
+      case BULK_LINVEL_LOCAL:
+      case BULK_LINVEL_GLOBAL: {
+        bulk_write_vector(
+            &view, offset, gameobj->GetLinearVelocity(attribute == BULK_LINVEL_LOCAL));
+        break;
+      }
+      case BULK_ANGVEL_LOCAL:
+      case BULK_ANGVEL_GLOBAL: {
+        bulk_write_vector(
+            &view, offset, gameobj->GetAngularVelocity(attribute == BULK_ANGVEL_LOCAL));
+        break;
+      }
+    }
+  }
+
+  PyBuffer_Release(&view);
+
+  Py_RETURN_NONE;
+}
+
+KX_PYMETHODDEF_DOC(KX_Scene,
+                   setObjectsAttribute,
+                   "setObjectsAttribute(objects, attribute, buffer)\n"
+                   "Set an attribute of all the objects from a contiguous buffer of floats.\n")
+{
+  PyObject *pyobjects;
+  const char *name;
+  PyObject *pybuffer;
+
+  if (!PyArg_ParseTuple(args, "OsO:setObjectsAttribute", &pyobjects, &name, &pybuffer)) {
+    return nullptr;
+  }
+
+  const char *error_prefix = "scene.setObjectsAttribute(objects, attribute, buffer)";
+
+  const int attribute = bulk_attribute_find(name, error_prefix);
+  if (attribute == -1) {
+    return nullptr;
+  }
+
+  std::vector<KX_GameObject *> objects;
+  if (!ConvertPythonToGameObjectList(pyobjects, objects, error_prefix)) {
+    return nullptr;
+  }
+
+  const unsigned short size = bulkAttributes[attribute].size;
+  Py_buffer view;
+  if (!PyFloatBufferGet(pybuffer, &view, false, objects.size() * size, error_prefix)) {
+    return nullptr;
+  }
+
+  const double time = KX_GetActiveEngine()->GetFrameTime();
+  bool transformModified = false;
+
+  for (unsigned int i = 0, len = objects.size(); i < len; ++i) {
+    KX_GameObject *gameobj = objects[i];
+    const Py_ssize_t offset = i * size;
+
+    /* World space values are converted using the parent world transform, if a parent
+     * was modified previously in this call its transform must be updated first. */
+    if (ELEM(attribute, BULK_POS_GLOBAL, BULK_ORI_GLOBAL, BULK_SCALE_GLOBAL) &&
+        transformModified && bulk_parent_modified(gameobj->GetSGNode())) {
+      UpdateParents(time);
+    }
+
+    switch (attribute) {
+      case BULK_POS_LOCAL: {
+        gameobj->NodeSetLocalPosition(bulk_read_vector(&view, offset));
+        break;
+      }
+      case BULK_POS_GLOBAL: {
+        gameobj->NodeSetWorldPosition(bulk_read_vector(&view, offset));
+        break;
+      }
+      case BULK_ORI_LOCAL: {
+        gameobj->NodeSetLocalOrientation(bulk_read_matrix(&view, offset));
+        break;
+      }
+      case BULK_ORI_GLOBAL: {
+        gameobj->NodeSetGlobalOrientation(bulk_read_matrix(&view, offset));
+        break;
+      }
+      case BULK_SCALE_LOCAL: {
+        gameobj->NodeSetLocalScale(bulk_read_vector(&view, offset));
+        break;
+      }
+      case BULK_SCALE_GLOBAL: {
+        gameobj->NodeSetWorldScale(bulk_read_vector(&view, offset));
+        break;
+      }
+      case BULK_LINVEL_LOCAL:
+      case BULK_LINVEL_GLOBAL: {
+        gameobj->setLinearVelocity(bulk_read_vector(&view, offset),
+                                   attribute == BULK_LINVEL_LOCAL);
+        break;
+      }
+      case BULK_ANGVEL_LOCAL:
+      case BULK_ANGVEL_GLOBAL: {
+        gameobj->setAngularVelocity(bulk_read_vector(&view, offset),
+                                    attribute == BULK_ANGVEL_LOCAL);
+        break;
+      }
+    }
+
+    transformModified = (attribute < BULK_LINVEL_LOCAL);
+  }
+
+  PyBuffer_Release(&view);
+
+  /* The modified nodes were scheduled by the setters, update all of them at once
+   * instead of one subtree per object. */
+  if (transformModified) {
+    UpdateParents(time);
+  }
+
+  Py_RETURN_NONE;
+}
+
+KX_PYMETHODDEF_DOC(KX_Scene,
+                   getObjectsProperty,
+                   "getObjectsProperty(objects, name, buffer, default=0.0)\n"
+                   "Write a numeric property of all the objects in a contiguous buffer of "
+                   "floats.\n")
+{
+  PyObject *pyobjects;
+  const char *name;
+  PyObject *pybuffer;
+  float def = 0.0f;
+
+  if (!PyArg_ParseTuple(args, "OsO|f:getObjectsProperty", &pyobjects, &name, &pybuffer, &def)) {
+    return nullptr;
+  }
+
+  const char *error_prefix = "scene.getObjectsProperty(objects, name, buffer, default)";
+
+  std::vector<KX_GameObject *> objects;
+  if (!ConvertPythonToGameObjectList(pyobjects, objects, error_prefix)) {
+    return nullptr;
+  }
+
+  Py_buffer view;
+  if (!PyFloatBufferGet(pybuffer, &view, true, objects.size(), error_prefix)) {
+    return nullptr;
+  }
+
+  const std::string propname(name);
+  for (unsigned int i = 0, len = objects.size(); i < len; ++i) {
+    CValue *prop = objects[i]->GetProperty(propname);
+    PyFloatBufferWrite(&view, i, prop ? prop->GetNumber() : def);
+  }
+
+  PyBuffer_Release(&view);
+
+  Py_RETURN_NONE;
+}
+
+KX_PYMETHODDEF_DOC(KX_Scene,
+                   setObjectsProperty,
+                   "setObjectsProperty(objects, name, buffer)\n"
+                   "Set a numeric property of all the objects from a contiguous buffer of "
+                   "floats.\n")
+{
+  PyObject *pyobjects;
+  const char *name;
+  PyObject *pybuffer;
+
+  if (!PyArg_ParseTuple(args, "OsO:setObjectsProperty", &pyobjects, &name, &pybuffer)) {
+    return nullptr;
+  }
+
+  const char *error_prefix = "scene.setObjectsProperty(objects, name, buffer)";
+
+  std::vector<KX_GameObject *> objects;
+  if (!ConvertPythonToGameObjectList(pyobjects, objects, error_prefix)) {
+    return nullptr;
+  }
+
+  Py_buffer view;
+  if (!PyFloatBufferGet(pybuffer, &view, false, objects.size(), error_prefix)) {
+    return nullptr;
+  }
+
+  const std::string propname(name);
+  // Value reused to set existing properties without allocating one value per object.
+  CFloatValue *value = new CFloatValue(0.0f);
+
+  for (unsigned int i = 0, len = objects.size(); i < len; ++i) {
+    KX_GameObject *gameobj = objects[i];
+    value->SetFloat(PyFloatBufferRead(&view, i));
+
+    CValue *prop = gameobj->GetProperty(propname);
+    if (!prop) {
+      CValue *newprop = new CFloatValue(value->GetFloat());
+      gameobj->SetProperty(propname, newprop);
+      newprop->Release();
+    }
+    else if (ELEM(prop->GetValueType(), VALUE_INT_TYPE, VALUE_FLOAT_TYPE, VALUE_BOOL_TYPE)) {
+      prop->SetValue(value);
+    }
+    else {
+      PyErr_Format(PyExc_TypeError,
+                   "%s, property \"%s\" of object \"%s\" is not a number",
+                   error_prefix,
+                   name,
+                   gameobj->GetName().c_str());
+      value->Release();
+      PyBuffer_Release(&view);
+      return nullptr;
+    }
+  }
+
+  value->Release();
+  PyBuffer_Release(&view);
+
+  Py_RETURN_NONE;
+}
+
 /* Matches python dict.get(key, [default]) */
 KX_PYMETHODDEF_DOC(KX_Scene, get, "")
 {
@@ -88,7 +88,12 @@ class btCollisionShape;
 class KX_BlenderSceneConverter;
 struct KX_ClientObjectInfo;
 class KX_ObstacleSimulation;
+class KX_PythonComponentManager;
+class KX_DepsgraphProfiler;
+class BL_ActionPoseCache;
 struct TaskPool;
+struct Depsgraph;
+struct Main;
 
 /*********EEVEE INTEGRATION************/
 struct GPUTexture;
@@ -125,12 +130,18 @@ class KX_Scene : public CValue, public SCA_IScene {
 
   int m_taaSamplesBackup;
   bool m_resetTaaSamples;
+  /// An object transform changed since the last synchronization with blender objects.
+  bool m_renderObjectsDirty;
+  /// No object moved in the synchronizations done since the last rendered frame.
+  bool m_renderObjectsStatic;
   Object *m_lastReplicatedParentObject;
   Object *m_gameDefaultCamera;
   int m_shadingTypeBackup;
   int m_shadingFlagBackup;
   std::vector<struct Collection *> m_overlay_collections;
   struct GPUViewport *m_currentGPUViewport;
+  /// List of the objects populated by the draw manager, kept between the frames.
+  struct DRWGameObjectList *m_drawObjectList;
   /* In the current state of the code, we need this
    * to Initialize KX_BlenderMaterial and BL_Texture.
    * BL_Texture(s) is/are used for ImageRender.
@@ -162,6 +173,24 @@ class KX_Scene : public CValue, public SCA_IScene {
   CListValue<KX_Camera> *m_cameralist;
   /// The set of fonts for this scene
   CListValue<KX_FontObject> *m_fontlist;
+  /// Registry of the active objects owning python components.
+  KX_PythonComponentManager *m_componentManager;
+  /// Timings of the depsgraph updates, gathered when the profile is shown.
+  KX_DepsgraphProfiler *m_depsgraphProfiler;
+  /// Action samples shared by the armatures of the scene.
+  BL_ActionPoseCache *m_actionPoseCache;
+
+  /// Camera distances from which the armatures are updated every 2nd, 4th and 8th frame.
+  float m_animationLodDistances[3];
+  /// Only manage the actions time of the armatures outside of the camera frustum.
+  bool m_animationCulling;
+  /// Number of animation updates, used to select the frames of the reduced rate updates.
+  unsigned int m_animationFrame;
+  /// Phase given to the next animated object.
+  unsigned int m_animationLodPhase;
+  unsigned int m_numFullAnimationUpdates;
+  unsigned int m_numReducedAnimationUpdates;
+  unsigned int m_numTimeAnimationUpdates;
 
   SG_QList m_sghead;  // list of nodes that needs scenegraph update
                       // the Dlist is not object that must be updated
@@ -248,6 +277,9 @@ class KX_Scene : public CValue, public SCA_IScene {
    */
   int m_ueberExecutionPriority;
 
+  /// Number of replicated objects alive, each owns a copy of its blender object.
+  unsigned int m_numReplicas;
+
   /**
    * Radius in Manhattan distance of the box for activity culling.
    */
@@ -300,6 +332,14 @@ class KX_Scene : public CValue, public SCA_IScene {
   bool m_isActivedHysteresis;
   int m_lodHysteresisValue;
 
+  /// Evaluate the tagged IDs, logging the evaluation statistics when the profile is shown.
+  void UpdateDepsgraph(Depsgraph *depsgraph, Main *bmain);
+
+  /** Get the number of frames between two pose updates of an animated object.
+   * \return 0 if the object is an armature outside of the camera frustum.
+   */
+  unsigned short GetAnimationUpdateRate(KX_GameObject *gameobj, KX_Camera *cam);
+
  public:
   KX_Scene(SCA_IInputDevice *inputDevice,
            const std::string &scenename,
@@ -313,11 +353,25 @@ class KX_Scene : public CValue, public SCA_IScene {
   void AppendToStaticObjects(KX_GameObject *gameobj);
   bool ObjectsAreStatic();
   void ResetTaaSamples();
+  /// The objects to draw changed (added, removed or hidden), gather them again at next render.
+  void TagDrawObjectsUpdate();
+  /// An object transform changed, synchronize the blender objects at next render pass.
+  void TagRenderObjectsUpdate();
+  /** Copy the object transforms to the blender objects, only once for all the render passes
+   * (main, overlay and image render cameras) when nothing moved in between.
+   */
+  void SyncRenderObjects();
+  /// All the passes of the frame were rendered, start to look for moved objects again.
+  void EndRenderFrame();
 
   bool m_isRuntime;  // Too lazy to put that in protected
   std::vector<Object *> m_hiddenObjectsDuringRuntime;
 
   void RenderAfterCameraSetup(KX_Camera *cam, bool is_overlay_pass);
+  /** Draw the dynamic texts of the font objects in the bound frame buffer, without culling.
+   * The texts of the overlay collection are not drawn, dynamic texts are main pass only.
+   */
+  void RenderFontObjects(KX_Camera *cam);
   void RenderAfterCameraSetupImageRender(KX_Camera *cam,
                                          RAS_Rasterizer *rasty,
                                          const struct rcti *window);
@@ -479,6 +533,9 @@ class KX_Scene : public CValue, public SCA_IScene {
   void SetLodHysteresisValue(int hysteresisvalue);
   int GetLodHysteresisValue();
 
+  /// Return the number of replicated objects in the scene.
+  unsigned int GetNumReplicas() const;
+
   // Update the activity box settings for objects in this scene, if needed.
   void UpdateObjectActivity(void);
 
@@ -528,6 +585,17 @@ class KX_Scene : public CValue, public SCA_IScene {
                                    RAS_FrameBuffer *inputfb,
                                    RAS_FrameBuffer *targetfb);
 
+  KX_PythonComponentManager *GetPythonComponentManager() const;
+  KX_DepsgraphProfiler *GetDepsgraphProfiler() const;
+  BL_ActionPoseCache *GetActionPoseCache() const;
+
+  /// Number of animated objects updated at full rate during the last animation update.
+  unsigned int GetNumFullAnimationUpdates() const;
+  /// Number of armatures updated at a reduced rate during the last animation update.
+  unsigned int GetNumReducedAnimationUpdates() const;
+  /// Number of armatures outside of the camera frustum during the last animation update.
+  unsigned int GetNumTimeAnimationUpdates() const;
+
   KX_ObstacleSimulation *GetObstacleSimulation()
   {
     return m_obstacleSimulation;
@@ -550,6 +618,17 @@ class KX_Scene : public CValue, public SCA_IScene {
   KX_PYMETHOD_DOC(KX_Scene, replace);
   KX_PYMETHOD_DOC(KX_Scene, get);
   KX_PYMETHOD_DOC(KX_Scene, drawObstacleSimulation);
+  KX_PYMETHOD_DOC(KX_Scene, getObjectsAttribute);
+  KX_PYMETHOD_DOC(KX_Scene, setObjectsAttribute);
+  KX_PYMETHOD_DOC(KX_Scene, getObjectsProperty);
+  KX_PYMETHOD_DOC(KX_Scene, setObjectsProperty);
+
+  /** Convert a python sequence of game objects or names to a vector of game objects.
+   * Return false and raise a python exception if an item is not a game object of this scene.
+   */
+  bool ConvertPythonToGameObjectList(PyObject *value,
+                                     std::vector<KX_GameObject *> &objects,
+                                     const char *error_prefix);
 
   /* attributes */
   static PyObject *pyattr_get_name(PyObjectPlus *self_v, const KX_PYATTRIBUTE_DEF *attrdef);
@@ -580,6 +659,11 @@ class KX_Scene : public CValue, public SCA_IScene {
   static int pyattr_set_gravity(PyObjectPlus *self_v,
                                 const KX_PYATTRIBUTE_DEF *attrdef,
                                 PyObject *value);
+  static PyObject *pyattr_get_action_bake_rate(PyObjectPlus *self_v,
+                                               const KX_PYATTRIBUTE_DEF *attrdef);
+  static int pyattr_set_action_bake_rate(PyObjectPlus *self_v,
+                                         const KX_PYATTRIBUTE_DEF *attrdef,
+                                         PyObject *value);
 
   /* getitem/setitem */
   static PyMappingMethods Mapping;
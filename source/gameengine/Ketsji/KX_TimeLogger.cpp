@@ -72,6 +72,13 @@ void KX_TimeLogger::EndLog(double now)
   }
 }
 
+void KX_TimeLogger::AddTime(double time)
+{
+  if (m_measurements.size() > 0) {
+    m_measurements[0] += time;
+  }
+}
+
 void KX_TimeLogger::NextMeasurement(double now)
 {
   // End logging to current measurement
@@ -76,6 +76,12 @@ class KX_TimeLogger {
    */
   void EndLog(double now);
 
+  /**
+   * Adds a time measured elsewhere to the current measurement.
+   * \param time	The measured time.
+   */
+  void AddTime(double time);
+
   /**
    * Logs time in next measurement.
    * \param now	The current time.
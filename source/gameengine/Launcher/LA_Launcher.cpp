@@ -59,6 +59,8 @@
 
 #include "DEV_Joystick.h"
 
+#include "SCA_InputRecorder.h"
+
 #include "CM_Message.h"
 
 #include "MEM_guardedalloc.h"
@@ -67,6 +69,11 @@ extern "C" {
 #include "GPU_extensions.h"
 #include "GPU_framebuffer.h"
 
+#include "PIL_time.h"
+
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+
 #include "BKE_idprop.h"
 #include "BKE_layer.h"
 #include "BKE_sound.h"
@@ -100,6 +107,10 @@ LA_Launcher::LA_Launcher(GHOST_ISystem *system,
       m_kxsystem(nullptr),
       m_inputDevice(nullptr),
       m_eventConsumer(nullptr),
+      m_inputRecorder(nullptr),
+      m_inputRecorderStartTime(0.0),
+      m_captureFramesLeft(-1),
+      m_loadStartTime(-1.0),
       m_canvas(nullptr),
       m_rasterizer(nullptr),
       m_converter(nullptr),
@@ -127,6 +138,11 @@ void LA_Launcher::SetPythonGlobalDict(PyObject *globalDict)
 }
 #endif  // WITH_PYTHON
 
+void LA_Launcher::SetLoadStartTime(double time)
+{
+  m_loadStartTime = time;
+}
+
 KX_ExitRequest LA_Launcher::GetExitRequested()
 {
   return m_exitRequested;
@@ -242,8 +258,12 @@ void LA_Launcher::InitEngine()
   // Set the global settings (carried over if restart/load new files).
   m_ketsjiEngine->SetGlobalSettings(m_globalSettings);
 
+  // Must be set before any conversion to record the random seeds.
+  InitInputRecorder();
+
   m_rasterizer->Init(m_canvas);
   InitCamera();
+  InitCapture();
 
 #ifdef WITH_PYTHON
   KX_SetMainPath(std::string(m_maggie->name));
@@ -292,6 +312,11 @@ void LA_Launcher::ExitEngine()
   DEV_Joystick::Close();
   m_ketsjiEngine->StopEngine();
 
+  // Save the screenshots still read by the GPU and end the capture while the rasterizer exists.
+  m_canvas->FinishScreenshots();
+
+  ExitInputRecorder();
+
 #ifdef WITH_PYTHON
 
   /* Clears the dictionary by hand:
@@ -366,6 +391,77 @@ void LA_Launcher::ExitEngine()
   m_exitRequested = KX_ExitRequest::NO_REQUEST;
 }
 
+void LA_Launcher::InitInputRecorder()
+{
+  SYS_SystemHandle syshandle = SYS_GetSystem();
+
+  const std::string recordPath = SYS_GetCommandLineString(syshandle, "record_input", "");
+  const std::string replayPath = SYS_GetCommandLineString(syshandle, "replay_input", "");
+
+  if (!replayPath.empty()) {
+    m_inputRecorder = new SCA_InputRecorder(replayPath, SCA_InputRecorder::REPLAY);
+    // Allow to replay without rendering to benchmark only logic, physics and animations.
+    if (SYS_GetCommandLineInt(syshandle, "replay_render", 1) == 0) {
+      m_ketsjiEngine->SetRender(false);
+    }
+  }
+  else if (!recordPath.empty()) {
+    m_inputRecorder = new SCA_InputRecorder(recordPath, SCA_InputRecorder::RECORD);
+  }
+  else {
+    return;
+  }
+
+  if (!m_inputRecorder->IsValid()) {
+    delete m_inputRecorder;
+    m_inputRecorder = nullptr;
+    return;
+  }
+
+  m_ketsjiEngine->SetInputRecorder(m_inputRecorder);
+  m_inputRecorderStartTime = m_kxsystem->GetTimeInSeconds();
+}
+
+void LA_Launcher::ExitInputRecorder()
+{
+  if (!m_inputRecorder) {
+    return;
+  }
+
+  const double duration = m_kxsystem->GetTimeInSeconds() - m_inputRecorderStartTime;
+  const unsigned int frames = m_inputRecorder->GetFrameCount();
+  CM_Message("input " << ((m_inputRecorder->GetMode() == SCA_InputRecorder::RECORD) ? "record" :
+                                                                                       "replay")
+                      << ": " << frames << " logic frames in " << duration << " s ("
+                      << ((duration > 0.0) ? frames / duration : 0.0) << " frames/s)");
+
+  m_ketsjiEngine->SetInputRecorder(nullptr);
+  delete m_inputRecorder;
+  m_inputRecorder = nullptr;
+}
+
+void LA_Launcher::InitCapture()
+{
+  SYS_SystemHandle syshandle = SYS_GetSystem();
+
+  const std::string capturePath = SYS_GetCommandLineString(syshandle, "capture", "");
+  if (capturePath.empty()) {
+    return;
+  }
+
+  char path[FILE_MAX];
+  BLI_strncpy(path, capturePath.c_str(), FILE_MAX);
+  BLI_path_abs(path, m_maggie->name);
+
+  // The format and the movie settings are the output settings of the start scene.
+  if (!m_canvas->StartCapture(path, m_startScene)) {
+    return;
+  }
+
+  const int frames = SYS_GetCommandLineInt(syshandle, "capture_frames", 0);
+  m_captureFramesLeft = (frames > 0) ? frames : -1;
+}
+
 #ifdef WITH_PYTHON
 
 void LA_Launcher::HandlePythonConsole()
@@ -468,6 +564,17 @@ bool LA_Launcher::EngineNextFrame()
   if (m_exitRequested == KX_ExitRequest::NO_REQUEST) {
     if (renderFrame) {
       RenderEngine();
+
+      if (m_loadStartTime >= 0.0) {
+        CM_Debug("first frame drawn in " << (PIL_check_seconds_timer() - m_loadStartTime)
+                                         << "s from the game data load");
+        m_loadStartTime = -1.0;
+      }
+
+      // Quit the automated recordings after the requested number of frames.
+      if (m_captureFramesLeft > 0 && --m_captureFramesLeft == 0) {
+        m_exitRequested = KX_ExitRequest::QUIT_GAME;
+      }
     }
   }
 
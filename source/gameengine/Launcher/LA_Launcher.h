@@ -43,6 +43,7 @@ class KX_NetworkMessageManager;
 class RAS_ICanvas;
 class DEV_EventConsumer;
 class DEV_InputDevice;
+class SCA_InputRecorder;
 class GHOST_ISystem;
 struct Scene;
 struct Main;
@@ -70,6 +71,14 @@ class LA_Launcher {
   /// The game engine's input device abstraction.
   DEV_InputDevice *m_inputDevice;
   DEV_EventConsumer *m_eventConsumer;
+  /// Optional recorder or replayer of the inputs.
+  SCA_InputRecorder *m_inputRecorder;
+  /// Real time at the start of the record or replay.
+  double m_inputRecorderStartTime;
+  /// Number of frames to capture before quitting the game, -1 for no limit.
+  int m_captureFramesLeft;
+  /// Real time at the start of the game data load, negative to not print the first frame time.
+  double m_loadStartTime;
   /// The game engine's canvas abstraction.
   RAS_ICanvas *m_canvas;
   /// The rasterizer.
@@ -115,6 +124,13 @@ class LA_Launcher {
   /// Execute engine render, overrided to render background.
   virtual void RenderEngine();
 
+  /// Create the input recorder from the record_input or replay_input command line options.
+  void InitInputRecorder();
+  void ExitInputRecorder();
+
+  /// Start the capture of all the rendered frames from the capture command line option.
+  void InitCapture();
+
 #ifdef WITH_PYTHON
   /** Return true if the user use a valid python script for main loop and copy the python code
    * to pythonCode and file name to pythonFileName. Else return false.
@@ -148,6 +164,9 @@ class LA_Launcher {
   void SetPythonGlobalDict(PyObject *globalDict);
 #endif  // WITH_PYTHON
 
+  /// Print the time between the given load start time and the first frame drawn.
+  void SetLoadStartTime(double time);
+
   KX_ExitRequest GetExitRequested();
   const std::string &GetExitString();
   GlobalSettings *GetGlobalSettings();
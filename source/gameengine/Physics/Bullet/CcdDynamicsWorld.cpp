@@ -0,0 +1,585 @@
+/** \file gameengine/Physics/Bullet/CcdDynamicsWorld.cpp
+ *  \ingroup physbullet
+ */
+
+#include "CcdDynamicsWorld.h"
+
+#include <algorithm>
+
+#include "BulletCollision/CollisionDispatch/btConvexConvexAlgorithm.h"
+#include "BulletCollision/CollisionDispatch/btSimulationIslandManager.h"
+#include "BulletCollision/CollisionShapes/btCompoundShape.h"
+#include "BulletCollision/NarrowPhaseCollision/btVoronoiSimplexSolver.h"
+#include "BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h"
+#include "BulletDynamics/ConstraintSolver/btTypedConstraint.h"
+#include "LinearMath/btQuickprof.h"
+
+#include "BLI_task.h"
+#include "BLI_utildefines.h"
+
+/// Minimum number of overlapping pairs processed by a narrowphase task.
+#define CCD_PAIRS_PER_TASK 64
+
+/// Convex-convex algorithm using its own simplex solver instead of the shared one.
+ATTRIBUTE_ALIGNED16(class) CcdConvexConvexAlgorithm : public btConvexConvexAlgorithm
+{
+ private:
+  btVoronoiSimplexSolver m_ownSimplexSolver;
+
+ public:
+  CcdConvexConvexAlgorithm(btPersistentManifold *mf,
+                           const btCollisionAlgorithmConstructionInfo &ci,
+                           const btCollisionObjectWrapper *body0Wrap,
+                           const btCollisionObjectWrapper *body1Wrap,
+                           btConvexPenetrationDepthSolver *pdSolver,
+                           int numPerturbationIterations,
+                           int minimumPointsPerturbationThreshold)
+      : btConvexConvexAlgorithm(mf,
+                                ci,
+                                body0Wrap,
+                                body1Wrap,
+                                &m_ownSimplexSolver,
+                                pdSolver,
+                                numPerturbationIterations,
+                                minimumPointsPerturbationThreshold)
+  {
+  }
+};
+
+struct CcdConvexConvexCreateFunc : public btCollisionAlgorithmCreateFunc {
+  /// The create function of the configuration, holding the settings of the algorithms.
+  btConvexConvexAlgorithm::CreateFunc *m_sharedCreateFunc;
+
+  CcdConvexConvexCreateFunc(btConvexConvexAlgorithm::CreateFunc *sharedCreateFunc)
+      : m_sharedCreateFunc(sharedCreateFunc)
+  {
+  }
+
+  virtual btCollisionAlgorithm *CreateCollisionAlgorithm(btCollisionAlgorithmConstructionInfo &ci,
+                                                         const btCollisionObjectWrapper *body0Wrap,
+                                                         const btCollisionObjectWrapper *body1Wrap)
+  {
+    void *mem = ci.m_dispatcher1->allocateCollisionAlgorithm(sizeof(CcdConvexConvexAlgorithm));
+    return new (mem) CcdConvexConvexAlgorithm(ci.m_manifold,
+                                              ci,
+                                              body0Wrap,
+                                              body1Wrap,
+                                              m_sharedCreateFunc->m_pdSolver,
+                                              m_sharedCreateFunc->m_numPerturbationIterations,
+                                              m_sharedCreateFunc->m_minimumPointsPerturbationThreshold);
+  }
+};
+
+static btDefaultCollisionConstructionInfo collision_construction_info()
+{
+  btDefaultCollisionConstructionInfo info;
+  // The algorithm pool elements must fit the private simplex solver.
+  info.m_customCollisionAlgorithmMaxElementSize = sizeof(CcdConvexConvexAlgorithm);
+  return info;
+}
+
+CcdCollisionConfiguration::CcdCollisionConfiguration()
+    : btSoftBodyRigidBodyCollisionConfiguration(collision_construction_info())
+{
+  m_convexConvexCreateFuncThreadSafe = new CcdConvexConvexCreateFunc(
+      (btConvexConvexAlgorithm::CreateFunc *)m_convexConvexCreateFunc);
+}
+
+CcdCollisionConfiguration::~CcdCollisionConfiguration()
+{
+  delete m_convexConvexCreateFuncThreadSafe;
+}
+
+btCollisionAlgorithmCreateFunc *CcdCollisionConfiguration::getCollisionAlgorithmCreateFunc(
+    int proxyType0, int proxyType1)
+{
+  btCollisionAlgorithmCreateFunc *createFunc =
+      btSoftBodyRigidBodyCollisionConfiguration::getCollisionAlgorithmCreateFunc(proxyType0,
+                                                                                proxyType1);
+  if (createFunc == m_convexConvexCreateFunc) {
+    return m_convexConvexCreateFuncThreadSafe;
+  }
+  return createFunc;
+}
+
+/// GImpact shapes lock their meshes and update their trees during the collision detection.
+static bool shape_is_thread_safe(const btCollisionShape *shape)
+{
+  if (shape->getShapeType() == GIMPACT_SHAPE_PROXYTYPE) {
+    return false;
+  }
+  if (shape->isCompound()) {
+    const btCompoundShape *compound = static_cast<const btCompoundShape *>(shape);
+    for (int i = 0, size = compound->getNumChildShapes(); i < size; ++i) {
+      if (!shape_is_thread_safe(compound->getChildShape(i))) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/// Soft bodies collisions append to the soft bodies contacts.
+static bool object_is_thread_safe(const btCollisionObject *object)
+{
+  return (object->getInternalType() != btCollisionObject::CO_SOFT_BODY &&
+          shape_is_thread_safe(object->getCollisionShape()));
+}
+
+static bool pair_is_thread_safe(const btBroadphasePair &pair)
+{
+  return (object_is_thread_safe((btCollisionObject *)pair.m_pProxy0->m_clientObject) &&
+          object_is_thread_safe((btCollisionObject *)pair.m_pProxy1->m_clientObject));
+}
+
+/// The broadphase unique ids follow the creation order of the objects, unlike their addresses.
+static int object_unique_id(const btCollisionObject *object)
+{
+  const btBroadphaseProxy *proxy = object->getBroadphaseHandle();
+  return proxy ? proxy->m_uniqueId : -1;
+}
+
+/** Order the manifolds by objects and then by contacts to separate the manifolds of the compound
+ * children. Manifolds comparing equal have the same content and can be solved in any order.
+ */
+static bool manifold_less(const btPersistentManifold *a, const btPersistentManifold *b)
+{
+  const int a0 = object_unique_id(a->getBody0());
+  const int b0 = object_unique_id(b->getBody0());
+  if (a0 != b0) {
+    return a0 < b0;
+  }
+
+  const int a1 = object_unique_id(a->getBody1());
+  const int b1 = object_unique_id(b->getBody1());
+  if (a1 != b1) {
+    return a1 < b1;
+  }
+
+  if (a->getNumContacts() != b->getNumContacts()) {
+    return a->getNumContacts() < b->getNumContacts();
+  }
+
+  for (int i = 0, size = a->getNumContacts(); i < size; ++i) {
+    const btManifoldPoint &pa = a->getContactPoint(i);
+    const btManifoldPoint &pb = b->getContactPoint(i);
+    if (pa.m_index0 != pb.m_index0) {
+      return pa.m_index0 < pb.m_index0;
+    }
+    if (pa.m_index1 != pb.m_index1) {
+      return pa.m_index1 < pb.m_index1;
+    }
+    if (pa.m_partId0 != pb.m_partId0) {
+      return pa.m_partId0 < pb.m_partId0;
+    }
+    if (pa.m_partId1 != pb.m_partId1) {
+      return pa.m_partId1 < pb.m_partId1;
+    }
+    for (int j = 0; j < 3; ++j) {
+      if (pa.m_localPointA[j] != pb.m_localPointA[j]) {
+        return pa.m_localPointA[j] < pb.m_localPointA[j];
+      }
+    }
+  }
+
+  return false;
+}
+
+CcdCollisionDispatcher::CcdCollisionDispatcher(btCollisionConfiguration *collisionConfiguration)
+    : btCollisionDispatcher(collisionConfiguration),
+      m_taskScheduler(nullptr),
+      m_deterministic(false),
+      m_concurrent(false)
+{
+}
+
+CcdCollisionDispatcher::~CcdCollisionDispatcher()
+{
+}
+
+void CcdCollisionDispatcher::SetTaskScheduler(TaskScheduler *scheduler, bool deterministic)
+{
+  m_taskScheduler = scheduler;
+  m_deterministic = deterministic;
+}
+
+btPersistentManifold *CcdCollisionDispatcher::getNewManifold(const btCollisionObject *b0,
+                                                             const btCollisionObject *b1)
+{
+  if (!m_concurrent) {
+    return btCollisionDispatcher::getNewManifold(b0, b1);
+  }
+
+  m_poolLock.Lock();
+  btPersistentManifold *manifold = btCollisionDispatcher::getNewManifold(b0, b1);
+  m_poolLock.Unlock();
+
+  return manifold;
+}
+
+void CcdCollisionDispatcher::releaseManifold(btPersistentManifold *manifold)
+{
+  if (!m_concurrent) {
+    btCollisionDispatcher::releaseManifold(manifold);
+    return;
+  }
+
+  m_poolLock.Lock();
+  btCollisionDispatcher::releaseManifold(manifold);
+  m_poolLock.Unlock();
+}
+
+void *CcdCollisionDispatcher::allocateCollisionAlgorithm(int size)
+{
+  if (!m_concurrent) {
+    return btCollisionDispatcher::allocateCollisionAlgorithm(size);
+  }
+
+  m_poolLock.Lock();
+  void *mem = btCollisionDispatcher::allocateCollisionAlgorithm(size);
+  m_poolLock.Unlock();
+
+  return mem;
+}
+
+void CcdCollisionDispatcher::freeCollisionAlgorithm(void *ptr)
+{
+  if (!m_concurrent) {
+    btCollisionDispatcher::freeCollisionAlgorithm(ptr);
+    return;
+  }
+
+  m_poolLock.Lock();
+  btCollisionDispatcher::freeCollisionAlgorithm(ptr);
+  m_poolLock.Unlock();
+}
+
+void CcdCollisionDispatcher::PairTaskFunc(TaskPool *__restrict UNUSED(pool),
+                                          void *taskdata,
+                                          int UNUSED(threadid))
+{
+  PairTask *task = (PairTask *)taskdata;
+  CcdCollisionDispatcher *dispatcher = task->m_dispatcher;
+  btNearCallback nearCallback = dispatcher->getNearCallback();
+
+  for (int i = task->m_start; i < task->m_end; ++i) {
+    btBroadphasePair &pair = task->m_pairs[i];
+    if (pair_is_thread_safe(pair)) {
+      nearCallback(pair, *dispatcher, *task->m_dispatchInfo);
+    }
+    else {
+      task->m_serialPairs.push_back(&pair);
+    }
+  }
+}
+
+void CcdCollisionDispatcher::SortManifolds()
+{
+  const int size = m_manifoldsPtr.size();
+  if (size == 0) {
+    return;
+  }
+
+  btPersistentManifold **manifolds = &m_manifoldsPtr[0];
+  std::sort(manifolds, manifolds + size, manifold_less);
+
+  // The index is used to remove the manifold from the array.
+  for (int i = 0; i < size; ++i) {
+    manifolds[i]->m_index1a = i;
+  }
+}
+
+void CcdCollisionDispatcher::dispatchAllCollisionPairs(btOverlappingPairCache *pairCache,
+                                                       const btDispatcherInfo &dispatchInfo,
+                                                       btDispatcher *dispatcher)
+{
+  const int numPairs = pairCache->getNumOverlappingPairs();
+
+  /* The continuous collision detection writes the hit fraction into the objects, shared
+   * between the pairs. */
+  if (!m_taskScheduler || pairCache->hasDeferredRemoval() ||
+      dispatchInfo.m_dispatchFunc != btDispatcherInfo::DISPATCH_DISCRETE ||
+      numPairs < CCD_PAIRS_PER_TASK * 2) {
+    btCollisionDispatcher::dispatchAllCollisionPairs(pairCache, dispatchInfo, dispatcher);
+  }
+  else {
+    const int numThreads = BLI_task_scheduler_num_threads(m_taskScheduler);
+    const int pairsPerTask = std::max(CCD_PAIRS_PER_TASK, numPairs / (numThreads * 4));
+    const int numTasks = (numPairs + pairsPerTask - 1) / pairsPerTask;
+    btBroadphasePair *pairs = pairCache->getOverlappingPairArrayPtr();
+
+    m_tasks.resize(numTasks);
+    m_concurrent = true;
+
+    TaskPool *pool = BLI_task_pool_create(m_taskScheduler, nullptr);
+    for (int i = 0; i < numTasks; ++i) {
+      PairTask &task = m_tasks[i];
+      task.m_dispatcher = this;
+      task.m_dispatchInfo = &dispatchInfo;
+      task.m_pairs = pairs;
+      task.m_start = i * pairsPerTask;
+      task.m_end = std::min(numPairs, task.m_start + pairsPerTask);
+      task.m_serialPairs.clear();
+
+      BLI_task_pool_push(pool, PairTaskFunc, &task, false, TASK_PRIORITY_HIGH);
+    }
+    BLI_task_pool_work_and_wait(pool);
+    BLI_task_pool_free(pool);
+
+    m_concurrent = false;
+
+    btNearCallback nearCallback = getNearCallback();
+    for (const PairTask &task : m_tasks) {
+      for (btBroadphasePair *pair : task.m_serialPairs) {
+        nearCallback(*pair, *this, dispatchInfo);
+      }
+    }
+  }
+
+  /* The manifolds are appended by the threads in any order, it changes the order of the
+   * contacts given to the solver and of the collision callbacks. */
+  if (m_deterministic) {
+    SortManifolds();
+  }
+}
+
+static int constraint_island_id(const btTypedConstraint *constraint)
+{
+  const btCollisionObject &object0 = constraint->getRigidBodyA();
+  const btCollisionObject &object1 = constraint->getRigidBodyB();
+  return (object0.getIslandTag() >= 0) ? object0.getIslandTag() : object1.getIslandTag();
+}
+
+struct ConstraintIslandLess {
+  bool operator()(const btTypedConstraint *lhs, const btTypedConstraint *rhs) const
+  {
+    return constraint_island_id(lhs) < constraint_island_id(rhs);
+  }
+};
+
+/// Copy the islands given by the island manager to solve them later.
+class CcdDynamicsWorld::IslandCollector : public btSimulationIslandManager::IslandCallback {
+ private:
+  CcdDynamicsWorld *m_world;
+  int m_constraintIndex;
+
+ public:
+  IslandCollector(CcdDynamicsWorld *world) : m_world(world), m_constraintIndex(0)
+  {
+  }
+
+  virtual void processIsland(btCollisionObject **bodies,
+                             int numBodies,
+                             btPersistentManifold **manifolds,
+                             int numManifolds,
+                             int islandId)
+  {
+    Island island;
+    island.m_bodyStart = m_world->m_islandBodies.size();
+    island.m_numBodies = numBodies;
+    island.m_manifoldStart = m_world->m_islandManifolds.size();
+    island.m_numManifolds = numManifolds;
+    island.m_kinematic = false;
+
+    m_world->m_islandBodies.insert(m_world->m_islandBodies.end(), bodies, bodies + numBodies);
+    for (int i = 0; i < numManifolds; ++i) {
+      btPersistentManifold *manifold = manifolds[i];
+      m_world->m_islandManifolds.push_back(manifold);
+      if (manifold->getBody0()->isKinematicObject() || manifold->getBody1()->isKinematicObject()) {
+        island.m_kinematic = true;
+      }
+    }
+
+    // The islands are processed by increasing identifier, like the sorted constraints.
+    const btAlignedObjectArray<btTypedConstraint *> &constraints = m_world->m_sortedConstraints;
+    const int numConstraints = constraints.size();
+    while (m_constraintIndex < numConstraints &&
+           constraint_island_id(constraints[m_constraintIndex]) < islandId) {
+      ++m_constraintIndex;
+    }
+
+    island.m_constraintStart = m_constraintIndex;
+    while (m_constraintIndex < numConstraints &&
+           constraint_island_id(constraints[m_constraintIndex]) == islandId) {
+      const btTypedConstraint *constraint = constraints[m_constraintIndex];
+      if (constraint->getRigidBodyA().isKinematicObject() ||
+          constraint->getRigidBodyB().isKinematicObject()) {
+        island.m_kinematic = true;
+      }
+      ++m_constraintIndex;
+    }
+    island.m_numConstraints = m_constraintIndex - island.m_constraintStart;
+
+    m_world->m_islands.push_back(island);
+  }
+};
+
+CcdDynamicsWorld::CcdDynamicsWorld(btDispatcher *dispatcher,
+                                   btBroadphaseInterface *pairCache,
+                                   btConstraintSolver *constraintSolver,
+                                   btCollisionConfiguration *collisionConfiguration)
+    : btSoftRigidDynamicsWorld(dispatcher, pairCache, constraintSolver, collisionConfiguration),
+      m_taskScheduler(nullptr),
+      m_deterministic(false)
+{
+}
+
+CcdDynamicsWorld::~CcdDynamicsWorld()
+{
+  SetTaskScheduler(nullptr, false);
+}
+
+void CcdDynamicsWorld::SetTaskScheduler(TaskScheduler *scheduler, bool deterministic)
+{
+  m_taskScheduler = scheduler;
+  m_deterministic = deterministic;
+
+  for (ThreadData &data : m_threadData) {
+    delete data.m_solver;
+  }
+  m_threadData.clear();
+
+  if (scheduler) {
+    m_threadData.resize(BLI_task_scheduler_num_threads(scheduler));
+    for (ThreadData &data : m_threadData) {
+      data.m_solver = new btSequentialImpulseConstraintSolver();
+    }
+  }
+}
+
+void CcdDynamicsWorld::SolveBatch(const Batch &batch,
+                                  btContactSolverInfo &solverInfo,
+                                  int threadid)
+{
+  ThreadData &data = m_threadData[threadid];
+  data.m_bodies.resize(0);
+  data.m_manifolds.resize(0);
+  data.m_constraints.resize(0);
+
+  for (int i = batch.m_islandStart, end = i + batch.m_numIslands; i < end; ++i) {
+    const Island &island = m_islands[m_islandOrder[i]];
+    for (int j = 0; j < island.m_numBodies; ++j) {
+      data.m_bodies.push_back(m_islandBodies[island.m_bodyStart + j]);
+    }
+    for (int j = 0; j < island.m_numManifolds; ++j) {
+      data.m_manifolds.push_back(m_islandManifolds[island.m_manifoldStart + j]);
+    }
+    for (int j = 0; j < island.m_numConstraints; ++j) {
+      data.m_constraints.push_back(m_sortedConstraints[island.m_constraintStart + j]);
+    }
+  }
+
+  if (m_deterministic) {
+    data.m_solver->setRandSeed(0);
+  }
+
+  data.m_solver->solveGroup(data.m_bodies.size() ? &data.m_bodies[0] : nullptr,
+                            data.m_bodies.size(),
+                            data.m_manifolds.size() ? &data.m_manifolds[0] : nullptr,
+                            data.m_manifolds.size(),
+                            data.m_constraints.size() ? &data.m_constraints[0] : nullptr,
+                            data.m_constraints.size(),
+                            solverInfo,
+                            m_debugDrawer,
+                            m_dispatcher1);
+}
+
+void CcdDynamicsWorld::BatchTaskFunc(TaskPool *__restrict UNUSED(pool),
+                                     void *taskdata,
+                                     int threadid)
+{
+  BatchTask *task = (BatchTask *)taskdata;
+  CcdDynamicsWorld *world = task->m_world;
+
+  for (int i = task->m_batchStart; i < task->m_batchEnd; ++i) {
+    world->SolveBatch(world->m_batches[i], *task->m_solverInfo, threadid);
+  }
+}
+
+void CcdDynamicsWorld::solveConstraints(btContactSolverInfo &solverInfo)
+{
+  if (!m_taskScheduler || !m_islandManager->getSplitIslands()) {
+    btSoftRigidDynamicsWorld::solveConstraints(solverInfo);
+    return;
+  }
+
+  BT_PROFILE("solveConstraints");
+
+  const int numConstraints = m_constraints.size();
+  m_sortedConstraints.resize(numConstraints);
+  for (int i = 0; i < numConstraints; ++i) {
+    m_sortedConstraints[i] = m_constraints[i];
+  }
+  m_sortedConstraints.quickSort(ConstraintIslandLess());
+
+  m_islands.clear();
+  m_islandBodies.clear();
+  m_islandManifolds.clear();
+
+  IslandCollector collector(this);
+  m_islandManager->buildAndProcessIslands(m_dispatcher1, this, &collector);
+
+  const int numIslands = m_islands.size();
+  m_islandOrder.clear();
+  for (int i = 0; i < numIslands; ++i) {
+    if (!m_islands[i].m_kinematic) {
+      m_islandOrder.push_back(i);
+    }
+  }
+  const int numParallelIslands = m_islandOrder.size();
+  for (int i = 0; i < numIslands; ++i) {
+    if (m_islands[i].m_kinematic) {
+      m_islandOrder.push_back(i);
+    }
+  }
+
+  /* Merge the small islands until the batch reaches the minimum batch size like
+   * InplaceSolverIslandCallback, the islands touching kinematic objects are merged apart. */
+  m_batches.clear();
+  int numParallelBatches = 0;
+  bool batchFull = true;
+  for (int i = 0; i < numIslands; ++i) {
+    if (batchFull || i == numParallelIslands) {
+      if (i == numParallelIslands) {
+        numParallelBatches = m_batches.size();
+      }
+      m_batches.push_back({i, 0, 0});
+    }
+
+    const Island &island = m_islands[m_islandOrder[i]];
+    Batch &batch = m_batches.back();
+    ++batch.m_numIslands;
+    batch.m_numRows += island.m_numManifolds + island.m_numConstraints;
+    batchFull = (solverInfo.m_minimumSolverBatchSize <= 1 ||
+                 batch.m_numRows > solverInfo.m_minimumSolverBatchSize);
+  }
+  const int numBatches = m_batches.size();
+  if (numParallelIslands == numIslands) {
+    numParallelBatches = numBatches;
+  }
+
+  // One task per batch and a single task for the batches writing into kinematic objects.
+  m_batchTasks.clear();
+  for (int i = 0; i < numParallelBatches; ++i) {
+    m_batchTasks.push_back({this, &solverInfo, i, i + 1});
+  }
+  if (numParallelBatches < numBatches) {
+    m_batchTasks.push_back({this, &solverInfo, numParallelBatches, numBatches});
+  }
+
+  m_constraintSolver->prepareSolve(getNumCollisionObjects(), m_dispatcher1->getNumManifolds());
+
+  if (m_batchTasks.size() == 1) {
+    BatchTaskFunc(nullptr, &m_batchTasks[0], 0);
+  }
+  else if (m_batchTasks.size() > 1) {
+    TaskPool *pool = BLI_task_pool_create(m_taskScheduler, nullptr);
+    for (BatchTask &task : m_batchTasks) {
+      BLI_task_pool_push(pool, BatchTaskFunc, &task, false, TASK_PRIORITY_HIGH);
+    }
+    BLI_task_pool_work_and_wait(pool);
+    BLI_task_pool_free(pool);
+  }
+
+  m_constraintSolver->allSolved(solverInfo, m_debugDrawer);
+}
@@ -0,0 +1,154 @@
+/** \file CcdDynamicsWorld.h
+ *  \ingroup physbullet
+ */
+
+#ifndef __CCD_DYNAMICS_WORLD_H__
+#define __CCD_DYNAMICS_WORLD_H__
+
+#include "BulletCollision/CollisionDispatch/btCollisionDispatcher.h"
+#include "BulletSoftBody/btSoftBodyRigidBodyCollisionConfiguration.h"
+#include "BulletSoftBody/btSoftRigidDynamicsWorld.h"
+
+#include "CM_Thread.h"
+
+#include <vector>
+
+struct TaskPool;
+struct TaskScheduler;
+class btSequentialImpulseConstraintSolver;
+
+/** Collision configuration giving every convex-convex algorithm its own simplex solver.
+ * Bullet shares a single simplex solver between all the algorithms otherwise, which
+ * prevents processing collision pairs concurrently.
+ */
+class CcdCollisionConfiguration : public btSoftBodyRigidBodyCollisionConfiguration {
+ private:
+  btCollisionAlgorithmCreateFunc *m_convexConvexCreateFuncThreadSafe;
+
+ public:
+  CcdCollisionConfiguration();
+  virtual ~CcdCollisionConfiguration();
+
+  virtual btCollisionAlgorithmCreateFunc *getCollisionAlgorithmCreateFunc(int proxyType0,
+                                                                         int proxyType1);
+};
+
+/** Collision dispatcher processing the narrowphase of the overlapping pairs with the task
+ * scheduler. Pairs involving soft bodies or GImpact shapes which modify shared data are
+ * processed afterward on the calling thread.
+ */
+class CcdCollisionDispatcher : public btCollisionDispatcher {
+ private:
+  struct PairTask {
+    CcdCollisionDispatcher *m_dispatcher;
+    const btDispatcherInfo *m_dispatchInfo;
+    btBroadphasePair *m_pairs;
+    int m_start;
+    int m_end;
+    /// Pairs of the range which must be processed on the calling thread, in order.
+    std::vector<btBroadphasePair *> m_serialPairs;
+  };
+
+  TaskScheduler *m_taskScheduler;
+  /// Sort the manifolds after the narrowphase to not depend on the order of the threads.
+  bool m_deterministic;
+  /// The narrowphase is running on multiple threads, the pools must be locked.
+  bool m_concurrent;
+  CM_ThreadSpinLock m_poolLock;
+
+  std::vector<PairTask> m_tasks;
+
+  static void PairTaskFunc(TaskPool *__restrict pool, void *taskdata, int threadid);
+
+  void SortManifolds();
+
+ public:
+  CcdCollisionDispatcher(btCollisionConfiguration *collisionConfiguration);
+  virtual ~CcdCollisionDispatcher();
+
+  /// Use the task scheduler for the narrowphase, sequential if nullptr.
+  void SetTaskScheduler(TaskScheduler *scheduler, bool deterministic);
+
+  virtual btPersistentManifold *getNewManifold(const btCollisionObject *b0,
+                                               const btCollisionObject *b1);
+  virtual void releaseManifold(btPersistentManifold *manifold);
+  virtual void *allocateCollisionAlgorithm(int size);
+  virtual void freeCollisionAlgorithm(void *ptr);
+
+  virtual void dispatchAllCollisionPairs(btOverlappingPairCache *pairCache,
+                                         const btDispatcherInfo &dispatchInfo,
+                                         btDispatcher *dispatcher);
+};
+
+/** Dynamics world solving the simulation islands with the task scheduler, each thread uses
+ * its own constraint solver. Small islands are batched like Bullet does, islands touching
+ * kinematic objects are solved by a single task as the solver writes into these objects.
+ */
+class CcdDynamicsWorld : public btSoftRigidDynamicsWorld {
+ private:
+  struct Island {
+    int m_bodyStart;
+    int m_numBodies;
+    int m_manifoldStart;
+    int m_numManifolds;
+    int m_constraintStart;
+    int m_numConstraints;
+    bool m_kinematic;
+  };
+
+  /// Consecutive islands of m_islandOrder solved in a single group.
+  struct Batch {
+    int m_islandStart;
+    int m_numIslands;
+    int m_numRows;
+  };
+
+  struct ThreadData {
+    btSequentialImpulseConstraintSolver *m_solver;
+    btAlignedObjectArray<btCollisionObject *> m_bodies;
+    btAlignedObjectArray<btPersistentManifold *> m_manifolds;
+    btAlignedObjectArray<btTypedConstraint *> m_constraints;
+  };
+
+  /// Consecutive batches solved one after the other by a task.
+  struct BatchTask {
+    CcdDynamicsWorld *m_world;
+    btContactSolverInfo *m_solverInfo;
+    int m_batchStart;
+    int m_batchEnd;
+  };
+
+  class IslandCollector;
+
+  TaskScheduler *m_taskScheduler;
+  /// Reset the solvers state before each batch.
+  bool m_deterministic;
+
+  std::vector<ThreadData> m_threadData;
+  std::vector<Island> m_islands;
+  /// Indices of the islands, the ones touching kinematic objects last.
+  std::vector<int> m_islandOrder;
+  std::vector<Batch> m_batches;
+  std::vector<BatchTask> m_batchTasks;
+  std::vector<btCollisionObject *> m_islandBodies;
+  std::vector<btPersistentManifold *> m_islandManifolds;
+
+  static void BatchTaskFunc(TaskPool *__restrict pool, void *taskdata, int threadid);
+
+  void SolveBatch(const Batch &batch, btContactSolverInfo &solverInfo, int threadid);
+
+ protected:
+  virtual void solveConstraints(btContactSolverInfo &solverInfo);
+
+ public:
+  CcdDynamicsWorld(btDispatcher *dispatcher,
+                   btBroadphaseInterface *pairCache,
+                   btConstraintSolver *constraintSolver,
+                   btCollisionConfiguration *collisionConfiguration);
+  virtual ~CcdDynamicsWorld();
+
+  /// Solve the islands with the task scheduler, sequential if nullptr.
+  void SetTaskScheduler(TaskScheduler *scheduler, bool deterministic);
+};
+
+#endif  // __CCD_DYNAMICS_WORLD_H__
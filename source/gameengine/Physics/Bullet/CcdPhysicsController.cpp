@@ -1846,6 +1846,20 @@ CcdShapeConstructionInfo *CcdShapeConstructionInfo::FindMesh(RAS_MeshObject *mes
   return nullptr;
 }
 
+size_t CcdShapeConstructionInfo::GetMemorySize() const
+{
+  size_t size = m_vertexArray.size() * sizeof(btScalar) +
+                m_polygonIndexArray.size() * sizeof(int) + m_triFaceArray.size() * sizeof(int) +
+                m_triFaceUVcoArray.size() * sizeof(UVco);
+
+  if (m_shapeType == PHY_SHAPE_MESH) {
+    // The quantized BVH of a triangle mesh uses up to two nodes per triangle.
+    size += m_polygonIndexArray.size() * 2 * sizeof(btQuantizedBvhNode);
+  }
+
+  return size;
+}
+
 CcdShapeConstructionInfo *CcdShapeConstructionInfo::GetReplica()
 {
   CcdShapeConstructionInfo *replica = new CcdShapeConstructionInfo(*this);
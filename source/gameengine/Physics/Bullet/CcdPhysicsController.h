@@ -165,6 +165,9 @@ class CcdShapeConstructionInfo : public CM_RefCount<CcdShapeConstructionInfo> {
                                       bool useGimpact = false,
                                       bool useBvh = true);
 
+  /// Return the memory used by the shape arrays and the estimated size of the mesh BVH.
+  size_t GetMemorySize() const;
+
   // member variables
   PHY_ShapeType m_shapeType;
   btScalar m_radius;
@@ -23,6 +23,7 @@
 #include "CcdPhysicsController.h"
 #include "CcdGraphicController.h"
 #include "CcdConstraint.h"
+#include "CcdDynamicsWorld.h"
 #include "CcdMathUtils.h"
 
 #include <algorithm>
@@ -54,6 +55,7 @@
 #include "DNA_object_force_types.h"
 
 extern "C" {
+#include "BLI_compiler_attrs.h"
 #include "BLI_utildefines.h"
 #include "BKE_object.h"
 }
@@ -401,6 +403,7 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(bool useDbvtCulling,
       m_linearDeactivationThreshold(0.8f),
       m_angularDeactivationThreshold(1.0f),
       m_contactBreakingThreshold(0.02f),
+      m_dynamicsWorld(nullptr),
       m_solver(nullptr),
       m_ownPairCache(nullptr),
       m_filterCallback(nullptr),
@@ -412,14 +415,13 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(bool useDbvtCulling,
   }
 
   //	m_collisionConfiguration = new btDefaultCollisionConfiguration();
-  m_collisionConfiguration = new btSoftBodyRigidBodyCollisionConfiguration();
+  m_collisionConfiguration = new CcdCollisionConfiguration();
   // m_collisionConfiguration->setConvexConvexMultipointIterations();
 
   if (!dispatcher) {
-    btCollisionDispatcher *disp = new btCollisionDispatcher(m_collisionConfiguration);
-    dispatcher = disp;
-    btGImpactCollisionAlgorithm::registerAlgorithm(disp);
-    m_ownDispatcher = dispatcher;
+    m_ownDispatcher = new CcdCollisionDispatcher(m_collisionConfiguration);
+    btGImpactCollisionAlgorithm::registerAlgorithm(m_ownDispatcher);
+    dispatcher = m_ownDispatcher;
   }
 
   // m_broadphase = new btAxisSweep3(btVector3(-1000,-1000,-1000),btVector3(1000,1000,1000));
@@ -436,10 +438,10 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(bool useDbvtCulling,
   m_broadphase->getOverlappingPairCache()->setOverlapFilterCallback(m_filterCallback);
   m_broadphase->getOverlappingPairCache()->setInternalGhostPairCallback(m_ghostPairCallback);
 
-  SetSolverType(1);  // issues with quickstep and memory allocations
+  SetSolverType(PHY_SOLVER_SEQUENTIAL);  // issues with quickstep and memory allocations
   //	m_dynamicsWorld = new
   // btDiscreteDynamicsWorld(dispatcher,m_broadphase,m_solver,m_collisionConfiguration);
-  m_dynamicsWorld = new btSoftRigidDynamicsWorld(
+  m_dynamicsWorld = new CcdDynamicsWorld(
       dispatcher, m_broadphase, m_solver, m_collisionConfiguration);
   m_dynamicsWorld->setInternalTickCallback(&CcdPhysicsEnvironment::StaticSimulationSubtickCallback,
                                            this);
@@ -1030,12 +1032,23 @@ void CcdPhysicsEnvironment::SetUseEpa(bool epa)
 
 void CcdPhysicsEnvironment::SetSolverType(int solverType)
 {
+  TaskScheduler *scheduler = nullptr;
+
   switch (solverType) {
-    case 1: {
-      if (m_solverType != solverType) {
+    case PHY_SOLVER_PARALLEL_ISLANDS:
+    case PHY_SOLVER_PARALLEL_ISLANDS_DETERMINISTIC: {
+      KX_KetsjiEngine *engine = KX_GetActiveEngine();
+      if (engine) {
+        scheduler = engine->GetTaskScheduler();
+      }
+      ATTR_FALLTHROUGH;
+    }
+    case PHY_SOLVER_SEQUENTIAL: {
+      // The sequential solver is also used when the islands can't be split.
+      if (!m_solver) {
         m_solver = new btSequentialImpulseConstraintSolver();
-        break;
       }
+      break;
     }
 
     case 0:
@@ -1046,6 +1059,15 @@ void CcdPhysicsEnvironment::SetSolverType(int solverType)
       }
   };
   m_solverType = solverType;
+
+  // The world isn't created yet when called from the constructor.
+  if (m_dynamicsWorld) {
+    const bool deterministic = (solverType == PHY_SOLVER_PARALLEL_ISLANDS_DETERMINISTIC);
+    static_cast<CcdDynamicsWorld *>(m_dynamicsWorld)->SetTaskScheduler(scheduler, deterministic);
+    if (m_ownDispatcher) {
+      m_ownDispatcher->SetTaskScheduler(scheduler, deterministic);
+    }
+  }
 }
 
 void CcdPhysicsEnvironment::GetGravity(MT_Vector3 &grav)
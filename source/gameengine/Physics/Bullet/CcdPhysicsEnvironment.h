@@ -330,7 +330,7 @@ class CcdPhysicsEnvironment : public PHY_IPhysicsEnvironment {
 
   class btGhostPairCallback *m_ghostPairCallback;
 
-  class btDispatcher *m_ownDispatcher;
+  class CcdCollisionDispatcher *m_ownDispatcher;
 
   virtual void ExportFile(const std::string &filename);
 };
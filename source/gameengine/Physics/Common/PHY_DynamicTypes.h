@@ -90,6 +90,14 @@ typedef enum PHY_ConstraintType {
 
 } PHY_ConstraintType;
 
+/// PHY_SolverType enumerates the constraint solving modes, see SetSolverType
+typedef enum PHY_SolverType {
+  PHY_SOLVER_SEQUENTIAL = 1,
+  PHY_SOLVER_PARALLEL_ISLANDS = 2,  // islands and collision pairs processed by the task scheduler
+  PHY_SOLVER_PARALLEL_ISLANDS_DETERMINISTIC = 3,  // same with a fixed contact ordering
+
+} PHY_SolverType;
+
 typedef enum PHY_ShapeType {
   PHY_SHAPE_NONE,
   PHY_SHAPE_BOX,
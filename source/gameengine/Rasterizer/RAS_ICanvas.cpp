@@ -30,6 +30,7 @@
 #include "BKE_image.h"
 #include "BKE_global.h"
 #include "BKE_main.h"
+#include "BKE_writeavi.h"
 
 #include "BLI_task.h"
 #include "BLI_path_util.h"
@@ -43,9 +44,39 @@ extern "C" {
 }
 
 #include "CM_Message.h"
+#include "CM_Thread.h"
 
 #include <stdlib.h>  // for free()
 
+/// Number of frames after which a pending readback is waited, bounding the screenshot latency.
+#define SCREENSHOT_MAX_LATENCY 2
+/// Maximum number of captured frames waiting for the encoder, the next frames are dropped.
+#define CAPTURE_MAX_QUEUED_FRAMES 8
+/// Frame number digits appended to the capture paths without '#', as for the render output.
+#define CAPTURE_FRAME_DIGITS 4
+
+// Capture of all the frames, movie frames are appended in a different thread.
+struct CaptureData {
+  std::string path;
+  ImageFormatData format;
+  /// Movie encoder, nullptr for image sequences.
+  bMovieHandle *handle;
+  void *context;
+  RenderData rd;
+  int width;
+  int height;
+  /// Next frame number appended to the movie, protected by the encode mutex.
+  int frame;
+  /// Movie frames waiting for the encoder, protected by the mutex.
+  std::deque<unsigned int *> frames;
+  /// Frames waiting for the encoder or the image save, protected by the mutex.
+  unsigned int numQueued;
+  /// Short lock of the queue, taken by the render thread.
+  CM_ThreadMutex mutex;
+  /// Held during the encoding to append the movie frames in order.
+  CM_ThreadMutex encodeMutex;
+};
+
 // Task data for saving screenshots in a different thread.
 struct ScreenshotTaskData {
   unsigned int *dumprect;
@@ -53,6 +84,8 @@ struct ScreenshotTaskData {
   int dumpsy;
   char path[FILE_MAX];
   ImageFormatData *im_format;
+  /// Capture of the frame, nullptr for screenshots.
+  CaptureData *capture;
 };
 
 /**
@@ -64,7 +97,21 @@ struct ScreenshotTaskData {
  */
 void save_screenshot_thread_func(TaskPool *__restrict pool, void *taskdata, int threadid);
 
-RAS_ICanvas::RAS_ICanvas(RAS_Rasterizer *rasty) : m_rasterizer(rasty), m_samples(0)
+/**
+ * Append the oldest queued frame to the capture movie. Run in a separate thread by
+ * RAS_ICanvas::SaveScreeshot().
+ *
+ * @param taskdata Must point to the CaptureData, which is not owned by the task.
+ */
+void capture_frame_thread_func(TaskPool *__restrict pool, void *taskdata, int threadid);
+
+RAS_ICanvas::RAS_ICanvas(RAS_Rasterizer *rasty)
+    : m_rasterizer(rasty),
+      m_capture(nullptr),
+      m_numScreenshots(0),
+      m_numDroppedScreenshots(0),
+      m_samples(0),
+      m_frame(0)
 {
   m_taskscheduler = BLI_task_scheduler_create(1);
   m_taskpool = BLI_task_pool_create(m_taskscheduler, nullptr);
@@ -72,6 +119,17 @@ RAS_ICanvas::RAS_ICanvas(RAS_Rasterizer *rasty) : m_rasterizer(rasty), m_samples
 
 RAS_ICanvas::~RAS_ICanvas()
 {
+  /* The rasterizer could be already freed, the readbacks not saved by FinishScreenshots
+   * are lost. */
+  for (const PendingScreenshot &pending : m_pendingScreenshots) {
+    if (pending.screenshot.format) {
+      MEM_freeN(pending.screenshot.format);
+    }
+  }
+  m_pendingScreenshots.clear();
+
+  StopCapture();
+
   if (m_taskpool) {
     BLI_task_pool_work_and_wait(m_taskpool);
     BLI_task_pool_free(m_taskpool);
@@ -126,13 +184,168 @@ const RAS_Rect &RAS_ICanvas::GetViewportArea() const
 
 void RAS_ICanvas::FlushScreenshots()
 {
+  // Save the screenshots read during the previous frames.
+  ProcessPendingScreenshots(false);
+
+  if (IsCapturing()) {
+    // Movie frames are encoded from the pixels, image sequences use a copy of the format.
+    ImageFormatData *format = nullptr;
+    if (!m_capture->handle) {
+      format = (ImageFormatData *)MEM_mallocN(sizeof(ImageFormatData), "capture_format");
+      *format = m_capture->format;
+    }
+    AddScreenshot(m_capture->path,
+                  m_viewportArea.GetLeft(),
+                  m_viewportArea.GetBottom(),
+                  GetWidth(),
+                  GetHeight(),
+                  format);
+    m_screenshots.back().capture = true;
+  }
+
   for (const Screenshot &screenshot : m_screenshots) {
-    SaveScreeshot(screenshot);
+    ++m_numScreenshots;
+
+    const int readback = m_rasterizer->BeginScreenshot(
+        screenshot.x, screenshot.y, screenshot.width, screenshot.height);
+    if (readback != -1) {
+      m_pendingScreenshots.push_back({screenshot, readback, 0});
+    }
+    else if (screenshot.capture) {
+      // All the readbacks are pending, the capture can't follow the frame rate.
+      if (screenshot.format) {
+        MEM_freeN(screenshot.format);
+      }
+      ++m_numDroppedScreenshots;
+    }
+    else {
+      // A requested screenshot is never lost, read it now.
+      SaveScreeshot(screenshot,
+                    m_rasterizer->MakeScreenshot(
+                        screenshot.x, screenshot.y, screenshot.width, screenshot.height));
+    }
   }
 
   m_screenshots.clear();
 }
 
+void RAS_ICanvas::FinishScreenshots()
+{
+  ProcessPendingScreenshots(true);
+  StopCapture();
+}
+
+void RAS_ICanvas::ProcessPendingScreenshots(bool wait)
+{
+  for (PendingScreenshot &pending : m_pendingScreenshots) {
+    ++pending.age;
+  }
+
+  // Keep the request order, stop at the first readback not finished.
+  while (!m_pendingScreenshots.empty()) {
+    const PendingScreenshot &pending = m_pendingScreenshots.front();
+    if (!wait && pending.age < SCREENSHOT_MAX_LATENCY &&
+        !m_rasterizer->IsScreenshotReady(pending.readback)) {
+      break;
+    }
+
+    SaveScreeshot(pending.screenshot, m_rasterizer->EndScreenshot(pending.readback));
+    m_pendingScreenshots.pop_front();
+  }
+}
+
+bool RAS_ICanvas::StartCapture(const std::string &path, Scene *scene)
+{
+  FinishScreenshots();
+
+  CaptureData *capture = new CaptureData();
+  capture->path = path;
+  capture->format = scene->r.im_format;
+  capture->handle = nullptr;
+  capture->context = nullptr;
+  capture->width = GetWidth();
+  capture->height = GetHeight();
+  capture->numQueued = 0;
+
+  if (!BKE_imtype_is_movie(capture->format.imtype)) {
+    m_capture = capture;
+    CM_Message("capture: saving frames to " << path);
+    return true;
+  }
+
+  bMovieHandle *handle = BKE_movie_handle_get(capture->format.imtype);
+  if (!handle) {
+    CM_Error("capture: movie format not supported");
+    delete capture;
+    return false;
+  }
+
+  capture->context = handle->context_create ? handle->context_create() : nullptr;
+  capture->rd = scene->r;
+  BLI_strncpy(capture->rd.pic, path.c_str(), FILE_MAX);
+  // The frames are captured at the logic rate.
+  capture->rd.frs_sec = scene->gm.ticrate;
+  capture->rd.frs_sec_base = 1.0f;
+  capture->frame = capture->rd.sfra;
+
+  if (!handle->start_movie(capture->context,
+                           scene,
+                           &capture->rd,
+                           capture->width,
+                           capture->height,
+                           nullptr,
+                           false,
+                           "")) {
+    CM_Error("capture: cannot start movie " << path);
+    if (capture->context) {
+      handle->context_free(capture->context);
+    }
+    delete capture;
+    return false;
+  }
+
+  capture->handle = handle;
+  m_capture = capture;
+  CM_Message("capture: recording movie to " << path);
+
+  return true;
+}
+
+void RAS_ICanvas::StopCapture()
+{
+  if (!m_capture) {
+    return;
+  }
+
+  // Encode or save the queued frames.
+  BLI_task_pool_work_and_wait(m_taskpool);
+
+  if (m_capture->handle) {
+    m_capture->handle->end_movie(m_capture->context);
+    if (m_capture->context) {
+      m_capture->handle->context_free(m_capture->context);
+    }
+  }
+
+  delete m_capture;
+  m_capture = nullptr;
+}
+
+bool RAS_ICanvas::IsCapturing() const
+{
+  return (m_capture != nullptr);
+}
+
+unsigned int RAS_ICanvas::GetNumScreenshots() const
+{
+  return m_numScreenshots;
+}
+
+unsigned int RAS_ICanvas::GetNumDroppedScreenshots() const
+{
+  return m_numDroppedScreenshots;
+}
+
 void RAS_ICanvas::AddScreenshot(
     const std::string &path, int x, int y, int width, int height, ImageFormatData *format)
 {
@@ -143,6 +356,7 @@ void RAS_ICanvas::AddScreenshot(
   screenshot.width = width;
   screenshot.height = height;
   screenshot.format = format;
+  screenshot.capture = false;
 
   m_screenshots.push_back(screenshot);
 }
@@ -161,21 +375,97 @@ void save_screenshot_thread_func(TaskPool *__restrict UNUSED(pool),
 
   ibuf->rect = nullptr;
   IMB_freeImBuf(ibuf);
-  // Dumprect is allocated in RAS_OpenGLRasterizer::MakeScreenShot with malloc(), we must use
-  // free() then.
+  // Dumprect is allocated in RAS_OpenGLRasterizer::MakeScreenShot or EndScreenshot with
+  // malloc(), we must use free() then.
   free(task->dumprect);
   MEM_freeN(task->im_format);
+
+  if (task->capture) {
+    task->capture->mutex.Lock();
+    --task->capture->numQueued;
+    task->capture->mutex.Unlock();
+  }
+}
+
+void capture_frame_thread_func(TaskPool *__restrict UNUSED(pool),
+                               void *taskdata,
+                               int UNUSED(threadid))
+{
+  CaptureData *capture = static_cast<CaptureData *>(taskdata);
+
+  /* The encode lock is kept during the encoding to append the frames in order, the queue lock
+   * only while popping so the render thread never waits for the encoder. */
+  capture->encodeMutex.Lock();
+  capture->mutex.Lock();
+  unsigned int *pixels = capture->frames.front();
+  capture->frames.pop_front();
+  capture->mutex.Unlock();
+
+  capture->handle->append_movie(capture->context,
+                                &capture->rd,
+                                capture->rd.sfra,
+                                capture->frame++,
+                                (int *)pixels,
+                                capture->width,
+                                capture->height,
+                                "",
+                                nullptr);
+  capture->encodeMutex.Unlock();
+
+  capture->mutex.Lock();
+  --capture->numQueued;
+  capture->mutex.Unlock();
+
+  free(pixels);
 }
 
-void RAS_ICanvas::SaveScreeshot(const Screenshot &screenshot)
+void RAS_ICanvas::SaveScreeshot(const Screenshot &screenshot, unsigned int *pixels)
 {
-  unsigned int *pixels = m_rasterizer->MakeScreenshot(
-      screenshot.x, screenshot.y, screenshot.width, screenshot.height);
   if (!pixels) {
     CM_Error("cannot allocate pixels array");
+    if (screenshot.format) {
+      MEM_freeN(screenshot.format);
+    }
     return;
   }
 
+  // Bound the frames waiting in the task pool, the capture must not accumulate memory.
+  if (screenshot.capture) {
+    bool queued = false;
+    if (m_capture && (!m_capture->handle || (screenshot.width == m_capture->width &&
+                                             screenshot.height == m_capture->height))) {
+      m_capture->mutex.Lock();
+      if (m_capture->numQueued < CAPTURE_MAX_QUEUED_FRAMES) {
+        ++m_capture->numQueued;
+        if (m_capture->handle) {
+          m_capture->frames.push_back(pixels);
+        }
+        queued = true;
+      }
+      m_capture->mutex.Unlock();
+    }
+
+    if (!queued) {
+      // The encoder lags, the capture was stopped or the canvas was resized.
+      free(pixels);
+      if (screenshot.format) {
+        MEM_freeN(screenshot.format);
+      }
+      ++m_numDroppedScreenshots;
+      return;
+    }
+
+    // Movie frame, appended by the encoder task.
+    if (m_capture->handle) {
+      BLI_task_pool_push(m_taskpool,
+                         capture_frame_thread_func,
+                         m_capture,
+                         false,  // the capture is owned by the canvas
+                         TASK_PRIORITY_LOW);
+      return;
+    }
+  }
+
   /* Save the actual file in a different thread, so that the
    * game engine can keep running at full speed. */
   ScreenshotTaskData *task = (ScreenshotTaskData *)MEM_mallocN(sizeof(ScreenshotTaskData),
@@ -184,9 +474,11 @@ void RAS_ICanvas::SaveScreeshot(const Screenshot &screenshot)
   task->dumpsx = screenshot.width;
   task->dumpsy = screenshot.height;
   task->im_format = screenshot.format;
+  task->capture = screenshot.capture ? m_capture : nullptr;
 
   BLI_strncpy(task->path, screenshot.path.c_str(), FILE_MAX);
-  BLI_path_frame(task->path, m_frame, 0);
+  // A captured image sequence must not overwrite the same file at each frame.
+  BLI_path_frame(task->path, m_frame, screenshot.capture ? CAPTURE_FRAME_DIGITS : 0);
   m_frame++;
   BKE_image_path_ensure_ext_from_imtype(task->path, task->im_format->imtype);
 
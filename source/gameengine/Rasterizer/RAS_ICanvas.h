@@ -34,9 +34,13 @@
 
 #include "RAS_Rasterizer.h"
 
+#include <deque>
+
 class RAS_Rect;
+class CM_ThreadMutex;
 
 struct ARegion;
+struct CaptureData;
 struct ImageFormatData;
 struct Scene;
 struct TaskPool;
@@ -116,8 +120,24 @@ class RAS_ICanvas {
   }
 
   virtual void MakeScreenShot(const std::string &filename) = 0;
-  /// Proceed the actual screenshot at the frame end.
+  /** Proceed the actual screenshot at the frame end, the pixels are read asynchronously and
+   * saved one or two frames later.
+   */
   void FlushScreenshots();
+  /// Save the pending screenshots and stop the capture, must be called before the rasterizer exit.
+  void FinishScreenshots();
+
+  /** Capture all the rendered frames until StopCapture, using the output settings of the scene:
+   * a movie for movie formats or an image sequence for the other formats.
+   * \return false if the movie can't be started.
+   */
+  bool StartCapture(const std::string &path, Scene *scene);
+  void StopCapture();
+  bool IsCapturing() const;
+  /// Number of screenshots and captured frames requested.
+  unsigned int GetNumScreenshots() const;
+  /// Number of screenshots and captured frames dropped because the readbacks or the encoding lag.
+  unsigned int GetNumDroppedScreenshots() const;
 
   virtual void GetDisplayDimensions(int &width, int &height) = 0;
 
@@ -139,9 +159,28 @@ class RAS_ICanvas {
     int width;
     int height;
     ImageFormatData *format;
+    /// Frame of the capture movie, the frame can be dropped.
+    bool capture;
+  };
+
+  /// Screenshot waiting its asynchronous readback.
+  struct PendingScreenshot {
+    Screenshot screenshot;
+    /// Index of the rasterizer readback.
+    int readback;
+    /// Number of frames since the readback started.
+    unsigned short age;
   };
 
   std::vector<Screenshot> m_screenshots;
+  /// Screenshots read by the GPU, in request order.
+  std::deque<PendingScreenshot> m_pendingScreenshots;
+
+  /// Capture state and movie encoder, nullptr when not capturing.
+  CaptureData *m_capture;
+
+  unsigned int m_numScreenshots;
+  unsigned int m_numDroppedScreenshots;
 
   int m_samples;
 
@@ -161,11 +200,14 @@ class RAS_ICanvas {
   void AddScreenshot(
       const std::string &path, int x, int y, int width, int height, ImageFormatData *format);
 
+  /// Map the finished readbacks, all of them when wait is true.
+  void ProcessPendingScreenshots(bool wait);
+
   /**
    * Saves screenshot data to a file. The actual compression and disk I/O is performed in
-   * a separate thread.
+   * a separate thread. Capture frames are queued to the movie encoder.
    */
-  void SaveScreeshot(const Screenshot &screenshot);
+  void SaveScreeshot(const Screenshot &screenshot, unsigned int *pixels);
 };
 
 #endif  // __RAS_ICANVAS_H__
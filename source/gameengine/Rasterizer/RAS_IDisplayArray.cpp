@@ -132,6 +132,13 @@ void RAS_IDisplayArray::UpdateFrom(RAS_IDisplayArray *other, int flag)
   }
 }
 
+size_t RAS_IDisplayArray::GetMemorySize() const
+{
+  return (size_t)GetVertexMemorySize() * GetVertexCount() +
+         m_vertexInfos.size() * sizeof(RAS_TexVertInfo) +
+         m_vertexPtrs.size() * sizeof(RAS_ITexVert *) + m_indices.size() * sizeof(unsigned int);
+}
+
 unsigned short RAS_IDisplayArray::GetModifiedFlag() const
 {
   return m_modifiedFlag;
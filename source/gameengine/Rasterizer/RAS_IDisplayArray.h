@@ -150,6 +150,9 @@ class RAS_IDisplayArray {
   /// Copy vertex pointers to the cache list m_vertexPtrs.
   virtual void UpdateCache() = 0;
 
+  /// Return the memory used by the vertices and the indices.
+  size_t GetMemorySize() const;
+
   /// Return the primitive type used for indices.
   PrimitiveType GetPrimitiveType() const;
   /// Return the primitive type used for indices in OpenGL value.
@@ -30,6 +30,7 @@
  */
 
 #include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
 
 #include "RAS_MeshObject.h"
 #include "RAS_Polygon.h"
@@ -43,7 +44,11 @@
 
 #include "CM_Message.h"
 
+#include "BKE_customdata.h"
+#include "BLI_math.h"
+
 #include <algorithm>
+#include <cstring>
 
 // polygon sorting
 
@@ -97,7 +102,11 @@ struct RAS_MeshObject::fronttoback {
 // mesh object
 
 RAS_MeshObject::RAS_MeshObject(Mesh *mesh, Object *originalOb, const LayersInfo &layersInfo)
-    : m_name(mesh->id.name + 2), m_layersInfo(layersInfo), m_mesh(mesh), m_originalOb(originalOb)
+    : m_name(mesh->id.name + 2),
+      m_layersInfo(layersInfo),
+      m_mesh(mesh),
+      m_originalOb(originalOb),
+      m_deformed(false)
 {
 }
 
@@ -414,8 +423,96 @@ bool RAS_MeshObject::HasColliderPolygon()
   return false;
 }
 
+size_t RAS_MeshObject::GetMemorySize() const
+{
+  size_t size = m_polygons.size() * sizeof(RAS_Polygon);
+
+  for (const RAS_MeshMaterial *meshmat : m_materials) {
+    size += meshmat->GetDisplayArray()->GetMemorySize();
+  }
+
+  for (const std::vector<SharedVertex> &sharedVertices : m_sharedvertex_map) {
+    size += sharedVertices.size() * sizeof(SharedVertex);
+  }
+
+  size += m_loopVertices.size() * sizeof(unsigned int);
+
+  return size;
+}
+
 /* In 2.8 code, ReinstancePhysicsShape2 needs an Object to recalculate the physics shape */
 Object *RAS_MeshObject::GetOriginalObject()
 {
   return m_originalOb;
 }
+
+bool RAS_MeshObject::IsOrigMeshWritable() const
+{
+  // The loops are known only if the converted mesh has the topology of the original mesh.
+  return (m_mesh && m_loopVertices.size() == (size_t)m_mesh->totloop &&
+          m_sharedvertex_map.size() == (size_t)m_mesh->totvert);
+}
+
+bool RAS_MeshObject::UpdateOrigMesh()
+{
+  bool modified = false;
+  const bool writable = IsOrigMeshWritable();
+
+  for (RAS_MeshMaterial *meshmat : m_materials) {
+    RAS_IDisplayArray *array = meshmat->GetDisplayArray();
+    const unsigned short flag = array->GetModifiedFlag();
+    if (flag == RAS_IDisplayArray::NONE_MODIFIED) {
+      continue;
+    }
+
+    array->SetModifiedFlag(RAS_IDisplayArray::NONE_MODIFIED);
+
+    /* Normals and tangents are computed again by the mesh evaluation from the positions and
+     * UVs, they are not written. */
+    if (!writable || !(flag & (RAS_IDisplayArray::POSITION_MODIFIED |
+                               RAS_IDisplayArray::UVS_MODIFIED |
+                               RAS_IDisplayArray::COLORS_MODIFIED))) {
+      continue;
+    }
+
+    const unsigned short uvSize = min_ii(array->GetVertexUvSize(),
+                                         CustomData_number_of_layers(&m_mesh->ldata, CD_MLOOPUV));
+    const unsigned short colorSize = min_ii(
+        array->GetVertexColorSize(), CustomData_number_of_layers(&m_mesh->ldata, CD_MLOOPCOL));
+
+    for (unsigned int i = 0; i < (unsigned int)m_mesh->totpoly; ++i) {
+      const MPoly &mpoly = m_mesh->mpoly[i];
+      if (mpoly.mat_nr != meshmat->GetIndex()) {
+        continue;
+      }
+
+      for (unsigned int j = mpoly.loopstart; j < (unsigned int)(mpoly.loopstart + mpoly.totloop);
+           ++j) {
+        const RAS_ITexVert *vertex = array->GetVertex(m_loopVertices[j]);
+
+        if ((flag & RAS_IDisplayArray::POSITION_MODIFIED) && !m_deformed) {
+          copy_v3_v3(m_mesh->mvert[m_mesh->mloop[j].v].co, vertex->getXYZ());
+        }
+        if (flag & RAS_IDisplayArray::UVS_MODIFIED) {
+          for (unsigned short uv = 0; uv < uvSize; ++uv) {
+            MLoopUV *layer = (MLoopUV *)CustomData_get_layer_n(&m_mesh->ldata, CD_MLOOPUV, uv);
+            copy_v2_v2(layer[j].uv, vertex->getUV(uv));
+          }
+        }
+        if (flag & RAS_IDisplayArray::COLORS_MODIFIED) {
+          for (unsigned short color = 0; color < colorSize; ++color) {
+            MLoopCol *layer = (MLoopCol *)CustomData_get_layer_n(
+                &m_mesh->ldata, CD_MLOOPCOL, color);
+            // Color isn't swapped in MLoopCol, as in the conversion.
+            const unsigned int rgba = vertex->getRawRGBA(color);
+            memcpy(&layer[j], &rgba, sizeof(MLoopCol));
+          }
+        }
+      }
+    }
+
+    modified = true;
+  }
+
+  return modified;
+}
@@ -164,8 +164,20 @@ class RAS_MeshObject {
 
   bool HasColliderPolygon();
 
+  /// Return the memory used by the display arrays and the polygons.
+  size_t GetMemorySize() const;
+
   Object *GetOriginalObject();
 
+  /// Return true if the display arrays can be written back to the original mesh.
+  bool IsOrigMeshWritable() const;
+  /** Write the positions, UVs and colors modified in the display arrays to the original mesh
+   * and clear the modified flags of the display arrays. The positions of deformed meshes are
+   * not written, see m_deformed.
+   * \return True if the original mesh was modified and must be evaluated again.
+   */
+  bool UpdateOrigMesh();
+
   // for construction to find shared vertices
   struct SharedVertex {
     RAS_IDisplayArray *m_darray;
@@ -173,6 +185,13 @@ class RAS_MeshObject {
   };
 
   std::vector<std::vector<SharedVertex>> m_sharedvertex_map;
+
+  /// Offset in its display array of the vertex of each original mesh loop, empty if unknown.
+  std::vector<unsigned int> m_loopVertices;
+  /** The converted positions are deformed by modifiers or shape keys, writing them to the
+   * original mesh would deform them twice.
+   */
+  bool m_deformed;
 };
 
 #endif  // __RAS_MESHOBJECT_H__
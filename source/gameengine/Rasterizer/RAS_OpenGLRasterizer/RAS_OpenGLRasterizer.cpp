@@ -173,10 +173,21 @@ inline void RAS_OpenGLRasterizer::ScreenPlane::Render()
 
 RAS_OpenGLRasterizer::RAS_OpenGLRasterizer(RAS_Rasterizer *rasterizer) : m_rasterizer(rasterizer)
 {
+  for (ScreenshotReadback &readback : m_screenshotReadbacks) {
+    readback = {0, 0, 0, 0, nullptr};
+  }
 }
 
 RAS_OpenGLRasterizer::~RAS_OpenGLRasterizer()
 {
+  for (ScreenshotReadback &readback : m_screenshotReadbacks) {
+    if (readback.m_fence) {
+      glDeleteSync(readback.m_fence);
+    }
+    if (readback.m_pbo) {
+      glDeleteBuffers(1, &readback.m_pbo);
+    }
+  }
 }
 
 unsigned short RAS_OpenGLRasterizer::GetNumLights() const
@@ -232,6 +243,79 @@ unsigned int *RAS_OpenGLRasterizer::MakeScreenshot(int x, int y, int width, int
   return pixeldata;
 }
 
+int RAS_OpenGLRasterizer::BeginScreenshot(int x, int y, int width, int height)
+{
+  if (width <= 0 || height <= 0) {
+    return -1;
+  }
+
+  for (unsigned short i = 0; i < RAS_Rasterizer::RAS_SCREENSHOT_READBACKS; ++i) {
+    ScreenshotReadback &readback = m_screenshotReadbacks[i];
+    // Still read by the GPU or waiting to be mapped.
+    if (readback.m_fence) {
+      continue;
+    }
+
+    const unsigned int size = sizeof(unsigned int) * width * height;
+    if (readback.m_pbo == 0) {
+      glGenBuffers(1, &readback.m_pbo);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.m_pbo);
+    if (readback.m_size < size) {
+      glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+      readback.m_size = size;
+    }
+    // The copy is queued in the pixel buffer, the call returns without waiting the GPU.
+    glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    readback.m_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    readback.m_width = width;
+    readback.m_height = height;
+
+    return i;
+  }
+
+  return -1;
+}
+
+bool RAS_OpenGLRasterizer::IsScreenshotReady(int index)
+{
+  const ScreenshotReadback &readback = m_screenshotReadbacks[index];
+  BLI_assert(readback.m_fence);
+
+  return (glClientWaitSync(readback.m_fence, 0, 0) != GL_TIMEOUT_EXPIRED);
+}
+
+unsigned int *RAS_OpenGLRasterizer::EndScreenshot(int index)
+{
+  ScreenshotReadback &readback = m_screenshotReadbacks[index];
+  BLI_assert(readback.m_fence);
+
+  glDeleteSync(readback.m_fence);
+  readback.m_fence = nullptr;
+
+  const unsigned int size = sizeof(unsigned int) * readback.m_width * readback.m_height;
+  unsigned int *pixeldata = (unsigned int *)malloc(size);
+
+  // The mapping waits for the read if the GPU didn't finish it yet.
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.m_pbo);
+  const void *data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+  if (data && pixeldata) {
+    memcpy(pixeldata, data, size);
+  }
+  else {
+    free(pixeldata);
+    pixeldata = nullptr;
+  }
+  if (data) {
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  return pixeldata;
+}
+
 void RAS_OpenGLRasterizer::Clear(int clearbit)
 {
   GLbitfield glclearbit = 0;
@@ -59,6 +59,19 @@ class RAS_OpenGLRasterizer {
   /// Class used to render a screen plane.
   ScreenPlane m_screenPlane;
 
+  /// Pixel buffer read asynchronously, the pixels are mapped once the fence is signaled.
+  struct ScreenshotReadback {
+    unsigned int m_pbo;
+    unsigned int m_size;
+    int m_width;
+    int m_height;
+    /// Fence of the read, non null while the readback is pending.
+    struct __GLsync *m_fence;
+  };
+
+  /// Ring of pixel buffers for the screenshots, read one or two frames after their request.
+  ScreenshotReadback m_screenshotReadbacks[RAS_Rasterizer::RAS_SCREENSHOT_READBACKS];
+
   RAS_Rasterizer *m_rasterizer;
 
  public:
@@ -76,6 +89,9 @@ class RAS_OpenGLRasterizer {
   void SetBlendFunc(RAS_Rasterizer::BlendFunc src, RAS_Rasterizer::BlendFunc dst);
 
   unsigned int *MakeScreenshot(int x, int y, int width, int height);
+  int BeginScreenshot(int x, int y, int width, int height);
+  bool IsScreenshotReady(int index);
+  unsigned int *EndScreenshot(int index);
 
   void Init();
   void Exit();
@@ -349,6 +349,21 @@ unsigned int *RAS_Rasterizer::MakeScreenshot(int x, int y, int width, int height
   return m_impl->MakeScreenshot(x, y, width, height);
 }
 
+int RAS_Rasterizer::BeginScreenshot(int x, int y, int width, int height)
+{
+  return m_impl->BeginScreenshot(x, y, width, height);
+}
+
+bool RAS_Rasterizer::IsScreenshotReady(int index)
+{
+  return m_impl->IsScreenshotReady(index);
+}
+
+unsigned int *RAS_Rasterizer::EndScreenshot(int index)
+{
+  return m_impl->EndScreenshot(index);
+}
+
 void RAS_Rasterizer::Clear(int clearbit)
 {
   m_impl->Clear(clearbit);
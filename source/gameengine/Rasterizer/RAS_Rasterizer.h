@@ -100,6 +100,9 @@ class RAS_Rasterizer {
     RAS_BACKCULL = 16,  // GEMAT_BACKCULL
   };
 
+  /// Number of screenshots which can be read asynchronously at the same time.
+  enum { RAS_SCREENSHOT_READBACKS = 3 };
+
   /**
    * Stereo mode types
    */
@@ -320,6 +323,17 @@ class RAS_Rasterizer {
    */
   unsigned int *MakeScreenshot(int x, int y, int width, int height);
 
+  /** Start to read the frame buffer area in a pixel buffer without waiting the GPU.
+   * \return The index of the readback, -1 when all the readbacks are pending.
+   */
+  int BeginScreenshot(int x, int y, int width, int height);
+  /// Return true when the GPU finished the readback, mapping it will not stall.
+  bool IsScreenshotReady(int index);
+  /** Finish a readback started by BeginScreenshot, waiting for the GPU if needed.
+   * \return The pixels allocated with malloc().
+   */
+  unsigned int *EndScreenshot(int index);
+
   /**
    * SetDepthMask enables or disables writing a fragment's depth value
    * to the Z buffer.
@@ -87,6 +87,8 @@ ImageRender::ImageRender(KX_Scene *scene,
       m_scene(scene),
       m_camera(camera),
       m_owncamera(false),
+      m_updateRate(0.0f),
+      m_lastRenderTime(-1.0),
       m_observer(nullptr),
       m_mirror(nullptr),
       m_clip(100.f),
@@ -176,6 +178,14 @@ bool ImageRender::Render()
     return false;
   }
 
+  // keep the previous render until the update period elapsed, e.g. for a minimap
+  const double time = m_engine->GetFrameTime();
+  if (m_updateRate > 0.0f && m_lastRenderTime >= 0.0 &&
+      (time - m_lastRenderTime) < (1.0 / m_updateRate)) {
+    return false;
+  }
+  m_lastRenderTime = time;
+
   if (m_mirror) {
     // mirror mode, compute camera frustum, position and orientation
     // convert mirror position and normal in world space
@@ -488,6 +498,26 @@ static PyObject *getColorBindCode(PyImage *self, void *closure)
   return PyLong_FromLong(getImageRender(self)->GetColorBindCode());
 }
 
+// get update rate
+static PyObject *getUpdateRate(PyImage *self, void *closure)
+{
+  return PyFloat_FromDouble(getImageRender(self)->getUpdateRate());
+}
+
+// set update rate
+static int setUpdateRate(PyImage *self, PyObject *value, void *closure)
+{
+  // check validity of parameter
+  double rate;
+  if (value == nullptr || !PyNumber_Check(value) || (rate = PyFloat_AsDouble(value)) < 0.0) {
+    PyErr_SetString(PyExc_TypeError, "The value must be a positive float, 0 to disable");
+    return -1;
+  }
+  getImageRender(self)->setUpdateRate(float(rate));
+  // success
+  return 0;
+}
+
 // methods structure
 static PyMethodDef imageRenderMethods[] = {  // methods from ImageBase class
     {"refresh",
@@ -556,6 +586,11 @@ static PyGetSetDef imageRenderGetSets[] = {
      nullptr,
      (char *)"Off-screen color texture bind code",
      nullptr},
+    {(char *)"updateRate",
+     (getter)getUpdateRate,
+     (setter)setUpdateRate,
+     (char *)"render frequency in Hz, 0 to render at each refresh",
+     nullptr},
     {nullptr}};
 
 // define python type
@@ -711,6 +746,11 @@ static int setClip(PyImage *self, PyObject *value, void *closure)
 // attributes structure
 static PyGetSetDef imageMirrorGetSets[] = {
     {(char *)"clip", (getter)getClip, (setter)setClip, (char *)"clipping distance", nullptr},
+    {(char *)"updateRate",
+     (getter)getUpdateRate,
+     (setter)setUpdateRate,
+     (char *)"render frequency in Hz, 0 to render at each refresh",
+     nullptr},
     // attribute from ImageViewport
     {(char *)"capsize",
      (getter)ImageViewport_getCaptureSize,
@@ -774,6 +814,8 @@ ImageRender::ImageRender(KX_Scene *scene,
       m_render(false),
       m_done(false),
       m_scene(scene),
+      m_updateRate(0.0f),
+      m_lastRenderTime(-1.0),
       m_observer(observer),
       m_mirror(mirror),
       m_clip(100.f)
@@ -76,6 +76,16 @@ class ImageRender : public ImageViewport {
   {
     m_clip = clip;
   }
+  /// update rate in Hz, 0 to render at each refresh
+  float getUpdateRate(void)
+  {
+    return m_updateRate;
+  }
+  /// set update rate
+  void setUpdateRate(float rate)
+  {
+    m_updateRate = rate;
+  }
   /// render status
   bool isDone()
   {
@@ -97,6 +107,10 @@ class ImageRender : public ImageViewport {
   KX_Camera *m_camera;
   /// do we own the camera?
   bool m_owncamera;
+  /// update rate in Hz, 0 to render at each refresh
+  float m_updateRate;
+  /// frame time of the last render, negative before the first one
+  double m_lastRenderTime;
 
   GPUFrameBuffer *m_targetfb;
 
@@ -70,6 +70,9 @@ VideoFFmpeg::VideoFFmpeg(HRESULT *hRslt)
       m_frameDeinterlaced(nullptr),
       m_frameRGB(nullptr),
       m_imgConvertCtx(nullptr),
+      m_frameFlip(false),
+      m_directConversion(false),
+      m_cacheSize(CACHE_FRAME_SIZE),
       m_deinterlace(false),
       m_preseek(0),
       m_videoStream(-1),
@@ -89,7 +92,8 @@ VideoFFmpeg::VideoFFmpeg(HRESULT *hRslt)
       m_cacheStarted(false)
 {
   // set video format
-  m_format = RGB24;
+  m_format = RGBA32;
+  m_frameSize[0] = m_frameSize[1] = 0;
   // force flip because ffmpeg always return the image in the wrong orientation for texture
   setFlip(true);
   // construction is OK
@@ -156,25 +160,109 @@ AVFrame *VideoFFmpeg::allocFrameRGB()
 {
   AVFrame *frame;
   frame = av_frame_alloc();
-  if (m_format == RGBA32) {
-    avpicture_fill((AVPicture *)frame,
-                   (uint8_t *)MEM_callocN(
-                       avpicture_get_size(AV_PIX_FMT_RGBA, m_codecCtx->width, m_codecCtx->height),
-                       "ffmpeg rgba"),
-                   AV_PIX_FMT_RGBA,
-                   m_codecCtx->width,
-                   m_codecCtx->height);
+  avpicture_fill((AVPicture *)frame,
+                 (uint8_t *)MEM_callocN(
+                     avpicture_get_size(AV_PIX_FMT_RGBA, m_frameSize[0], m_frameSize[1]),
+                     "ffmpeg rgba"),
+                 AV_PIX_FMT_RGBA,
+                 m_frameSize[0],
+                 m_frameSize[1]);
+  return frame;
+}
+
+// create the frame conversion for the current image settings, if they changed
+bool VideoFFmpeg::setupConversion(void)
+{
+  // without filter the frames are converted directly to the layout of the image buffer,
+  // so that the image is only copied
+  bool direct = (m_pyfilter == nullptr);
+  bool flip = direct && m_flip;
+  short size[2] = {short(m_codecCtx->width), short(m_codecCtx->height)};
+  if (direct && m_scale) {
+    size[0] = calcSize(size[0]);
+    size[1] = calcSize(size[1]);
   }
-  else {
-    avpicture_fill((AVPicture *)frame,
-                   (uint8_t *)MEM_callocN(
-                       avpicture_get_size(AV_PIX_FMT_RGB24, m_codecCtx->width, m_codecCtx->height),
-                       "ffmpeg rgb"),
-                   AV_PIX_FMT_RGB24,
-                   m_codecCtx->width,
-                   m_codecCtx->height);
+
+  if (m_imgConvertCtx && direct == m_directConversion && flip == m_frameFlip &&
+      size[0] == m_frameSize[0] && size[1] == m_frameSize[1]) {
+    return true;
   }
-  return frame;
+
+  // the frames in cache use the previous layout
+  stopCache();
+  if (m_imgConvertCtx) {
+    sws_freeContext(m_imgConvertCtx);
+    m_imgConvertCtx = nullptr;
+  }
+  if (m_frameRGB) {
+    MEM_freeN(m_frameRGB->data[0]);
+    av_free(m_frameRGB);
+    m_frameRGB = nullptr;
+  }
+
+  m_directConversion = direct;
+  m_frameFlip = flip;
+  m_frameSize[0] = size[0];
+  m_frameSize[1] = size[1];
+
+  // scaling and flipping are done in the same pass than the pixel format conversion
+  m_imgConvertCtx = sws_getContext(m_codecCtx->width,
+                                   m_codecCtx->height,
+                                   m_codecCtx->pix_fmt,
+                                   m_frameSize[0],
+                                   m_frameSize[1],
+                                   AV_PIX_FMT_RGBA,
+                                   SWS_FAST_BILINEAR,
+                                   nullptr,
+                                   nullptr,
+                                   nullptr);
+  if (!m_imgConvertCtx) {
+    return false;
+  }
+
+  m_frameRGB = allocFrameRGB();
+  return true;
+}
+
+// convert the decoded frame m_frame
+bool VideoFFmpeg::convertFrame(AVFrame *output)
+{
+  AVFrame *input = m_frame;
+
+  /* This means the data wasnt read properly, this check stops crashing */
+  if (input->data[0] == 0 && input->data[1] == 0 && input->data[2] == 0 && input->data[3] == 0) {
+    return false;
+  }
+
+  if (m_deinterlace) {
+    if (avpicture_deinterlace((AVPicture *)m_frameDeinterlaced,
+                              (const AVPicture *)m_frame,
+                              m_codecCtx->pix_fmt,
+                              m_codecCtx->width,
+                              m_codecCtx->height) >= 0) {
+      input = m_frameDeinterlaced;
+    }
+  }
+
+  uint8_t *data[4] = {output->data[0], nullptr, nullptr, nullptr};
+  int linesize[4] = {output->linesize[0], 0, 0, 0};
+  if (m_frameFlip) {
+    // write the rows bottom to top
+    data[0] += linesize[0] * (m_frameSize[1] - 1);
+    linesize[0] = -linesize[0];
+  }
+
+  // convert to RGBA
+  sws_scale(
+      m_imgConvertCtx, input->data, input->linesize, 0, m_codecCtx->height, data, linesize);
+  return true;
+}
+
+// timestamp of the decoded frame, the frame is not the one of the last packet when decoding
+// with frame threads
+static int64_t frame_dts(AVFrame *frame, const AVPacket &packet)
+{
+  return (frame->pkt_dts != AV_NOPTS_VALUE) ? frame->pkt_dts : packet.dts;
 }
 
 // set initial parameters
@@ -227,6 +315,12 @@ int VideoFFmpeg::openStream(const char *filename,
     return -1;
   }
   codecCtx->workaround_bugs = 1;
+  // an image is a single frame, no need for threads
+  if (!m_isImage) {
+    codecCtx->thread_count = BLI_system_thread_count();
+    // frame threading delays the frames of one frame per thread, not wanted for a capture
+    codecCtx->thread_type = (inputFormat) ? FF_THREAD_SLICE : FF_THREAD_FRAME | FF_THREAD_SLICE;
+  }
   if (avcodec_open2(codecCtx, codec, nullptr) < 0) {
     avformat_close_input(&formatCtx);
     return -1;
@@ -259,41 +353,9 @@ int VideoFFmpeg::openStream(const char *filename,
       m_codecCtx->width,
       m_codecCtx->height);
 
-  // check if the pixel format supports Alpha
-  if (m_codecCtx->pix_fmt == AV_PIX_FMT_RGB32 || m_codecCtx->pix_fmt == AV_PIX_FMT_BGR32 ||
-      m_codecCtx->pix_fmt == AV_PIX_FMT_RGB32_1 || m_codecCtx->pix_fmt == AV_PIX_FMT_BGR32_1) {
-    // allocate buffer to store final decoded frame
-    m_format = RGBA32;
-    // allocate sws context
-    m_imgConvertCtx = sws_getContext(m_codecCtx->width,
-                                     m_codecCtx->height,
-                                     m_codecCtx->pix_fmt,
-                                     m_codecCtx->width,
-                                     m_codecCtx->height,
-                                     AV_PIX_FMT_RGBA,
-                                     SWS_FAST_BILINEAR,
-                                     nullptr,
-                                     nullptr,
-                                     nullptr);
-  }
-  else {
-    // allocate buffer to store final decoded frame
-    m_format = RGB24;
-    // allocate sws context
-    m_imgConvertCtx = sws_getContext(m_codecCtx->width,
-                                     m_codecCtx->height,
-                                     m_codecCtx->pix_fmt,
-                                     m_codecCtx->width,
-                                     m_codecCtx->height,
-                                     AV_PIX_FMT_RGB24,
-                                     SWS_FAST_BILINEAR,
-                                     nullptr,
-                                     nullptr,
-                                     nullptr);
-  }
-  m_frameRGB = allocFrameRGB();
-
-  if (!m_imgConvertCtx) {
+  // the conversion is setup for the default image settings, it is updated when they change
+  m_format = RGBA32;
+  if (!setupConversion()) {
     avcodec_close(m_codecCtx);
     m_codecCtx = nullptr;
     avformat_close_input(&m_formatCtx);
@@ -303,9 +365,6 @@ int VideoFFmpeg::openStream(const char *filename,
     MEM_freeN(m_frameDeinterlaced->data[0]);
     av_free(m_frameDeinterlaced);
     m_frameDeinterlaced = nullptr;
-    MEM_freeN(m_frameRGB->data[0]);
-    av_free(m_frameRGB);
-    m_frameRGB = nullptr;
     return -1;
   }
   return 0;
@@ -317,7 +376,9 @@ int VideoFFmpeg::openStream(const char *filename,
  * The main thread is responsible for positioning the frame pointer in the
  * file correctly before calling startCache() which starts this thread.
  * The cache is organized in two layers: 1) a cache of 20-30 undecoded packets to keep
- * memory and CPU low 2) a cache of 5 decoded frames.
+ * memory and CPU low 2) a cache of m_cacheSize decoded frames, converted to the layout of the
+ * image buffer when possible.
+ * The decoding itself is spread on several threads by ffmpeg (see openStream).
  * If the main thread does not find the frame in the cache (because the video has restarted
  * or because the GE is lagging), it stops the cache with StopCache() (this is a synchronous
  * function: it sends a signal to stop the cache thread and wait for confirmation), then
@@ -384,34 +445,34 @@ void *VideoFFmpeg::cacheThread(void *data)
              (cachePacket = (CachePacket *)video->m_packetCacheBase.first) != nullptr) {
         BLI_remlink(&video->m_packetCacheBase, cachePacket);
         // use m_frame because when caching, it is not used in main thread
-        // we can't use currentFrame directly because we need to convert to RGB first
+        // we can't use currentFrame directly because we need to convert to RGBA first
         avcodec_decode_video2(
             video->m_codecCtx, video->m_frame, &frameFinished, &cachePacket->packet);
+        if (frameFinished && video->convertFrame(currentFrame->frame)) {
+          // move frame to queue, this frame is necessarily the next one
+          video->m_curPosition = (long)((frame_dts(video->m_frame, cachePacket->packet) -
+                                         startTs) *
+                                            (video->m_baseFrameRate * timeBase) +
+                                        0.5);
+          currentFrame->framePosition = video->m_curPosition;
+          pthread_mutex_lock(&video->m_cacheMutex);
+          BLI_addtail(&video->m_frameCacheBase, currentFrame);
+          pthread_mutex_unlock(&video->m_cacheMutex);
+          currentFrame = nullptr;
+        }
+        av_free_packet(&cachePacket->packet);
+        BLI_addtail(&video->m_packetCacheFree, cachePacket);
+      }
+      if (currentFrame && endOfFile) {
+        // no more packet, get the frames still delayed by the decoding threads
+        AVPacket flushPacket;
+        av_init_packet(&flushPacket);
+        flushPacket.data = nullptr;
+        flushPacket.size = 0;
+        avcodec_decode_video2(video->m_codecCtx, video->m_frame, &frameFinished, &flushPacket);
         if (frameFinished) {
-          AVFrame *input = video->m_frame;
-
-          /* This means the data wasnt read properly, this check stops crashing */
-          if (input->data[0] != 0 || input->data[1] != 0 || input->data[2] != 0 ||
-              input->data[3] != 0) {
-            if (video->m_deinterlace) {
-              if (avpicture_deinterlace((AVPicture *)video->m_frameDeinterlaced,
-                                        (const AVPicture *)video->m_frame,
-                                        video->m_codecCtx->pix_fmt,
-                                        video->m_codecCtx->width,
-                                        video->m_codecCtx->height) >= 0) {
-                input = video->m_frameDeinterlaced;
-              }
-            }
-            // convert to RGB24
-            sws_scale(video->m_imgConvertCtx,
-                      input->data,
-                      input->linesize,
-                      0,
-                      video->m_codecCtx->height,
-                      currentFrame->frame->data,
-                      currentFrame->frame->linesize);
-            // move frame to queue, this frame is necessarily the next one
-            video->m_curPosition = (long)((cachePacket->packet.dts - startTs) *
+          if (video->convertFrame(currentFrame->frame)) {
+            video->m_curPosition = (long)((frame_dts(video->m_frame, flushPacket) - startTs) *
                                               (video->m_baseFrameRate * timeBase) +
                                           0.5);
             currentFrame->framePosition = video->m_curPosition;
@@ -421,18 +482,16 @@ void *VideoFFmpeg::cacheThread(void *data)
             currentFrame = nullptr;
           }
         }
-        av_free_packet(&cachePacket->packet);
-        BLI_addtail(&video->m_packetCacheFree, cachePacket);
-      }
-      if (currentFrame && endOfFile) {
-        // no more packet and end of file => put a special frame that indicates that
-        currentFrame->framePosition = -1;
-        pthread_mutex_lock(&video->m_cacheMutex);
-        BLI_addtail(&video->m_frameCacheBase, currentFrame);
-        pthread_mutex_unlock(&video->m_cacheMutex);
-        currentFrame = nullptr;
-        // no need to stay any longer in this thread
-        break;
+        else {
+          // no more frame and end of file => put a special frame that indicates that
+          currentFrame->framePosition = -1;
+          pthread_mutex_lock(&video->m_cacheMutex);
+          BLI_addtail(&video->m_frameCacheBase, currentFrame);
+          pthread_mutex_unlock(&video->m_cacheMutex);
+          currentFrame = nullptr;
+          // no need to stay any longer in this thread
+          break;
+        }
       }
     }
     // small sleep to avoid unnecessary looping
@@ -454,7 +513,7 @@ bool VideoFFmpeg::startCache()
 {
   if (!m_cacheStarted && m_isThreaded) {
     m_stopThread = false;
-    for (int i = 0; i < CACHE_FRAME_SIZE; i++) {
+    for (int i = 0; i < m_cacheSize; i++) {
       CacheFrame *frame = new CacheFrame();
       frame->frame = allocFrameRGB();
       BLI_addtail(&m_frameCacheFree, frame);
@@ -777,6 +836,11 @@ void VideoFFmpeg::calcImage(unsigned int texId, double ts)
     // if actual frame differs from last frame
     if (actFrame != m_lastFrame) {
       AVFrame *frame;
+      // the filter, flip or scale settings of the image may have changed
+      if (!setupConversion()) {
+        m_status = SourceError;
+        return;
+      }
       // get image
       if ((frame = grabFrame(actFrame)) != nullptr) {
         if (!m_isFile && !m_cacheStarted) {
@@ -793,7 +857,16 @@ void VideoFFmpeg::calcImage(unsigned int texId, double ts)
         // init image, if needed
         init(short(m_codecCtx->width), short(m_codecCtx->height));
         // process image
-        process((BYTE *)(frame->data[0]));
+        if (m_directConversion) {
+          // the frame is already in the layout of the image buffer
+          if (m_image != nullptr && !m_avail) {
+            memcpy(m_image, frame->data[0], m_size[0] * m_size[1] * sizeof(unsigned int));
+            m_avail = true;
+          }
+        }
+        else {
+          process((BYTE *)(frame->data[0]));
+        }
         // finished with the frame, release it so that cache can reuse it
         releaseFrame(frame);
         // in case it is an image, automatically stop reading it
@@ -897,7 +970,9 @@ AVFrame *VideoFFmpeg::grabFrame(long position)
         if (packet.stream_index == m_videoStream) {
           avcodec_decode_video2(m_codecCtx, m_frame, &frameFinished, &packet);
           if (frameFinished) {
-            m_curPosition = (long)((packet.dts - startTs) * (m_baseFrameRate * timeBase) + 0.5);
+            m_curPosition = (long)((frame_dts(m_frame, packet) - startTs) *
+                                       (m_baseFrameRate * timeBase) +
+                                   0.5);
           }
         }
         av_free_packet(&packet);
@@ -959,7 +1034,19 @@ AVFrame *VideoFFmpeg::grabFrame(long position)
 
   // find the correct frame, in case of streaming and no cache, it means just
   // return the next frame. This is not quite correct, may need more work
-  while (av_read_frame(m_formatCtx, &packet) >= 0) {
+  while (true) {
+    bool endOfFile = false;
+    if (av_read_frame(m_formatCtx, &packet) < 0) {
+      // only a file has an end, get the frames still delayed by the decoding threads
+      if (!m_isFile) {
+        break;
+      }
+      endOfFile = true;
+      av_init_packet(&packet);
+      packet.data = nullptr;
+      packet.size = 0;
+      packet.stream_index = m_videoStream;
+    }
     if (packet.stream_index == m_videoStream) {
       AVFrame *input = m_frame;
       short counter = 0;
@@ -973,42 +1060,26 @@ AVFrame *VideoFFmpeg::grabFrame(long position)
                 input->data[3] == 0) &&
                counter < 10 && m_isImage);
 
-      // remember dts to compute exact frame number
-      dts = packet.dts;
-      if (frameFinished && !posFound) {
-        if (dts >= targetTs) {
+      // decoder is empty at end of file
+      if (endOfFile && !frameFinished) {
+        break;
+      }
+
+      if (frameFinished) {
+        // remember dts to compute exact frame number
+        dts = frame_dts(m_frame, packet);
+        if (!posFound && dts >= targetTs) {
           posFound = 1;
         }
       }
 
       if (frameFinished && posFound == 1) {
-        AVFrame *input = m_frame;
-
         /* This means the data wasnt read properly,
          * this check stops crashing */
-        if (input->data[0] == 0 && input->data[1] == 0 && input->data[2] == 0 &&
-            input->data[3] == 0) {
+        if (!convertFrame(m_frameRGB)) {
           av_free_packet(&packet);
           break;
         }
-
-        if (m_deinterlace) {
-          if (avpicture_deinterlace((AVPicture *)m_frameDeinterlaced,
-                                    (const AVPicture *)m_frame,
-                                    m_codecCtx->pix_fmt,
-                                    m_codecCtx->width,
-                                    m_codecCtx->height) >= 0) {
-            input = m_frameDeinterlaced;
-          }
-        }
-        // convert to RGB24
-        sws_scale(m_imgConvertCtx,
-                  input->data,
-                  input->linesize,
-                  0,
-                  m_codecCtx->height,
-                  m_frameRGB->data,
-                  m_frameRGB->linesize);
         av_free_packet(&packet);
         frameLoaded = true;
         break;
@@ -1122,6 +1193,26 @@ static int VideoFFmpeg_setDeinterlace(PyImage *self, PyObject *value, void *clos
   return 0;
 }
 
+// get cache size
+static PyObject *VideoFFmpeg_getCacheSize(PyImage *self, void *closure)
+{
+  return Py_BuildValue("i", getFFmpeg(self)->getCacheSize());
+}
+
+// set cache size
+static int VideoFFmpeg_setCacheSize(PyImage *self, PyObject *value, void *closure)
+{
+  // check validity of parameter
+  if (value == nullptr || !PyLong_Check(value) || PyLong_AsLong(value) < 1) {
+    PyErr_SetString(PyExc_TypeError, "The value must be a positive integer");
+    return -1;
+  }
+  // set cache size
+  getFFmpeg(self)->setCacheSize(PyLong_AsLong(value));
+  // success
+  return 0;
+}
+
 // methods structure
 static PyMethodDef videoMethods[] = {  // methods from VideoBase class
     {"play", (PyCFunction)Video_play, METH_NOARGS, "Play (restart) video"},
@@ -1180,6 +1271,11 @@ static PyGetSetDef videoGetSets[] = {  // methods from VideoBase class
      (setter)VideoFFmpeg_setDeinterlace,
      (char *)"deinterlace image",
      nullptr},
+    {(char *)"cachesize",
+     (getter)VideoFFmpeg_getCacheSize,
+     (setter)VideoFFmpeg_setCacheSize,
+     (char *)"nb of decoded frames in cache",
+     nullptr},
     {nullptr}};
 
 // python type declaration
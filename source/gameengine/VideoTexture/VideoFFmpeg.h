@@ -114,6 +114,18 @@ class VideoFFmpeg : public VideoBase {
   {
     m_deinterlace = deinterlace;
   }
+  int getCacheSize(void)
+  {
+    return m_cacheSize;
+  }
+  void setCacheSize(int cacheSize)
+  {
+    if (cacheSize > 0 && cacheSize != m_cacheSize) {
+      m_cacheSize = cacheSize;
+      // the cache is restarted with the new size at next frame
+      stopCache();
+    }
+  }
   char *getImageName(void)
   {
     return (m_isImage) ? (char *)m_imageName.c_str() : nullptr;
@@ -128,10 +140,18 @@ class VideoFFmpeg : public VideoBase {
   AVFrame *m_frame;
   // deinterlaced frame if codec requires it
   AVFrame *m_frameDeinterlaced;
-  // decoded RGB24 frame if codec requires it
+  // decoded RGBA frame if codec requires it
   AVFrame *m_frameRGB;
-  // conversion from raw to RGB is done with sws_scale
+  // conversion from raw to RGBA is done with sws_scale
   struct SwsContext *m_imgConvertCtx;
+  // size of the converted frames
+  short m_frameSize[2];
+  // are the converted frames flipped?
+  bool m_frameFlip;
+  // are the frames converted directly to the layout of the image buffer?
+  bool m_directConversion;
+  // number of decoded frames in cache
+  int m_cacheSize;
   // should the codec be deinterlaced?
   bool m_deinterlace;
   // number of frame of preseek
@@ -193,6 +213,12 @@ class VideoFFmpeg : public VideoBase {
   /// common function to video file and capture
   int openStream(const char *filename, AVInputFormat *inputFormat, AVDictionary **formatParams);
 
+  /// create the frame conversion for the current image settings, if they changed
+  bool setupConversion(void);
+
+  /// convert the decoded frame, return false if the decoded frame is not valid
+  bool convertFrame(AVFrame *output);
+
   /// check if a frame is available and load it in pFrame, return true if a frame could be
   /// retrieved
   AVFrame *grabFrame(long frame);
@@ -0,0 +1,306 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "respec/SampleFunctions.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+#include <vector>
+
+using namespace aud;
+
+/* One second of 48 kHz audio per buffer, mixed like a device buffer of 64 voices. */
+#define NUM_SAMPLES 48000
+#define NUM_VOICES 64
+#define NUM_RUNS 20
+
+static const SampleFunctionsISA all_isas[] = {
+    SAMPLE_FUNCTIONS_SCALAR, SAMPLE_FUNCTIONS_SSE2, SAMPLE_FUNCTIONS_AVX, SAMPLE_FUNCTIONS_NEON};
+
+static std::vector<float> sample_buffer(int length, int seed)
+{
+  std::vector<float> buffer(length);
+  for (int i = 0; i < length; i++) {
+    buffer[i] = std::sin((i + seed) * 0.01f) * 1.2f;
+  }
+  return buffer;
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void print_throughput(const char *kernel,
+                             const SampleFunctions &functions,
+                             double samples,
+                             double time,
+                             double scalar_time)
+{
+  printf("%-16s %-8s %10.1f Msamples/s  x%.2f\n",
+         kernel,
+         functions.name,
+         samples / time * 1e-6,
+         scalar_time / time);
+}
+
+TEST(audaspace, SampleFunctionsMix)
+{
+  const SampleFunctions &scalar = *get_sample_functions(SAMPLE_FUNCTIONS_SCALAR);
+
+  for (int channels = 1; channels <= 6; channels++) {
+    std::vector<float> source = sample_buffer(NUM_SAMPLES * channels, 0);
+    std::vector<float> expected(NUM_SAMPLES * channels, 0.1f);
+    scalar.mix(expected.data(), source.data(), NUM_SAMPLES - 3, channels, 0.25f, 0.75f);
+
+    for (SampleFunctionsISA isa : all_isas) {
+      const SampleFunctions *functions = get_sample_functions(isa);
+      if (!functions) {
+        continue;
+      }
+
+      std::vector<float> result(NUM_SAMPLES * channels, 0.1f);
+      functions->mix(result.data(), source.data(), NUM_SAMPLES - 3, channels, 0.25f, 0.75f);
+
+      for (int i = 0; i < NUM_SAMPLES * channels; i++) {
+        EXPECT_NEAR(expected[i], result[i], 1e-6f);
+      }
+    }
+  }
+
+  printf("\nMix of %d stereo voices with a volume ramp:\n", NUM_VOICES);
+
+  std::vector<float> source = sample_buffer(NUM_SAMPLES * 2, 0);
+  std::vector<float> target(NUM_SAMPLES * 2, 0.0f);
+  double scalar_time = 0.0;
+
+  for (SampleFunctionsISA isa : all_isas) {
+    const SampleFunctions *functions = get_sample_functions(isa);
+    if (!functions) {
+      continue;
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int run = 0; run < NUM_RUNS; run++) {
+      for (int voice = 0; voice < NUM_VOICES; voice++) {
+        functions->mix(target.data(), source.data(), NUM_SAMPLES, 2, 0.5f, 0.4f);
+      }
+    }
+    double time = seconds_since(start);
+
+    if (isa == SAMPLE_FUNCTIONS_SCALAR) {
+      scalar_time = time;
+    }
+    print_throughput(
+        "mix", *functions, double(NUM_SAMPLES) * 2 * NUM_VOICES * NUM_RUNS, time, scalar_time);
+  }
+}
+
+TEST(audaspace, SampleFunctionsResampleLinear)
+{
+  const SampleFunctions &scalar = *get_sample_functions(SAMPLE_FUNCTIONS_SCALAR);
+  /* 44.1 kHz sources played back at 48 kHz, with the pitch of a slightly moving source. */
+  const float factor = 48000.0f / (44100.0f * 1.01f);
+  const float position = 0.3f;
+  /* The resampler reads the source samples up to the last interpolated position. */
+  const int source_length = int(std::ceil(NUM_SAMPLES / factor + position)) + 1;
+
+  for (int channels = 1; channels <= 2; channels++) {
+    std::vector<float> source = sample_buffer(source_length * channels, 0);
+    std::vector<float> expected(NUM_SAMPLES * channels);
+    scalar.resample_linear(
+        expected.data(), source.data(), NUM_SAMPLES, channels, position, factor);
+
+    for (SampleFunctionsISA isa : all_isas) {
+      const SampleFunctions *functions = get_sample_functions(isa);
+      if (!functions) {
+        continue;
+      }
+
+      std::vector<float> result(NUM_SAMPLES * channels);
+      functions->resample_linear(
+          result.data(), source.data(), NUM_SAMPLES, channels, position, factor);
+
+      for (int i = 0; i < NUM_SAMPLES * channels; i++) {
+        EXPECT_NEAR(expected[i], result[i], 1e-6f);
+      }
+    }
+  }
+
+  printf("\nLinear resampling of %d mono voices:\n", NUM_VOICES);
+
+  std::vector<float> source = sample_buffer(source_length, 0);
+  std::vector<float> target(NUM_SAMPLES);
+  double scalar_time = 0.0;
+
+  for (SampleFunctionsISA isa : all_isas) {
+    const SampleFunctions *functions = get_sample_functions(isa);
+    if (!functions) {
+      continue;
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int run = 0; run < NUM_RUNS; run++) {
+      for (int voice = 0; voice < NUM_VOICES; voice++) {
+        functions->resample_linear(target.data(), source.data(), NUM_SAMPLES, 1, position, factor);
+      }
+    }
+    double time = seconds_since(start);
+
+    if (isa == SAMPLE_FUNCTIONS_SCALAR) {
+      scalar_time = time;
+    }
+    print_throughput(
+        "resample linear", *functions, double(NUM_SAMPLES) * NUM_VOICES * NUM_RUNS, time, scalar_time);
+  }
+}
+
+TEST(audaspace, SampleFunctionsMapChannels)
+{
+  const SampleFunctions &scalar = *get_sample_functions(SAMPLE_FUNCTIONS_SCALAR);
+  const float mapping[12] = {0.8f, 0.3f, 0.5f, 0.1f, 0.9f, 0.2f, 0.4f, 0.6f, 0.7f, 0.25f, 0.35f, 0.45f};
+
+  for (int source_channels = 1; source_channels <= 2; source_channels++) {
+    for (int target_channels = 1; target_channels <= 6; target_channels++) {
+      std::vector<float> source = sample_buffer(NUM_SAMPLES * source_channels, 0);
+      std::vector<float> expected(NUM_SAMPLES * target_channels);
+      scalar.map_channels(expected.data(),
+                          source.data(),
+                          NUM_SAMPLES - 1,
+                          source_channels,
+                          target_channels,
+                          mapping);
+
+      for (SampleFunctionsISA isa : all_isas) {
+        const SampleFunctions *functions = get_sample_functions(isa);
+        if (!functions) {
+          continue;
+        }
+
+        std::vector<float> result(NUM_SAMPLES * target_channels);
+        functions->map_channels(result.data(),
+                                source.data(),
+                                NUM_SAMPLES - 1,
+                                source_channels,
+                                target_channels,
+                                mapping);
+
+        for (int i = 0; i < (NUM_SAMPLES - 1) * target_channels; i++) {
+          EXPECT_NEAR(expected[i], result[i], 1e-6f);
+        }
+      }
+    }
+  }
+
+  printf("\nChannel mapping of %d mono voices to stereo:\n", NUM_VOICES);
+
+  std::vector<float> source = sample_buffer(NUM_SAMPLES, 0);
+  std::vector<float> target(NUM_SAMPLES * 2);
+  double scalar_time = 0.0;
+
+  for (SampleFunctionsISA isa : all_isas) {
+    const SampleFunctions *functions = get_sample_functions(isa);
+    if (!functions) {
+      continue;
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int run = 0; run < NUM_RUNS; run++) {
+      for (int voice = 0; voice < NUM_VOICES; voice++) {
+        functions->map_channels(target.data(), source.data(), NUM_SAMPLES, 1, 2, mapping);
+      }
+    }
+    double time = seconds_since(start);
+
+    if (isa == SAMPLE_FUNCTIONS_SCALAR) {
+      scalar_time = time;
+    }
+    print_throughput(
+        "map channels", *functions, double(NUM_SAMPLES) * NUM_VOICES * NUM_RUNS, time, scalar_time);
+  }
+}
+
+TEST(audaspace, SampleFunctionsConvert)
+{
+  const SampleFunctions &scalar = *get_sample_functions(SAMPLE_FUNCTIONS_SCALAR);
+  const int length = NUM_SAMPLES * 2 - 5;
+
+  /* Includes samples out of the [-1, 1] range which are clamped. */
+  std::vector<float> source = sample_buffer(length, 0);
+  source[0] = -1.0f;
+  source[1] = 1.0f;
+
+  std::vector<int16_t> expected_s16(length);
+  scalar.convert_float_s16((data_t *)expected_s16.data(), (data_t *)source.data(), length);
+  std::vector<float> expected_float(length);
+  scalar.convert_s16_float(
+      (data_t *)expected_float.data(), (data_t *)expected_s16.data(), length);
+
+  for (SampleFunctionsISA isa : all_isas) {
+    const SampleFunctions *functions = get_sample_functions(isa);
+    if (!functions) {
+      continue;
+    }
+
+    std::vector<int16_t> result_s16(length);
+    functions->convert_float_s16((data_t *)result_s16.data(), (data_t *)source.data(), length);
+    for (int i = 0; i < length; i++) {
+      EXPECT_EQ(expected_s16[i], result_s16[i]);
+    }
+
+    /* In place conversion, like the converter reader does. */
+    std::vector<float> result_float(length);
+    memcpy(result_float.data(), expected_s16.data(), length * sizeof(int16_t));
+    functions->convert_s16_float(
+        (data_t *)result_float.data(), (data_t *)result_float.data(), length);
+    for (int i = 0; i < length; i++) {
+      EXPECT_EQ(expected_float[i], result_float[i]);
+    }
+  }
+
+  printf("\nConversion of a stereo device buffer:\n");
+
+  std::vector<int16_t> s16(length);
+  std::vector<float> target(length);
+  double scalar_time[2] = {0.0, 0.0};
+
+  for (SampleFunctionsISA isa : all_isas) {
+    const SampleFunctions *functions = get_sample_functions(isa);
+    if (!functions) {
+      continue;
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int run = 0; run < NUM_RUNS * NUM_VOICES; run++) {
+      functions->convert_float_s16((data_t *)s16.data(), (data_t *)source.data(), length);
+    }
+    double time_s16 = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int run = 0; run < NUM_RUNS * NUM_VOICES; run++) {
+      functions->convert_s16_float((data_t *)target.data(), (data_t *)s16.data(), length);
+    }
+    double time_float = seconds_since(start);
+
+    if (isa == SAMPLE_FUNCTIONS_SCALAR) {
+      scalar_time[0] = time_s16;
+      scalar_time[1] = time_float;
+    }
+    print_throughput("float to s16",
+                     *functions,
+                     double(length) * NUM_RUNS * NUM_VOICES,
+                     time_s16,
+                     scalar_time[0]);
+    print_throughput("s16 to float",
+                     *functions,
+                     double(length) * NUM_RUNS * NUM_VOICES,
+                     time_float,
+                     scalar_time[1]);
+  }
+
+  printf("\nSelected sample functions: %s\n", get_sample_functions().name);
+}
@@ -296,3 +296,105 @@ TEST(task, ListBaseIter100k)
 {
   task_listbase_test("ListBase parallel iteration - Threaded - 100000 items", 100000, true);
 }
+
+/* *** Scheduler scaling with fine-grained tasks. *** */
+
+#define NUM_FINE_TASKS 100000
+#define NUM_FANOUT_TASKS 64
+#define NUM_RUN_SCALING 10
+
+static void task_fine_func(TaskPool *__restrict pool, void *taskdata, int UNUSED(threadid))
+{
+  uint *num_done = (uint *)BLI_task_pool_userdata(pool);
+
+  /* Just enough work to not only measure the counter contention. */
+  const uint limit = gen_pseudo_random_number(POINTER_AS_UINT(taskdata)) >> 6;
+  for (uint i = 0; i < limit; i++) {
+    taskdata = POINTER_FROM_UINT(gen_pseudo_random_number(POINTER_AS_UINT(taskdata)));
+  }
+
+  atomic_add_and_fetch_uint32(num_done, 1);
+}
+
+/* Pushes the fine-grained tasks from a worker thread, like nested parallel loops or
+ * dependency graph nodes scheduling their children. */
+static void task_fanout_func(TaskPool *__restrict pool, void *taskdata, int threadid)
+{
+  const uint first = POINTER_AS_UINT(taskdata);
+  for (uint i = 0; i < NUM_FINE_TASKS / NUM_FANOUT_TASKS; i++) {
+    BLI_task_pool_push_from_thread(
+        pool, task_fine_func, POINTER_FROM_UINT(first + i), false, TASK_PRIORITY_LOW, threadid);
+  }
+}
+
+static void task_scheduler_scaling_test(const char *id, const bool use_fanout)
+{
+  printf("\n========== STARTING %s ==========\n", id);
+
+  BLI_threadapi_init();
+
+  const uint num_tasks = use_fanout ? NUM_FINE_TASKS / NUM_FANOUT_TASKS * NUM_FANOUT_TASKS :
+                                      NUM_FINE_TASKS;
+  double single_thread_timing = 0.0;
+
+  for (int num_threads = 1; num_threads <= 64; num_threads *= 2) {
+    TaskScheduler *scheduler = BLI_task_scheduler_create(num_threads);
+
+    double averaged_timing = 0.0;
+    for (int i = 0; i < NUM_RUN_SCALING; i++) {
+      uint num_done = 0;
+      TaskPool *pool = BLI_task_pool_create(scheduler, &num_done);
+
+      const double init_time = PIL_check_seconds_timer();
+      if (use_fanout) {
+        for (int j = 0; j < NUM_FANOUT_TASKS; j++) {
+          BLI_task_pool_push(pool,
+                             task_fanout_func,
+                             POINTER_FROM_INT(j * NUM_FINE_TASKS / NUM_FANOUT_TASKS),
+                             false,
+                             TASK_PRIORITY_LOW);
+        }
+      }
+      else {
+        for (int j = 0; j < NUM_FINE_TASKS; j++) {
+          BLI_task_pool_push(pool, task_fine_func, POINTER_FROM_INT(j), false, TASK_PRIORITY_LOW);
+        }
+      }
+      BLI_task_pool_work_and_wait(pool);
+      averaged_timing += PIL_check_seconds_timer() - init_time;
+
+      EXPECT_EQ(num_done, num_tasks);
+
+      BLI_task_pool_free(pool);
+    }
+    averaged_timing /= NUM_RUN_SCALING;
+
+    if (num_threads == 1) {
+      single_thread_timing = averaged_timing;
+    }
+
+    printf("\t%2d threads: %fs on average over %d runs, %.2f Mtasks/s, speedup %.2f\n",
+           num_threads,
+           averaged_timing,
+           NUM_RUN_SCALING,
+           num_tasks / averaged_timing * 1e-6,
+           single_thread_timing / averaged_timing);
+
+    BLI_task_scheduler_free(scheduler);
+  }
+
+  BLI_threadapi_exit();
+
+  printf("========== ENDED %s ==========\n\n", id);
+}
+
+TEST(task, SchedulerScalingMainThreadPush)
+{
+  task_scheduler_scaling_test("Scheduler scaling - Pushed from main thread - 100000 tasks", false);
+}
+
+TEST(task, SchedulerScalingWorkerPush)
+{
+  task_scheduler_scaling_test("Scheduler scaling - Pushed from worker threads - 100000 tasks",
+                              true);
+}
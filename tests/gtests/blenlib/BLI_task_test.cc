@@ -253,3 +253,63 @@ TEST(task, ListBaseIter)
   MEM_freeN(items_buffer);
   BLI_threadapi_exit();
 }
+
+/* *** Cancellation of pools with tasks in the worker deques. *** */
+
+static void task_pool_count_func(TaskPool *__restrict pool,
+                                 void *UNUSED(taskdata),
+                                 int UNUSED(tid))
+{
+  int *count = (int *)BLI_task_pool_userdata(pool);
+  atomic_add_and_fetch_uint32((uint32_t *)count, 1);
+}
+
+static void task_pool_spawn_func(TaskPool *__restrict pool, void *UNUSED(taskdata), int tid)
+{
+  /* Pushed from a worker, the tasks go to the deque of the worker. */
+  for (int i = 0; i < 100; i++) {
+    BLI_task_pool_push_from_thread(
+        pool, task_pool_count_func, NULL, false, TASK_PRIORITY_LOW, tid);
+  }
+}
+
+TEST(task, PoolCancel)
+{
+  BLI_threadapi_init();
+
+  TaskScheduler *scheduler = BLI_task_scheduler_create(4);
+
+  for (int iter = 0; iter < 100; iter++) {
+    int count_canceled = 0;
+    int count = 0;
+    TaskPool *pool_canceled = BLI_task_pool_create(scheduler, &count_canceled);
+    TaskPool *pool = BLI_task_pool_create(scheduler, &count);
+
+    for (int i = 0; i < 20; i++) {
+      BLI_task_pool_push(pool_canceled, task_pool_spawn_func, NULL, false, TASK_PRIORITY_LOW);
+      BLI_task_pool_push(pool, task_pool_spawn_func, NULL, false, TASK_PRIORITY_LOW);
+    }
+
+    /* Must return once all the tasks of the canceled pool are discarded, without touching the
+     * tasks of the other pool. */
+    BLI_task_pool_cancel(pool_canceled);
+    EXPECT_LE(count_canceled, 20 * 100);
+
+    BLI_task_pool_work_and_wait(pool);
+    EXPECT_EQ(count, 20 * 100);
+
+    /* The canceled pool is usable again. */
+    count_canceled = 0;
+    for (int i = 0; i < 50; i++) {
+      BLI_task_pool_push(pool_canceled, task_pool_count_func, NULL, false, TASK_PRIORITY_LOW);
+    }
+    BLI_task_pool_work_and_wait(pool_canceled);
+    EXPECT_EQ(count_canceled, 50);
+
+    BLI_task_pool_free(pool_canceled);
+    BLI_task_pool_free(pool);
+  }
+
+  BLI_task_scheduler_free(scheduler);
+  BLI_threadapi_exit();
+}
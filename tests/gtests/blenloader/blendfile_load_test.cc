@@ -17,6 +17,17 @@
  */
 #include "blendfile_loading_base_test.h"
 
+#include "BKE_appdir.h"
+#include "BKE_global.h"
+#include "BKE_main.h"
+
+#include "BLI_fileops.h"
+#include "BLI_listbase.h"
+#include "BLI_path_util.h"
+
+#include "BLO_readfile.h"
+#include "BLO_writefile.h"
+
 class BlendfileLoadingTest : public BlendfileLoadingBaseTest {
 };
 
@@ -29,3 +40,41 @@ TEST_F(BlendfileLoadingTest, CanaryTest)
   depsgraph_create(DAG_EVAL_RENDER);
   EXPECT_NE(nullptr, this->depsgraph);
 }
+
+#ifdef WITH_LZO
+TEST_F(BlendfileLoadingTest, ChunkedRoundTrip)
+{
+  if (!blendfile_load("modifier_stack/array_test.blend")) {
+    return;
+  }
+
+  char filepath[FILE_MAX];
+  BLI_join_dirfile(filepath, sizeof(filepath), BKE_tempdir_session(), "chunked_round_trip.blend");
+  ASSERT_TRUE(BLO_write_file(bfile->main, filepath, G_FILE_COMPRESS_CHUNKED, NULL, NULL));
+
+  /* The file must be recognized as a blend-file when opened from the interface. */
+  char header[7];
+  FILE *file = BLI_fopen(filepath, "rb");
+  ASSERT_NE(nullptr, file);
+  const int len = (int)fread(header, 1, sizeof(header), file);
+  fclose(file);
+  EXPECT_TRUE(BLO_has_bfile_header(header, len));
+  EXPECT_EQ(0, memcmp(header, "BLENDLZ", sizeof(header)));
+
+  const int tot_objects = BLI_listbase_count(&bfile->main->objects);
+  const int tot_meshes = BLI_listbase_count(&bfile->main->meshes);
+  const int tot_scenes = BLI_listbase_count(&bfile->main->scenes);
+  blendfile_free();
+
+  bfile = BLO_read_from_file(filepath, BLO_READ_SKIP_NONE, NULL);
+  BLI_delete(filepath, false, false);
+  ASSERT_NE(nullptr, bfile);
+
+  EXPECT_EQ(tot_objects, BLI_listbase_count(&bfile->main->objects));
+  EXPECT_EQ(tot_meshes, BLI_listbase_count(&bfile->main->meshes));
+  EXPECT_EQ(tot_scenes, BLI_listbase_count(&bfile->main->scenes));
+
+  depsgraph_create(DAG_EVAL_RENDER);
+  EXPECT_NE(nullptr, this->depsgraph);
+}
+#endif
@@ -0,0 +1,281 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/imgutils.h>
+#include <libavutil/log.h>
+#include <libswscale/swscale.h>
+}
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+/* A short 4K clip, decoded like the game engine VideoFFmpeg source does it. */
+#define CLIP_WIDTH 3840
+#define CLIP_HEIGHT 2160
+#define CLIP_FRAMES 48
+#define CLIP_GOP 12
+
+static double seconds_since(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void fill_frame(AVFrame *frame, int index)
+{
+  for (int y = 0; y < frame->height; y++) {
+    uint8_t *row = frame->data[0] + y * frame->linesize[0];
+    for (int x = 0; x < frame->width; x++) {
+      row[x] = (uint8_t)(x + y + index * 3);
+    }
+  }
+  for (int plane = 1; plane < 3; plane++) {
+    for (int y = 0; y < frame->height / 2; y++) {
+      uint8_t *row = frame->data[plane] + y * frame->linesize[plane];
+      for (int x = 0; x < frame->width / 2; x++) {
+        row[x] = (uint8_t)(128 + ((x * plane + y + index) & 63));
+      }
+    }
+  }
+}
+
+/* Encode a synthetic clip with a codec always built in ffmpeg, return its packets. */
+static std::vector<AVPacket *> encode_clip()
+{
+  std::vector<AVPacket *> packets;
+
+  AVCodec *codec = avcodec_find_encoder(AV_CODEC_ID_MPEG4);
+  if (!codec) {
+    return packets;
+  }
+
+  AVCodecContext *ctx = avcodec_alloc_context3(codec);
+  ctx->time_base.num = 1;
+  ctx->time_base.den = 25;
+  ctx->pix_fmt = AV_PIX_FMT_YUV420P;
+  ctx->width = CLIP_WIDTH;
+  ctx->height = CLIP_HEIGHT;
+  ctx->gop_size = CLIP_GOP;
+  ctx->bit_rate = 40000000;
+  ctx->thread_count = std::thread::hardware_concurrency();
+  if (avcodec_open2(ctx, codec, NULL) < 0) {
+    avcodec_free_context(&ctx);
+    return packets;
+  }
+
+  AVFrame *frame = av_frame_alloc();
+  frame->format = ctx->pix_fmt;
+  frame->width = ctx->width;
+  frame->height = ctx->height;
+  av_frame_get_buffer(frame, 32);
+
+  AVPacket *packet = av_packet_alloc();
+  for (int i = 0; i <= CLIP_FRAMES; i++) {
+    if (i < CLIP_FRAMES) {
+      av_frame_make_writable(frame);
+      fill_frame(frame, i);
+      frame->pts = i;
+      avcodec_send_frame(ctx, frame);
+    }
+    else {
+      /* Flush the encoder. */
+      avcodec_send_frame(ctx, NULL);
+    }
+    while (avcodec_receive_packet(ctx, packet) == 0) {
+      packets.push_back(av_packet_clone(packet));
+      av_packet_unref(packet);
+    }
+  }
+
+  av_packet_free(&packet);
+  av_frame_free(&frame);
+  avcodec_free_context(&ctx);
+  return packets;
+}
+
+enum ConversionMode {
+  /* No conversion, decoding only. */
+  CONVERSION_NONE,
+  /* RGB24 frame converted again and flipped to the RGBA image buffer, pixel per pixel. */
+  CONVERSION_TWO_PASSES,
+  /* RGBA frame flipped by swscale, copied to the image buffer. */
+  CONVERSION_DIRECT,
+};
+
+static void convert_two_passes(SwsContext *sws, AVFrame *frame, uint8_t *rgb, uint32_t *image)
+{
+  uint8_t *data[4] = {rgb, NULL, NULL, NULL};
+  int linesize[4] = {CLIP_WIDTH * 3, 0, 0, 0};
+  sws_scale(sws, frame->data, frame->linesize, 0, CLIP_HEIGHT, data, linesize);
+
+  for (int y = CLIP_HEIGHT - 1; y >= 0; y--) {
+    const uint8_t *src = rgb + y * CLIP_WIDTH * 3;
+    for (int x = 0; x < CLIP_WIDTH; x++, src += 3, image++) {
+      uint32_t pixel;
+      uint8_t *color = (uint8_t *)&pixel;
+      color[0] = src[0];
+      color[1] = src[1];
+      color[2] = src[2];
+      color[3] = 0xFF;
+      *image = pixel;
+    }
+  }
+}
+
+static void convert_direct(SwsContext *sws, AVFrame *frame, uint8_t *rgba, uint32_t *image)
+{
+  uint8_t *data[4] = {rgba + CLIP_WIDTH * 4 * (CLIP_HEIGHT - 1), NULL, NULL, NULL};
+  int linesize[4] = {-CLIP_WIDTH * 4, 0, 0, 0};
+  sws_scale(sws, frame->data, frame->linesize, 0, CLIP_HEIGHT, data, linesize);
+  memcpy(image, rgba, CLIP_WIDTH * CLIP_HEIGHT * 4);
+}
+
+static SwsContext *conversion_context(ConversionMode mode)
+{
+  return sws_getContext(CLIP_WIDTH,
+                        CLIP_HEIGHT,
+                        AV_PIX_FMT_YUV420P,
+                        CLIP_WIDTH,
+                        CLIP_HEIGHT,
+                        (mode == CONVERSION_DIRECT) ? AV_PIX_FMT_RGBA : AV_PIX_FMT_RGB24,
+                        SWS_FAST_BILINEAR,
+                        NULL,
+                        NULL,
+                        NULL);
+}
+
+/* Decode the first frame of the clip, NULL on failure. */
+static AVFrame *decode_first_frame(const std::vector<AVPacket *> &packets)
+{
+  AVCodec *codec = avcodec_find_decoder(AV_CODEC_ID_MPEG4);
+  AVCodecContext *ctx = avcodec_alloc_context3(codec);
+  ctx->width = CLIP_WIDTH;
+  ctx->height = CLIP_HEIGHT;
+  if (avcodec_open2(ctx, codec, NULL) < 0) {
+    avcodec_free_context(&ctx);
+    return NULL;
+  }
+
+  AVFrame *frame = av_frame_alloc();
+  bool decoded = false;
+  for (size_t i = 0; i <= packets.size() && !decoded; i++) {
+    avcodec_send_packet(ctx, (i < packets.size()) ? packets[i] : NULL);
+    decoded = (avcodec_receive_frame(ctx, frame) == 0);
+  }
+  avcodec_free_context(&ctx);
+
+  if (!decoded) {
+    av_frame_free(&frame);
+  }
+  return frame;
+}
+
+/* Decode the clip and return the number of frames per second, 0 on failure. */
+static double decode_clip(const std::vector<AVPacket *> &packets,
+                          int threads,
+                          ConversionMode mode,
+                          int *r_num_frames)
+{
+  AVCodec *codec = avcodec_find_decoder(AV_CODEC_ID_MPEG4);
+  AVCodecContext *ctx = avcodec_alloc_context3(codec);
+  ctx->width = CLIP_WIDTH;
+  ctx->height = CLIP_HEIGHT;
+  ctx->thread_count = threads;
+  ctx->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+  if (avcodec_open2(ctx, codec, NULL) < 0) {
+    avcodec_free_context(&ctx);
+    return 0.0;
+  }
+
+  SwsContext *sws = (mode != CONVERSION_NONE) ? conversion_context(mode) : NULL;
+  std::vector<uint8_t> frame_buffer(CLIP_WIDTH * CLIP_HEIGHT * 4);
+  std::vector<uint32_t> image(CLIP_WIDTH * CLIP_HEIGHT);
+
+  AVFrame *frame = av_frame_alloc();
+  int num_frames = 0;
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i <= packets.size(); i++) {
+    /* Last iteration flushes the frames delayed by the decoding threads. */
+    avcodec_send_packet(ctx, (i < packets.size()) ? packets[i] : NULL);
+    while (avcodec_receive_frame(ctx, frame) == 0) {
+      if (mode == CONVERSION_TWO_PASSES) {
+        convert_two_passes(sws, frame, frame_buffer.data(), image.data());
+      }
+      else if (mode == CONVERSION_DIRECT) {
+        convert_direct(sws, frame, frame_buffer.data(), image.data());
+      }
+      num_frames++;
+    }
+  }
+  const double time = seconds_since(start);
+
+  av_frame_free(&frame);
+  if (sws) {
+    sws_freeContext(sws);
+  }
+  avcodec_free_context(&ctx);
+
+  *r_num_frames = num_frames;
+  return (time > 0.0) ? num_frames / time : 0.0;
+}
+
+TEST(ffmpeg, VideoDecodePerformance)
+{
+  av_log_set_level(AV_LOG_QUIET);
+
+  std::vector<AVPacket *> packets = encode_clip();
+  if (packets.empty()) {
+    printf("MPEG4 encoder not available, skipping\n");
+    return;
+  }
+
+  /* The direct conversion must give the same image buffer as the two passes. */
+  AVFrame *frame = decode_first_frame(packets);
+  EXPECT_NE(frame, (AVFrame *)NULL);
+  if (frame) {
+    SwsContext *sws_two_passes = conversion_context(CONVERSION_TWO_PASSES);
+    SwsContext *sws_direct = conversion_context(CONVERSION_DIRECT);
+    std::vector<uint8_t> frame_buffer(CLIP_WIDTH * CLIP_HEIGHT * 4);
+    std::vector<uint32_t> image_two_passes(CLIP_WIDTH * CLIP_HEIGHT);
+    std::vector<uint32_t> image_direct(CLIP_WIDTH * CLIP_HEIGHT);
+
+    convert_two_passes(sws_two_passes, frame, frame_buffer.data(), image_two_passes.data());
+    convert_direct(sws_direct, frame, frame_buffer.data(), image_direct.data());
+
+    size_t num_different = 0;
+    for (size_t i = 0; i < image_direct.size(); i++) {
+      num_different += (image_direct[i] != image_two_passes[i]);
+    }
+    EXPECT_EQ(num_different, (size_t)0);
+
+    sws_freeContext(sws_two_passes);
+    sws_freeContext(sws_direct);
+    av_frame_free(&frame);
+  }
+
+  const int max_threads = std::thread::hardware_concurrency();
+  const int thread_counts[] = {1, max_threads};
+  const char *mode_names[] = {"decode", "two passes", "direct"};
+
+  printf("Clip %dx%d, %d frames\n", CLIP_WIDTH, CLIP_HEIGHT, CLIP_FRAMES);
+  for (int threads : thread_counts) {
+    for (int mode = CONVERSION_NONE; mode <= CONVERSION_DIRECT; mode++) {
+      int num_frames;
+      const double fps = decode_clip(packets, threads, (ConversionMode)mode, &num_frames);
+      /* All frames must come out, including the ones delayed by the frame threads. */
+      EXPECT_EQ(num_frames, CLIP_FRAMES);
+      printf("%2d threads  %-10s  %8.1f fps\n", threads, mode_names[mode], fps);
+    }
+  }
+
+  for (AVPacket *packet : packets) {
+    av_packet_free(&packet);
+  }
+}